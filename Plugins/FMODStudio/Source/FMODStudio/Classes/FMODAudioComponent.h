@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include "Containers/ArrayView.h"
+#include "FMODCallbackQueue.h"
 #include "Containers/Map.h"
+#include "Templates/UniquePtr.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Sound/SoundAttenuation.h"
 #include "AudioDevice.h"
@@ -218,6 +221,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Audio|FMOD|Components")
     void SetParameter(FName Name, float Value);
 
+    /** Set several parameters of the Event with one call to the Studio Instance, skipping values that haven't changed. */
+    void SetParameters(TArrayView<const FName> Names, TArrayView<const float> Values);
+
     /** Will be deprecated in FMOD 2.01, use `GetParameterValue(FName, float, float)` instead.
      * Get parameter value from the Event.
     */
@@ -276,6 +282,27 @@ public:
     /** Update attenuation if we have it set. */
     void UpdateAttenuation();
 
+    /** Apply the result of an occlusion trace to the occlusion parameter. */
+    void ApplyOcclusion(bool bIsOccluded);
+
+    /** True while an occlusion trace for this component is queued or in flight. */
+    bool bOcclusionTracePending;
+
+    /** Index of this component in the module's emitter manager, or INDEX_NONE if it is not registered. */
+    int32 EmitterIndex;
+
+    /** True while playing without a Studio instance because no listener is in range. */
+    bool IsVirtual() const { return bVirtual; }
+
+    /** Release the Studio instance of an out of range event, keeping track of its timeline position. */
+    void Virtualize();
+
+    /** Create and start a Studio instance for a virtual event that has come into range. Returns false if the event has finished. */
+    bool Devirtualize();
+
+    /** True if a virtual event has been stopped or a virtual one-shot has played past its end. */
+    bool HasVirtualPlaybackFinished() const;
+
     /** Apply Volume and LPF into event. */
     void ApplyVolumeLPF();
 
@@ -334,6 +361,24 @@ private:
     /** Release the Studio Instance. */
     void ReleaseEventInstance();
 
+    /** Release the Studio Instance but keep the component registered with the emitter manager. */
+    void ReleaseStudioInstance();
+
+    /** Create the Studio Instance if needed, apply cached state and start it at the given timeline position. */
+    bool StartStudioInstance(FMOD::Studio::EventDescription *EventDesc, int32 TimelinePosition);
+
+    /** Distance beyond which the event can play virtually, or 0 if it must always have an instance. */
+    float GetVirtualDistance(const FFMODEventDescriptionInfo &EventInfo, EFMODSystemContext::Type Context) const;
+
+    /** Milliseconds a virtual event has been playing for. */
+    int32 GetVirtualTimelinePosition() const;
+
+    /** Look up a parameter ID in the event's cached table. */
+    bool FindParameterID(FName Name, FMOD_STUDIO_PARAMETER_ID &OutID) const;
+
+    /** Set a parameter on the Studio Instance, by ID where possible. */
+    FMOD_RESULT SetInstanceParameter(FName Name, float Value);
+
     /** Return a cached reference to the current IFMODStudioModule.*/
     IFMODStudioModule& GetStudioModule()
     {
@@ -360,10 +405,20 @@ private:
     FMOD_STUDIO_PARAMETER_ID AmbientVolumeID;
     FMOD_STUDIO_PARAMETER_ID AmbientLPFID;
 
-    // Tempo and marker callbacks.
+    // Protects the programmer sound name and sound, read from the FMOD thread.
     FCriticalSection CallbackLock;
-    TArray<FTimelineMarkerProperties> CallbackMarkerQueue;
-    TArray<FTimelineBeatProperties> CallbackBeatQueue;
+
+    // Tempo and marker callbacks, written by the FMOD thread and read in TickComponent.
+    // Single producer/single consumer queues allocated when the callback is first set.
+    TUniquePtr<TFMODCallbackQueue<FTimelineMarkerProperties>> CallbackMarkerQueue;
+    TUniquePtr<TFMODCallbackQueue<FTimelineBeatProperties>> CallbackBeatQueue;
+
+    // Virtual playback state, see Virtualize.
+    bool bVirtual;
+    bool bVirtualStopped;
+    bool bOneshot;
+    float VirtualDistance;
+    double VirtualStartTime;
 
     // Direct assignment of programmer sound from other C++ code.
     FMOD::Sound *ProgrammerSound;
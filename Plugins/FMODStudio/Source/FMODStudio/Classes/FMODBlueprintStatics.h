@@ -62,6 +62,23 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
             UnsafeDuringActorConstruction = "true"))
     static FFMODEventInstance PlayEventAtLocation(UObject *WorldContextObject, UFMODEvent *Event, const FTransform &Location, bool bAutoPlay);
 
+    /** Plays a fire-and-forget event. The sound does not travel with any actor and no instance is returned, since the instance
+	 * may come from a pool and be restarted for a later one-shot.
+	 * @param Event - event to play
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD",
+        meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", UnsafeDuringActorConstruction = "true"))
+    static void PlayOneShot2D(UObject *WorldContextObject, UFMODEvent *Event);
+
+    /** Plays a fire-and-forget event at the given location. The sound does not travel with any actor and no instance is returned,
+	 * since the instance may come from a pool and be restarted for a later one-shot.
+	 * @param Event - event to play
+	 * @param Location - World position to play event at
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD",
+        meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", UnsafeDuringActorConstruction = "true"))
+    static void PlayOneShotAtLocation(UObject *WorldContextObject, UFMODEvent *Event, const FTransform &Location);
+
     /** Plays an event attached to and following the specified component.
 	 * @param Event - event to play
 	 * @param AttachComponent - Component to attach to.
@@ -77,6 +94,14 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
     static class UFMODAudioComponent *PlayEventAttached(UFMODEvent *Event, USceneComponent *AttachToComponent, FName AttachPointName,
         FVector Location, EAttachLocation::Type LocationType, bool bStopWhenAttachedToDestroyed, bool bAutoPlay, bool bAutoDestroy);
 
+    /** Plays a one-shot event attached to and following the specified component, reusing a finished audio component
+     * owned by the same actor where possible.
+	 * @param Event - event to play
+	 * @param AttachComponent - Component to attach to.
+	 * @param AttachPointName - Optional named point within the AttachComponent to play the sound at
+	 */
+    static class UFMODAudioComponent *PlayEventAttachedOneShot(UFMODEvent *Event, USceneComponent *AttachToComponent, FName AttachPointName);
+
     /** Find an asset by name.
 	 * @param EventName - The asset name
 	 */
@@ -135,6 +160,18 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
         meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", UnsafeDuringActorConstruction = "true"))
     static void UnloadEventSampleData(UObject *WorldContextObject, UFMODEvent *Event);
 
+    /** Start loading a programmer sound ahead of time, e.g. for upcoming dialogue, and keep it loaded until it is unloaded.
+	 * @param Name - audio table key or file path, as used for Programmer Sound Name.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static bool LoadProgrammerSound(const FString &Name);
+
+    /** Allow a loaded programmer sound to be released once nothing is playing it.
+	 * @param Name - audio table key or file path, as used for Programmer Sound Name.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void UnloadProgrammerSound(const FString &Name);
+
     /** Return a list of all event instances that are playing for this event.
 		Be careful using this function because it is possible to find and alter any playing sound, even ones owned by other audio components.
 	 * @param Event - event to find instances from.
@@ -143,6 +180,13 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
         meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", UnsafeDuringActorConstruction = "true"))
     static TArray<FFMODEventInstance> FindEventInstances(UObject *WorldContextObject, UFMODEvent *Event);
 
+    /** Fill OutInstances with the event instances that are playing for this event, reusing its allocation.
+	 * Returns the number of instances found.
+	 * @param Event - event to find instances from.
+	 * @param OutInstances - array to fill, emptied first.
+	 */
+    static int32 GetEventInstances(UFMODEvent *Event, TArray<FFMODEventInstance> &OutInstances);
+
     /** Set volume on a bus
 	 * @param Bus - bus to use
 	 * @param Volume - volume
@@ -3,9 +3,39 @@
 #pragma once
 
 #include "FMODAsset.h"
+#include "FMODStudioModule.h"
+#include "fmod_studio_common.h"
 #include "FMODEvent.generated.h"
 
-struct FMOD_STUDIO_PARAMETER_DESCRIPTION;
+/** Event description and the properties read from it, cached on the event asset for one Studio system */
+struct FFMODEventDescriptionInfo
+{
+    FFMODEventDescriptionInfo()
+        : Description(nullptr)
+        , Generation(0)
+        , bIs3D(false)
+        , bOneshot(false)
+        , MinimumDistance(0.0f)
+        , MaximumDistance(0.0f)
+        , Length(0)
+    {
+    }
+
+    FMOD::Studio::EventDescription *Description;
+
+    /** Generation of the system the description was read from, 0 if nothing is cached */
+    uint32 Generation;
+
+    bool bIs3D;
+    bool bOneshot;
+    float MinimumDistance;
+    float MaximumDistance;
+    int32 Length;
+    TArray<FMOD_STUDIO_PARAMETER_DESCRIPTION> Parameters;
+
+    /** IDs of the parameters above by name, so parameters can be set by ID */
+    TMap<FName, FMOD_STUDIO_PARAMETER_ID> ParameterIDs;
+};
 
 /**
  * FMOD Event Asset.
@@ -23,4 +53,13 @@ class FMODSTUDIO_API UFMODEvent : public UFMODAsset
 
     /** Get parameter descriptions for this event */
     void GetParameterDescriptions(TArray<FMOD_STUDIO_PARAMETER_DESCRIPTION> &Parameters) const;
+
+    /** Look up the ID of a parameter in the cached event description */
+    bool FindParameterID(const FName &Name, FMOD_STUDIO_PARAMETER_ID &OutID) const;
+
+    /** Cached description for a Studio system, only the module should use this; see IFMODStudioModule::GetEventDescriptionInfo */
+    FFMODEventDescriptionInfo &GetDescriptionInfo(EFMODSystemContext::Type Context) const { return DescriptionInfo[Context]; }
+
+private:
+    mutable FFMODEventDescriptionInfo DescriptionInfo[EFMODSystemContext::Max];
 };
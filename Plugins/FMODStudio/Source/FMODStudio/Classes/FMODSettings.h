@@ -4,6 +4,7 @@
 
 #include "UObject/Class.h"
 #include "Engine/EngineTypes.h"
+#include "UObject/SoftObjectPath.h"
 #include "GenericPlatform/GenericPlatform.h"
 #include "FMODSettings.generated.h"
 
@@ -39,6 +40,18 @@ enum Type
 };
 }
 
+UENUM()
+namespace EFMODInstanceStealPolicy
+{
+enum Type
+{
+    // Restart the instance that was started longest ago
+    Oldest,
+    // Restart the instance with the lowest final volume
+    Quietest
+};
+}
+
 USTRUCT()
 struct FCustomPoolSizes
 {
@@ -94,6 +107,42 @@ struct FFMODProjectLocale
     bool bDefault;
 };
 
+USTRUCT()
+struct FFMODMapBankManifest
+{
+    GENERATED_USTRUCT_BODY()
+
+    /**
+    * Map that needs the banks.
+    */
+    UPROPERTY(config, EditAnywhere, Category = BankLoading, meta = (AllowedClasses = "World"))
+    FSoftObjectPath Map;
+
+    /**
+    * Bank files to load while the map is open, relative to the bank output directory.
+    */
+    UPROPERTY(config, EditAnywhere, Category = BankLoading)
+    TArray<FString> Banks;
+
+    /**
+    * Banks with a higher priority are loaded first. Banks loaded at startup have priority 0.
+    */
+    UPROPERTY(config, EditAnywhere, Category = BankLoading)
+    int32 Priority;
+
+    /**
+    * Whether to load the sample data of these banks once they have loaded.
+    */
+    UPROPERTY(config, EditAnywhere, Category = BankLoading)
+    bool bLoadSampleData;
+
+    FFMODMapBankManifest()
+        : Priority(1)
+        , bLoadSampleData(false)
+    {
+    }
+};
+
 UCLASS(config = Engine, defaultconfig)
 class FMODSTUDIO_API UFMODSettings : public UObject
 {
@@ -298,6 +347,97 @@ public:
     UPROPERTY(config, EditAnywhere, Category = Advanced)
     FString AmbientLPFParameter;
 
+    /**
+    * Maximum number of occlusion traces issued per frame. Traces are spread round-robin over occluded emitters.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "1"))
+    int32 OcclusionTracesPerFrame;
+
+    /**
+    * Maximum number of pooled instances per event for one-shots played with Play One Shot At Location and Play One Shot 2D.
+    * Play Event At Location and Play Event 2D always create their own instance. Set to 0 to disable pooling.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 EventInstancePoolSize;
+
+    /**
+    * Which pooled instance to restart when an event's pool is full.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    TEnumAsByte<EFMODInstanceStealPolicy::Type> InstanceStealPolicy;
+
+    /**
+    * Seconds a pooled instance can stay stopped before it is released. Events with pooled instances can't have their sample data unloaded.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    float EventInstancePoolIdleTime;
+
+    /**
+    * Maximum number of audio components each actor keeps for reuse by followed one-shots, e.g. from animation notifies. Set to 0 to disable pooling.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 AttachedComponentPoolSize;
+
+    /**
+    * Play 3D events on audio components without creating an instance while every listener is beyond their maximum distance.
+    * The instance is created, at the elapsed timeline position, once a listener comes within range.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    bool bVirtualizeOutOfRangeEvents;
+
+    /**
+    * Extra distance beyond an event's maximum distance a listener has to move before its instance is released again.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0", EditCondition = "bVirtualizeOutOfRangeEvents"))
+    float VirtualizationHysteresis;
+
+    /**
+    * Load banks other than the master banks over several frames at runtime, instead of blocking until they have loaded.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced)
+    bool bStreamBankLoading;
+
+    /**
+    * Maximum number of streamed banks loading at once.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "1", EditCondition = "bStreamBankLoading"))
+    int32 BankLoadsPerFrame;
+
+    /**
+    * Banks to load while particular maps are open. Requires streamed bank loading.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (EditCondition = "bStreamBankLoading"))
+    TArray<FFMODMapBankManifest> MapBankManifests;
+
+    /**
+    * Keep the sample data of played events loaded while FMOD's total memory use stays below this many megabytes. This is all
+    * memory allocated by FMOD, including banks, instances and DSP buffers, not just sample data. Once it is exceeded, the
+    * sample data of the least recently played events is unloaded. Set to 0 to let FMOD unload sample data as soon as an
+    * event's instances are released.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 TotalMemoryBudgetForSampleData;
+
+    /**
+    * Keep unused programmer sounds loaded until they take up more than this many megabytes, then release the least recently
+    * played. Set to 0 to release programmer sounds as soon as no event instance is using them.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 ProgrammerSoundMemoryBudget;
+
+    /**
+    * Seconds between samples of FMOD's CPU, memory and channel stats. Stats are only sampled while stat FMOD is shown or a capture
+    * has been started with fmod.Stats.Capture.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    float StatsSampleInterval;
+
+    /**
+    * Number of stats samples kept for the min, max and 95th percentile figures and for fmod.Stats.DumpCSV.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "1"))
+    int32 StatsWindowSize;
+
     /** Is the bank path set up . */
     bool IsBankPathSet() const { return !BankOutputDirectory.Path.IsEmpty(); }
 
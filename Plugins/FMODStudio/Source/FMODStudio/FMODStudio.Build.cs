@@ -53,6 +53,7 @@ namespace UnrealBuildTool.Rules
                 PrivateDependencyModuleNames.Add("AssetRegistry");
                 PrivateDependencyModuleNames.Add("UnrealEd");
                 PrivateDependencyModuleNames.Add("Settings");
+                PrivateDependencyModuleNames.Add("DirectoryWatcher");
             }
 
             DynamicallyLoadedModuleNames.AddRange(
@@ -20,13 +20,12 @@ void UFMODAnimNotifyPlay::Notify(USkeletalMeshComponent *MeshComp, UAnimSequence
         if (bFollow)
         {
             // Play event attached
-            UFMODBlueprintStatics::PlayEventAttached(
-                Event.Get(), MeshComp, *AttachName, FVector(0, 0, 0), EAttachLocation::KeepRelativeOffset, false, true, true);
+            UFMODBlueprintStatics::PlayEventAttachedOneShot(Event.Get(), MeshComp, *AttachName);
         }
         else
         {
             // Play event at location
-            UFMODBlueprintStatics::PlayEventAtLocation(MeshComp, Event.Get(), MeshComp->GetComponentTransform(), true);
+            UFMODBlueprintStatics::PlayOneShotAtLocation(MeshComp, Event.Get(), MeshComp->GetComponentTransform());
         }
     }
 }
@@ -21,8 +21,17 @@
 #include "ObjectTools.h"
 #endif
 
+/** Number of banks loaded at once when reading bank GUIDs */
+static const int32 BANK_GUID_BATCH_SIZE = 64;
+
+static FString GetBankFileCachePath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("FMOD") / TEXT("BankFileCache.bin");
+}
+
 FFMODAssetTable::FFMODAssetTable()
     : StudioSystem(nullptr)
+    , BankFileCache(GetBankFileCachePath())
 {
 }
 
@@ -71,106 +80,137 @@ void FFMODAssetTable::Refresh()
         return;
     }
 
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    double StartTime = FPlatformTime::Seconds();
+
     BuildBankPathLookup();
 
-    if (!MasterStringsBankPath.IsEmpty())
+    double LookupTime = FPlatformTime::Seconds();
+    UE_LOG(LogFMOD, Log, TEXT("Bank path lookup built in %.1f ms (%d bank files changed)"), (LookupTime - StartTime) * 1000.0,
+        GetChangedBankFiles().Num());
+
+    if (MasterStringsBankPath.IsEmpty())
     {
-        const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
-        FString StringPath = Settings.GetFullBankPath() / MasterStringsBankPath;
+        return;
+    }
 
-        UE_LOG(LogFMOD, Log, TEXT("Loading strings bank: %s"), *StringPath);
+    FString StringPath = Settings.GetFullBankPath() / MasterStringsBankPath;
 
-        FMOD::Studio::Bank *StudioStringBank;
-        FMOD_RESULT StringResult = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*StringPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &StudioStringBank);
+    // The assets only depend on the strings bank, so there is nothing to do unless it or the asset location changed
+    if (StringPath == AssetsStringsBankPath && Settings.ContentBrowserPrefix == AssetsContentBrowserPrefix && !GetChangedBankFiles().Contains(StringPath))
+    {
+        UE_LOG(LogFMOD, Log, TEXT("Strings bank unchanged, keeping %d assets"), NameLookup.Num());
+        return;
+    }
 
-        if (StringResult == FMOD_OK)
-        {
-            TArray<char> RawBuffer;
-            RawBuffer.SetNum(256); // Initial capacity
+    AssetsStringsBankPath.Empty();
 
-            int Count = 0;
-            verifyfmod(StudioStringBank->getStringCount(&Count));
+    UE_LOG(LogFMOD, Log, TEXT("Loading strings bank: %s"), *StringPath);
 
-            // Enumerate all of the names in the strings bank and gather the information required to create the UE4 assets for each object
-            TArray<AssetCreateInfo> AssetCreateInfos;
-            AssetCreateInfos.Reserve(Count);
+    FMOD::Studio::Bank *StudioStringBank;
+    FMOD_RESULT StringResult = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*StringPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &StudioStringBank);
 
-            for (int StringIdx = 0; StringIdx < Count; ++StringIdx)
-            {
-                FMOD::Studio::ID Guid = { 0 };
+    if (StringResult != FMOD_OK)
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to load strings bank: %s"), *StringPath);
+        return;
+    }
 
-                while (true)
-                {
-                    int ActualSize = 0;
-                    FMOD_RESULT Result = StudioStringBank->getStringInfo(StringIdx, &Guid, RawBuffer.GetData(), RawBuffer.Num(), &ActualSize);
+    TArray<char> RawBuffer;
+    RawBuffer.SetNum(256); // Initial capacity
 
-                    if (Result == FMOD_ERR_TRUNCATED)
-                    {
-                        RawBuffer.SetNum(ActualSize);
-                    }
-                    else
-                    {
-                        verifyfmod(Result);
-                        break;
-                    }
-                }
+    int Count = 0;
+    verifyfmod(StudioStringBank->getStringCount(&Count));
 
-                FString AssetName(UTF8_TO_TCHAR(RawBuffer.GetData()));
-                FGuid AssetGuid = FMODUtils::ConvertGuid(Guid);
+    // Enumerate all of the names in the strings bank and gather the information required to create the UE4 assets for each object
+    TArray<AssetCreateInfo> AssetCreateInfos;
+    AssetCreateInfos.Reserve(Count);
 
-                if (!AssetName.IsEmpty())
-                {
-                    AssetCreateInfo CreateInfo = {};
+    for (int StringIdx = 0; StringIdx < Count; ++StringIdx)
+    {
+        FMOD::Studio::ID Guid = { 0 };
 
-                    if (MakeAssetCreateInfo(AssetGuid, AssetName, &CreateInfo))
-                    {
-                        AssetCreateInfos.Add(CreateInfo);
-                    }
-                }
+        while (true)
+        {
+            int ActualSize = 0;
+            FMOD_RESULT Result = StudioStringBank->getStringInfo(StringIdx, &Guid, RawBuffer.GetData(), RawBuffer.Num(), &ActualSize);
+
+            if (Result == FMOD_ERR_TRUNCATED)
+            {
+                RawBuffer.SetNum(ActualSize);
+            }
+            else
+            {
+                verifyfmod(Result);
+                break;
             }
+        }
 
-            verifyfmod(StudioStringBank->unload());
-            verifyfmod(StudioSystem->update());
+        FString AssetName(UTF8_TO_TCHAR(RawBuffer.GetData()));
+        FGuid AssetGuid = FMODUtils::ConvertGuid(Guid);
 
-            // Create new asset map - move existing assets over if they still match
-            TMap<FString, TWeakObjectPtr<UFMODAsset>> NewNameLookup;
+        if (!AssetName.IsEmpty())
+        {
+            AssetCreateInfo CreateInfo = {};
 
-            for (const AssetCreateInfo &CreateInfo : AssetCreateInfos)
+            if (MakeAssetCreateInfo(AssetGuid, AssetName, &CreateInfo))
             {
-                TWeakObjectPtr<UFMODAsset> Asset;
-                NameLookup.RemoveAndCopyValue(CreateInfo.StudioPath, Asset);
+                AssetCreateInfos.Add(CreateInfo);
+            }
+        }
+    }
 
-                if (Asset.IsValid() && Asset->GetClass() == CreateInfo.Class && Asset->AssetGuid == CreateInfo.Guid)
-                {
-                    NewNameLookup.Add(CreateInfo.StudioPath, Asset);
-                }
-                else
-                {
-                    // Clean up existing asset (if there was one)
-                    if (Asset.IsValid())
-                    {
-                        DeleteAsset(Asset.Get());
-                    }
+    verifyfmod(StudioStringBank->unload());
+    verifyfmod(StudioSystem->update());
 
-                    UFMODAsset *NewAsset = CreateAsset(CreateInfo);
-                    NewNameLookup.Add(CreateInfo.StudioPath, NewAsset);
-                    FAssetRegistryModule::AssetCreated(NewAsset);
-                }
-            }
+    double StringsTime = FPlatformTime::Seconds();
+    UE_LOG(LogFMOD, Log, TEXT("Read %d strings in %.1f ms"), Count, (StringsTime - LookupTime) * 1000.0);
 
-            // Everything left in the name lookup was removed
-            for (auto& Entry : NameLookup)
-            {
-                DeleteAsset(Entry.Value.Get());
-            }
+    // Diff against the previous set of assets - only create or delete the ones that changed
+    TSet<FString> CurrentPaths;
+    CurrentPaths.Reserve(AssetCreateInfos.Num());
+    int32 CreatedCount = 0;
+    int32 DeletedCount = 0;
 
-            NameLookup = NewNameLookup;
+    for (const AssetCreateInfo &CreateInfo : AssetCreateInfos)
+    {
+        CurrentPaths.Add(CreateInfo.StudioPath);
+        TWeakObjectPtr<UFMODAsset> &Asset = NameLookup.FindOrAdd(CreateInfo.StudioPath);
+
+        if (Asset.IsValid() && Asset->GetClass() == CreateInfo.Class && Asset->AssetGuid == CreateInfo.Guid)
+        {
+            continue;
         }
-        else
+
+        // Clean up existing asset (if there was one)
+        if (Asset.IsValid())
         {
-            UE_LOG(LogFMOD, Warning, TEXT("Failed to load strings bank: %s"), *StringPath);
+            DeleteAsset(Asset.Get());
+            ++DeletedCount;
         }
+
+        UFMODAsset *NewAsset = CreateAsset(CreateInfo);
+        Asset = NewAsset;
+        FAssetRegistryModule::AssetCreated(NewAsset);
+        ++CreatedCount;
     }
+
+    // Everything not in the strings bank any more was removed
+    for (auto It = NameLookup.CreateIterator(); It; ++It)
+    {
+        if (!CurrentPaths.Contains(It.Key()))
+        {
+            DeleteAsset(It.Value().Get());
+            It.RemoveCurrent();
+            ++DeletedCount;
+        }
+    }
+
+    AssetsStringsBankPath = StringPath;
+    AssetsContentBrowserPrefix = Settings.ContentBrowserPrefix;
+
+    UE_LOG(LogFMOD, Log, TEXT("Updated assets in %.1f ms (%d created, %d deleted, %d total)"), (FPlatformTime::Seconds() - StringsTime) * 1000.0,
+        CreatedCount, DeletedCount, NameLookup.Num());
 }
 
 FString FFMODAssetTable::GetAssetClassName(UClass* AssetClass)
@@ -528,67 +568,124 @@ void FFMODAssetTable::BuildBankPathLookup()
     MasterStringsBankPath.Empty();
     MasterAssetsBankPath.Empty();
 
-    if (BankPaths.Num() == 0)
-    {
-        return;
-    }
+    BankFileCache.Update(BankPaths, [this](const TArray<FString> &Paths, TMap<FString, FFMODBankFileInfo> &FileInfos) {
+        ReadBankGuids(Paths, FileInfos);
+    });
 
     for (FString BankPath : BankPaths)
     {
-        FMOD::Studio::Bank *Bank;
-        FMOD_RESULT result = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*BankPath), FMOD_STUDIO_LOAD_BANK_NORMAL, &Bank);
-        FMOD_GUID GUID;
+        const FFMODBankFileInfo *Info = BankFileCache.GetFiles().Find(BankPath);
 
-        if (result == FMOD_OK)
+        if (!Info)
         {
-            result = Bank->getID(&GUID);
-            Bank->unload();
+            continue;
         }
 
-        if (result == FMOD_OK)
+        FString CurFilename = FPaths::GetCleanFilename(BankPath);
+        FString PathPart;
+        FString FilenamePart;
+        FString ExtensionPart;
+        FPaths::Split(BankPath, PathPart, FilenamePart, ExtensionPart);
+        BankPath = BankPath.RightChop(Settings.GetFullBankPath().Len() + 1);
+
+        BankLocalization localization;
+        localization.Path = BankPath;
+        localization.Locale = "";
+
+        for (const FFMODProjectLocale& Locale : Settings.Locales)
         {
-            FString CurFilename = FPaths::GetCleanFilename(BankPath);
-            FString PathPart;
-            FString FilenamePart;
-            FString ExtensionPart;
-            FPaths::Split(BankPath, PathPart, FilenamePart, ExtensionPart);
-            BankPath = BankPath.RightChop(Settings.GetFullBankPath().Len() + 1);
-
-            BankLocalization localization;
-            localization.Path = BankPath;
-            localization.Locale = "";
-
-            for (const FFMODProjectLocale& Locale : Settings.Locales)
+            if (FilenamePart.EndsWith(FString("_") + Locale.LocaleCode))
             {
-                if (FilenamePart.EndsWith(FString("_") + Locale.LocaleCode))
-                {
-                    localization.Locale = Locale.LocaleCode;
-                    break;
-                }
+                localization.Locale = Locale.LocaleCode;
+                break;
             }
+        }
 
-            BankLocalizations& localizations = BankPathLookup.FindOrAdd(FMODUtils::ConvertGuid(GUID));
-            localizations.Add(localization);
+        BankLocalizations& localizations = BankPathLookup.FindOrAdd(Info->Guid);
+        localizations.Add(localization);
 
-            if (MasterBankPath.IsEmpty() && CurFilename == Settings.GetMasterBankFilename())
-            {
-                MasterBankPath = BankPath;
-            }
-            else if (MasterStringsBankPath.IsEmpty() && CurFilename == Settings.GetMasterStringsBankFilename())
+        if (MasterBankPath.IsEmpty() && CurFilename == Settings.GetMasterBankFilename())
+        {
+            MasterBankPath = BankPath;
+        }
+        else if (MasterStringsBankPath.IsEmpty() && CurFilename == Settings.GetMasterStringsBankFilename())
+        {
+            MasterStringsBankPath = BankPath;
+        }
+        else if (MasterAssetsBankPath.IsEmpty() && CurFilename == Settings.GetMasterAssetsBankFilename())
+        {
+            MasterAssetsBankPath = BankPath;
+        }
+    }
+}
+
+void FFMODAssetTable::ReadBankGuids(const TArray<FString> &Paths, TMap<FString, FFMODBankFileInfo> &FileInfos)
+{
+    // Banks are loaded without blocking and flushed once per batch. Localized banks share a GUID and can't be loaded
+    // together, so any that collide are retried in the next pass.
+    TArray<FString> Pending = Paths;
+    TArray<FMOD::Studio::Bank *> Banks;
+
+    while (Pending.Num() > 0)
+    {
+        TArray<FString> Retry;
+
+        for (int32 BatchStart = 0; BatchStart < Pending.Num(); BatchStart += BANK_GUID_BATCH_SIZE)
+        {
+            const int32 BatchCount = FMath::Min(BANK_GUID_BATCH_SIZE, Pending.Num() - BatchStart);
+            Banks.Reset();
+            Banks.AddZeroed(BatchCount);
+
+            for (int32 i = 0; i < BatchCount; ++i)
             {
-                MasterStringsBankPath = BankPath;
+                const FString &BankPath = Pending[BatchStart + i];
+                FMOD_RESULT Result = StudioSystem->loadBankFile(TCHAR_TO_UTF8(*BankPath), FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &Banks[i]);
+
+                if (Result != FMOD_OK)
+                {
+                    if (Result == FMOD_ERR_EVENT_ALREADY_LOADED)
+                    {
+                        Retry.Add(BankPath);
+                    }
+                    Banks[i] = nullptr;
+                }
             }
-            else if (MasterAssetsBankPath.IsEmpty() && CurFilename == Settings.GetMasterAssetsBankFilename())
+
+            StudioSystem->flushCommands();
+
+            for (int32 i = 0; i < BatchCount; ++i)
             {
-                MasterAssetsBankPath = BankPath;
+                if (Banks[i] == nullptr)
+                {
+                    continue;
+                }
+
+                // getLoadingState returns the load error if the bank failed to load
+                FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_ERROR;
+                FMOD_RESULT Result = Banks[i]->getLoadingState(&State);
+                FMOD_GUID GUID;
+
+                if (Result == FMOD_OK && State == FMOD_STUDIO_LOADING_STATE_LOADED && Banks[i]->getID(&GUID) == FMOD_OK)
+                {
+                    FileInfos.FindChecked(Pending[BatchStart + i]).Guid = FMODUtils::ConvertGuid(GUID);
+                }
+                else if (Result == FMOD_ERR_EVENT_ALREADY_LOADED)
+                {
+                    Retry.Add(Pending[BatchStart + i]);
+                }
+
+                Banks[i]->unload();
             }
+
+            StudioSystem->flushCommands();
         }
 
-        if (result != FMOD_OK)
+        if (Retry.Num() == Pending.Num())
         {
-            UE_LOG(LogFMOD, Error, TEXT("Failed to register disk file for bank: %s"), *BankPath);
+            // No progress, leave the remaining banks unregistered
+            break;
         }
-    }
 
-    StudioSystem->flushCommands();
+        Pending = MoveTemp(Retry);
+    }
 }
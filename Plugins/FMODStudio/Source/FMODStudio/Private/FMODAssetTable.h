@@ -3,6 +3,7 @@
 #pragma once
 
 #include "FMODAsset.h"
+#include "FMODBankFileCache.h"
 
 namespace FMOD
 {
@@ -34,6 +35,9 @@ public:
     void SetLocale(const FString &LocaleCode);
     void GetAllBankPaths(TArray<FString> &BankPaths, bool IncludeMasterBank) const;
 
+    /** Full paths of the bank files that were added, modified or removed by the last refresh */
+    const TSet<FString> &GetChangedBankFiles() const { return BankFileCache.GetChangedFiles(); }
+
 private:
     struct AssetCreateInfo
     {
@@ -59,6 +63,7 @@ private:
     void DeleteAsset(UObject *Asset);
     void GetAllBankPathsFromDisk(const FString &BankDir, TArray<FString> &Paths);
     void BuildBankPathLookup();
+    void ReadBankGuids(const TArray<FString> &Paths, TMap<FString, FFMODBankFileInfo> &FileInfos);
     FString GetBankPathByGuid(const FGuid& Guid) const;
 
     FMOD::Studio::System *StudioSystem;
@@ -68,4 +73,11 @@ private:
     FString MasterAssetsBankPath;
     TMap<FGuid, BankLocalizations> BankPathLookup;
     FString ActiveLocale;
+
+    /** GUIDs of the bank files on disk, persisted so that only changed files need to be loaded */
+    FFMODBankFileCache BankFileCache;
+
+    /** Strings bank and content browser prefix the current assets were built from */
+    FString AssetsStringsBankPath;
+    FString AssetsContentBrowserPrefix;
 };
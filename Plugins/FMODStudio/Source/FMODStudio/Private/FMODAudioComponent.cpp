@@ -5,7 +5,11 @@
 #include "FMODUtils.h"
 #include "FMODEvent.h"
 #include "FMODListener.h"
+#include "FMODEmitterManager.h"
+#include "FMODBankLoader.h"
+#include "FMODProgrammerSoundCache.h"
 #include "FMODSettings.h"
+#include "FMODStudioCalls.h"
 #include "fmod_studio.hpp"
 #include "Misc/App.h"
 #include "Misc/Paths.h"
@@ -16,6 +20,9 @@
 #include "Engine/Texture2D.h"
 #endif
 
+/** Ring capacity of each timeline callback queue, which holds one less than this. Callbacks that don't fit go to a locked overflow list. */
+static const uint32 TIMELINE_CALLBACK_QUEUE_SIZE = 64;
+
 UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitializer)
     : Super(ObjectInitializer)
 {
@@ -42,6 +49,13 @@ UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitial
     LastVolume = 1.0f;
     Module = nullptr;
     wasOccluded = false;
+    bOcclusionTracePending = false;
+    EmitterIndex = INDEX_NONE;
+    bVirtual = false;
+    bVirtualStopped = false;
+    bOneshot = false;
+    VirtualDistance = 0.0f;
+    VirtualStartTime = 0.0;
 
     for (int i = 0; i < EFMODEventProperty::Count; ++i)
     {
@@ -123,7 +137,12 @@ void UFMODAudioComponent::PostEditChangeProperty(FPropertyChangedEvent &e)
 void UFMODAudioComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
     Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
-    if (StudioInstance)
+    if (bVirtual && GetOwner())
+    {
+        // Only the position is needed to tell when the event comes back into range
+        GetStudioModule().GetEmitterManager().SetPosition(this, GetOwner()->GetTransform().GetTranslation());
+    }
+    else if (StudioInstance)
     {
         FMOD_3D_ATTRIBUTES attr = { { 0 } };
         attr.position = FMODUtils::ConvertWorldVector(GetComponentTransform().GetLocation());
@@ -131,7 +150,12 @@ void UFMODAudioComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransfor
         attr.forward = FMODUtils::ConvertUnitVector(GetComponentTransform().GetUnitAxis(EAxis::X));
         attr.velocity = FMODUtils::ConvertWorldVector(GetOwner()->GetVelocity());
 
-        StudioInstance->set3DAttributes(&attr);
+        GetStudioModule().GetStudioCalls().Set3DAttributes(StudioInstance, attr);
+
+        if (GetOwner())
+        {
+            GetStudioModule().GetEmitterManager().SetPosition(this, GetOwner()->GetTransform().GetTranslation());
+        }
 
         UpdateInteriorVolumes();
         UpdateAttenuation();
@@ -155,9 +179,9 @@ void UFMODAudioComponent::UpdateInteriorVolumes()
     FInteriorSettings *Ambient =
         (FInteriorSettings *)alloca(sizeof(FInteriorSettings)); // FinteriorSetting::FInteriorSettings() isn't exposed (possible UE4 bug???)
     const FVector &Location = GetOwner()->GetTransform().GetTranslation();
-    AAudioVolume *AudioVolume = GetWorld()->GetAudioSettings(Location, NULL, Ambient);
+    AAudioVolume *AudioVolume = GetStudioModule().GetEmitterManager().GetAudioSettings(this, GetWorld(), Location, Ambient);
 
-    const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
+    const FFMODListener &Listener = GetStudioModule().GetEmitterManager().GetNearestListener(this, Location);
     if (InteriorLastUpdateTime < Listener.InteriorStartTime)
     {
         SourceInteriorVolume = CurrentInteriorVolume;
@@ -232,6 +256,8 @@ void UFMODAudioComponent::UpdateAttenuation()
         return;
     }
 
+    SCOPE_CYCLE_COUNTER(STAT_FMOD_AttenuationUpdate);
+
     if (AttenuationDetails.bOverrideAttenuation)
     {
         SetProperty(EFMODEventProperty::MinimumDistance, AttenuationDetails.MinimumDistance);
@@ -241,18 +267,11 @@ void UFMODAudioComponent::UpdateAttenuation()
     // Use occlusion part of settings
     if (OcclusionDetails.bEnableOcclusion && bApplyOcclusionParameter)
     {
-        static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
-        FCollisionQueryParams Params(NAME_SoundOcclusion, OcclusionDetails.bUseComplexCollisionForOcclusion, GetOwner());
-
-        const FVector &Location = GetOwner()->GetTransform().GetTranslation();
-        const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
-
-        bool bIsOccluded = GWorld->LineTraceTestByChannel(Location, Listener.Transform.GetLocation(), OcclusionDetails.OcclusionTraceChannel, Params);
-
-        if (bIsOccluded != wasOccluded)
+        // The module traces asynchronously and calls ApplyOcclusion with the result
+        if (!bOcclusionTracePending)
         {
-            StudioInstance->setParameterByID(OcclusionID, bIsOccluded ? 1.0f : 0.0f);
-            wasOccluded = bIsOccluded;
+            bOcclusionTracePending = true;
+            GetStudioModule().RequestOcclusionTrace(this);
         }
     }
     else
@@ -261,6 +280,16 @@ void UFMODAudioComponent::UpdateAttenuation()
     }
 }
 
+void UFMODAudioComponent::ApplyOcclusion(bool bIsOccluded)
+{
+    bOcclusionTracePending = false;
+    if (StudioInstance && bIsOccluded != wasOccluded)
+    {
+        GetStudioModule().GetStudioCalls().SetParameterByID(StudioInstance, OcclusionID, bIsOccluded ? 1.0f : 0.0f);
+        wasOccluded = bIsOccluded;
+    }
+}
+
 void UFMODAudioComponent::ApplyVolumeLPF()
 {
     if (bApplyAmbientVolumes)
@@ -268,14 +297,14 @@ void UFMODAudioComponent::ApplyVolumeLPF()
         float CurVolume = AmbientVolume;
         if (CurVolume != LastVolume)
         {
-            StudioInstance->setParameterByID(AmbientVolumeID, CurVolume);
+            GetStudioModule().GetStudioCalls().SetParameterByID(StudioInstance, AmbientVolumeID, CurVolume);
             LastVolume = CurVolume;
         }
 
         float CurLPF = AmbientLPF;
         if (CurLPF != LastLPF)
         {
-            StudioInstance->setParameterByID(AmbientLPFID, CurLPF);
+            GetStudioModule().GetStudioCalls().SetParameterByID(StudioInstance, AmbientLPFID, CurLPF);
             LastLPF = CurLPF;
         }
     }
@@ -288,12 +317,12 @@ void UFMODAudioComponent::ApplyVolumeLPF()
 
 void UFMODAudioComponent::CacheDefaultParameterValues()
 {
-    if (Event)
+    const FFMODEventDescriptionInfo *EventInfo =
+        GetStudioModule().AreBanksLoaded() ? GetStudioModule().GetEventDescriptionInfo(Event.Get(), EFMODSystemContext::Auditioning) : nullptr;
+    if (EventInfo)
     {
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
-        TArray<FMOD_STUDIO_PARAMETER_DESCRIPTION> ParameterDescriptions;
-        Event->GetParameterDescriptions(ParameterDescriptions);
-        for (const FMOD_STUDIO_PARAMETER_DESCRIPTION &ParameterDescription : ParameterDescriptions)
+        for (const FMOD_STUDIO_PARAMETER_DESCRIPTION &ParameterDescription : EventInfo->Parameters)
         {
             if (!ParameterCache.Find(ParameterDescription.name) && 
                 (ParameterDescription.type == FMOD_STUDIO_PARAMETER_GAME_CONTROLLED) &&
@@ -349,41 +378,22 @@ void UFMODAudioComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-    if (IsActive())
+    // Listener updates and playback state are handled by the module's emitter manager,
+    // so we only tick to dispatch timeline callbacks on the game thread
+    if (IsActive() && bEnableTimelineCallbacks && CallbackMarkerQueue.IsValid())
     {
-        if (GetStudioModule().HasListenerMoved())
-        {
-            UpdateInteriorVolumes();
-            UpdateAttenuation();
-            ApplyVolumeLPF();
-        }
-
-        if (bEnableTimelineCallbacks)
-        {
-            TArray<FTimelineMarkerProperties> LocalMarkerQueue;
-            TArray<FTimelineBeatProperties> LocalBeatQueue;
-            {
-                FScopeLock Lock(&CallbackLock);
-                Swap(LocalMarkerQueue, CallbackMarkerQueue);
-                Swap(LocalBeatQueue, CallbackBeatQueue);
-            }
+        int32 Overflowed = CallbackMarkerQueue->DequeueAll([this](const FTimelineMarkerProperties &MarkerProps) {
+            OnTimelineMarker.Broadcast(MarkerProps.Name, MarkerProps.Position);
+        });
 
-            for (const FTimelineMarkerProperties &EachProps : LocalMarkerQueue)
-            {
-                OnTimelineMarker.Broadcast(EachProps.Name, EachProps.Position);
-            }
-            for (const FTimelineBeatProperties &EachProps : LocalBeatQueue)
-            {
-                OnTimelineBeat.Broadcast(
-                    EachProps.Bar, EachProps.Beat, EachProps.Position, EachProps.Tempo, EachProps.TimeSignatureUpper, EachProps.TimeSignatureLower);
-            }
-        }
+        Overflowed += CallbackBeatQueue->DequeueAll([this](const FTimelineBeatProperties &BeatProps) {
+            OnTimelineBeat.Broadcast(
+                BeatProps.Bar, BeatProps.Beat, BeatProps.Position, BeatProps.Tempo, BeatProps.TimeSignatureUpper, BeatProps.TimeSignatureLower);
+        });
 
-        FMOD_STUDIO_PLAYBACK_STATE state = FMOD_STUDIO_PLAYBACK_STOPPED;
-        StudioInstance->getPlaybackState(&state);
-        if (state == FMOD_STUDIO_PLAYBACK_STOPPED)
+        if (Overflowed > 0)
         {
-            OnPlaybackCompleted();
+            UE_LOG(LogFMOD, Verbose, TEXT("%s: %d timeline callbacks didn't fit in the callback queue since the last tick"), *GetName(), Overflowed);
         }
     }
 }
@@ -459,9 +469,18 @@ void UFMODAudioComponent_ReleaseProgrammerSound(FMOD_STUDIO_PROGRAMMER_SOUND_PRO
 {
     if (props->sound)
     {
-        UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
-        FMOD_RESULT Result = ((FMOD::Sound *)props->sound)->release();
-        verifyfmod(Result);
+        // The component may already be gone, so find the cache through the module manager, which is safe off the game thread
+        IFMODStudioModule *Module = FModuleManager::GetModulePtr<IFMODStudioModule>("FMODStudio");
+        if (Module)
+        {
+            Module->GetProgrammerSoundCache().Release((FMOD::Sound *)props->sound);
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
+            FMOD_RESULT Result = ((FMOD::Sound *)props->sound)->release();
+            verifyfmod(Result);
+        }
     }
 }
 
@@ -473,16 +492,22 @@ FMOD_RESULT F_CALLBACK UFMODAudioComponent_EventCallbackDestroyProgrammerSound(F
 
 void UFMODAudioComponent::EventCallbackAddMarker(FMOD_STUDIO_TIMELINE_MARKER_PROPERTIES *props)
 {
-    FScopeLock Lock(&CallbackLock);
+    if (!CallbackMarkerQueue.IsValid())
+    {
+        return;
+    }
     FTimelineMarkerProperties info;
     info.Name = props->name;
     info.Position = props->position;
-    CallbackMarkerQueue.Push(info);
+    CallbackMarkerQueue->Enqueue(MoveTemp(info));
 }
 
 void UFMODAudioComponent::EventCallbackAddBeat(FMOD_STUDIO_TIMELINE_BEAT_PROPERTIES *props)
 {
-    FScopeLock Lock(&CallbackLock);
+    if (!CallbackBeatQueue.IsValid())
+    {
+        return;
+    }
     FTimelineBeatProperties info;
     info.Bar = props->bar;
     info.Beat = props->beat;
@@ -490,7 +515,7 @@ void UFMODAudioComponent::EventCallbackAddBeat(FMOD_STUDIO_TIMELINE_BEAT_PROPERT
     info.Tempo = props->tempo;
     info.TimeSignatureUpper = props->timesignatureupper;
     info.TimeSignatureLower = props->timesignaturelower;
-    CallbackBeatQueue.Push(info);
+    CallbackBeatQueue->Enqueue(info);
 }
 
 void UFMODAudioComponent::EventCallbackCreateProgrammerSound(FMOD_STUDIO_PROGRAMMER_SOUND_PROPERTIES *props)
@@ -510,59 +535,15 @@ void UFMODAudioComponent::EventCallbackCreateProgrammerSound(FMOD_STUDIO_PROGRAM
     else if (ProgrammerSoundNameCopy.Len() || strlen(props->name) != 0)
     {
         FMOD::Studio::System *System = GetStudioModule().GetStudioSystem(EFMODSystemContext::Max);
-        FMOD::System *LowLevelSystem = nullptr;
-        System->getCoreSystem(&LowLevelSystem);
         FString SoundName = ProgrammerSoundNameCopy.Len() ? ProgrammerSoundNameCopy : UTF8_TO_TCHAR(props->name);
-        FMOD_MODE SoundMode = FMOD_LOOP_NORMAL | FMOD_CREATECOMPRESSEDSAMPLE | FMOD_NONBLOCKING;
-
-        if (SoundName.Contains(TEXT(".")))
-        {
-            // Load via file
-            FString SoundPath = SoundName;
-            if (FPaths::IsRelative(SoundPath))
-            {
-                SoundPath = FPaths::ProjectContentDir() / SoundPath;
-            }
 
-            FMOD::Sound *Sound = nullptr;
-            if (LowLevelSystem->createSound(TCHAR_TO_UTF8(*SoundPath), SoundMode, nullptr, &Sound) == FMOD_OK)
-            {
-                UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from file '%s'"), *SoundPath);
-                props->sound = (FMOD_SOUND *)Sound;
-                props->subsoundIndex = -1;
-                NeedDestroyProgrammerSoundCallback = true;
-            }
-            else
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound file '%s'"), *SoundPath);
-            }
-        }
-        else
+        FMOD::Sound *Sound = nullptr;
+        int32 SubsoundIndex = -1;
+        if (GetStudioModule().GetProgrammerSoundCache().Acquire(System, SoundName, Sound, SubsoundIndex))
         {
-            // Load via FMOD Studio asset table
-            FMOD_STUDIO_SOUND_INFO SoundInfo = { 0 };
-            FMOD_RESULT Result = System->getSoundInfo(TCHAR_TO_UTF8(*SoundName), &SoundInfo);
-            if (Result == FMOD_OK)
-            {
-                FMOD::Sound *Sound = nullptr;
-                Result = LowLevelSystem->createSound(SoundInfo.name_or_data, SoundMode | SoundInfo.mode, &SoundInfo.exinfo, &Sound);
-                if (Result == FMOD_OK)
-                {
-                    UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound using audio entry '%s'"), *SoundName);
-
-                    props->sound = (FMOD_SOUND *)Sound;
-                    props->subsoundIndex = SoundInfo.subsoundindex;
-                    NeedDestroyProgrammerSoundCallback = true;
-                }
-                else
-                {
-                    UE_LOG(LogFMOD, Warning, TEXT("Failed to load FMOD audio entry '%s'"), *SoundName);
-                }
-            }
-            else
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to find FMOD audio entry '%s'"), *SoundName);
-            }
+            props->sound = (FMOD_SOUND *)Sound;
+            props->subsoundIndex = SubsoundIndex;
+            NeedDestroyProgrammerSoundCallback = true;
         }
     }
 }
@@ -595,7 +576,10 @@ void UFMODAudioComponent::Play()
 
 void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context)
 {
+    SCOPE_CYCLE_COUNTER(STAT_FMOD_Play);
+
     Stop();
+    bOcclusionTracePending = false;
 
     if (!FMODUtils::IsWorldAudible(GetWorld(), Context == EFMODSystemContext::Editor))
     {
@@ -605,83 +589,204 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context)
     UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p Play"), this);
 
     // Only play events in PIE/game, not when placing them in the editor
-    FMOD::Studio::EventDescription *EventDesc = GetStudioModule().GetEventDescription(Event.Get(), Context);
-    if (EventDesc != nullptr)
+    const FFMODEventDescriptionInfo *EventInfo = GetStudioModule().GetStudioCalls().GetEventDescriptionInfo(Event.Get(), Context);
+    if (EventInfo != nullptr)
     {
-        EventDesc->getLength(&EventLength);
-        if (!StudioInstance || !StudioInstance->isValid())
-        {
-            FMOD_RESULT result = EventDesc->createInstance(&StudioInstance);
-            if (result != FMOD_OK)
-                return;
-        }
+        FMOD::Studio::EventDescription *EventDesc = EventInfo->Description;
+        EventLength = EventInfo->Length;
+        bOneshot = EventInfo->bOneshot;
 
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
-        FMOD_STUDIO_PARAMETER_DESCRIPTION paramDesc = {};
         FString param = Settings.OcclusionParameter;
         if (!param.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*Settings.OcclusionParameter), &paramDesc) == FMOD_OK)
+            if (FindParameterID(FName(*param), OcclusionID))
             {
-                OcclusionID = paramDesc.id;
                 bApplyOcclusionParameter = true;
             }
         }
 
-        paramDesc = {};
         param = Settings.AmbientVolumeParameter;
         if (!param.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*param), &paramDesc) == FMOD_OK)
+            if (FindParameterID(FName(*param), AmbientVolumeID))
             {
-                AmbientVolumeID = paramDesc.id;
                 bApplyAmbientVolumes = true;
             }
         }
 
-        paramDesc = {};
         param = Settings.AmbientLPFParameter;
         if (!param.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*Settings.AmbientLPFParameter), &paramDesc) == FMOD_OK)
+            if (FindParameterID(FName(*param), AmbientLPFID))
             {
-                AmbientLPFID = paramDesc.id;
                 bApplyAmbientVolumes = true;
             }
         }
 
-        OnUpdateTransform(EUpdateTransformFlags::SkipPhysicsUpdate);
-        // Set initial parameters
-        for (auto Kvp : ParameterCache)
+        if (Context != EFMODSystemContext::Editor)
         {
-            FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Kvp.Key.ToString()), Kvp.Value);
-            if (Result != FMOD_OK)
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial parameter %s"), *Kvp.Key.ToString());
-            }
+            GetStudioModule().GetBankLoader().TouchEvent(EventDesc);
         }
-        for (int i = 0; i < EFMODEventProperty::Count; ++i)
+
+        // Events out of range of every listener only record when they started until a listener gets close enough
+        VirtualDistance = GetVirtualDistance(*EventInfo, Context);
+        VirtualStartTime = FApp::GetCurrentTime();
+        bVirtualStopped = false;
+
+        if (VirtualDistance > 0.0f && GetOwner())
         {
-            if (StoredProperties[i] != -1.0f)
+            const FVector Location = GetOwner()->GetTransform().GetTranslation();
+            const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
+            if (FVector::DistSquared(Location, Listener.Transform.GetTranslation()) > FMath::Square(VirtualDistance))
             {
-                FMOD_RESULT Result = StudioInstance->setProperty((FMOD_STUDIO_EVENT_PROPERTY)i, StoredProperties[i]);
-                if (Result != FMOD_OK)
-                {
-                    UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial property %d"), i);
-                }
+                ReleaseStudioInstance();
+                bVirtual = true;
+                GetStudioModule().GetEmitterManager().Register(this, nullptr, VirtualDistance);
+                OnUpdateTransform(EUpdateTransformFlags::SkipPhysicsUpdate);
+                UE_LOG(LogFMOD, Verbose, TEXT("Playing component %p virtually"), this);
+                SetActiveFlag(true);
+                SetComponentTickEnabled(bEnableTimelineCallbacks);
+                return;
             }
         }
 
-        if (bEnableTimelineCallbacks || !ProgrammerSoundName.IsEmpty())
+        bVirtual = false;
+        if (!StartStudioInstance(EventDesc, 0))
         {
-            verifyfmod(StudioInstance->setCallback(UFMODAudioComponent_EventCallback));
+            return;
         }
-        verifyfmod(StudioInstance->setUserData(this));
-        verifyfmod(StudioInstance->start());
         UE_LOG(LogFMOD, Verbose, TEXT("Playing component %p"), this);
         SetActiveFlag(true);
-        SetComponentTickEnabled(true);
+        SetComponentTickEnabled(bEnableTimelineCallbacks);
+    }
+}
+
+bool UFMODAudioComponent::StartStudioInstance(FMOD::Studio::EventDescription *EventDesc, int32 TimelinePosition)
+{
+    FFMODStudioCalls &Calls = GetStudioModule().GetStudioCalls();
+    if (!StudioInstance || !Calls.IsValid(StudioInstance))
+    {
+        FMOD_RESULT result = Calls.CreateInstance(EventDesc, &StudioInstance);
+        if (result != FMOD_OK)
+            return false;
+    }
+    GetStudioModule().GetEmitterManager().Register(this, StudioInstance, VirtualDistance);
+
+    OnUpdateTransform(EUpdateTransformFlags::SkipPhysicsUpdate);
+    // Set initial parameters
+    for (auto Kvp : ParameterCache)
+    {
+        FMOD_RESULT Result = SetInstanceParameter(Kvp.Key, Kvp.Value);
+        if (Result != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial parameter %s"), *Kvp.Key.ToString());
+        }
+    }
+    for (int i = 0; i < EFMODEventProperty::Count; ++i)
+    {
+        if (StoredProperties[i] != -1.0f)
+        {
+            FMOD_RESULT Result = Calls.SetProperty(StudioInstance, (FMOD_STUDIO_EVENT_PROPERTY)i, StoredProperties[i]);
+            if (Result != FMOD_OK)
+            {
+                UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial property %d"), i);
+            }
+        }
+    }
+
+    if (bEnableTimelineCallbacks || !ProgrammerSoundName.IsEmpty())
+    {
+        // Created before the callback is set so the FMOD thread never sees them change
+        if (!CallbackMarkerQueue.IsValid())
+        {
+            CallbackMarkerQueue = MakeUnique<TFMODCallbackQueue<FTimelineMarkerProperties>>(TIMELINE_CALLBACK_QUEUE_SIZE);
+            CallbackBeatQueue = MakeUnique<TFMODCallbackQueue<FTimelineBeatProperties>>(TIMELINE_CALLBACK_QUEUE_SIZE);
+        }
+        verifyfmod(Calls.SetCallback(StudioInstance, UFMODAudioComponent_EventCallback));
+    }
+    verifyfmod(Calls.SetUserData(StudioInstance, this));
+    if (TimelinePosition > 0)
+    {
+        Calls.SetTimelinePosition(StudioInstance, TimelinePosition);
+    }
+    verifyfmod(Calls.Start(StudioInstance));
+    return true;
+}
+
+float UFMODAudioComponent::GetVirtualDistance(const FFMODEventDescriptionInfo &EventInfo, EFMODSystemContext::Type Context) const
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (!Settings.bVirtualizeOutOfRangeEvents || Context == EFMODSystemContext::Editor || Context == EFMODSystemContext::Auditioning)
+    {
+        return 0.0f;
+    }
+
+    if (!EventInfo.bIs3D)
+    {
+        return 0.0f;
+    }
+
+    float MaxDistance = AttenuationDetails.bOverrideAttenuation ? AttenuationDetails.MaximumDistance : EventInfo.MaximumDistance;
+    return FMODUtils::DistanceToUEScale(MaxDistance);
+}
+
+int32 UFMODAudioComponent::GetVirtualTimelinePosition() const
+{
+    return (int32)((FApp::GetCurrentTime() - VirtualStartTime) * 1000.0);
+}
+
+void UFMODAudioComponent::Virtualize()
+{
+    if (bVirtual || !StudioInstance)
+    {
+        return;
+    }
+
+    FFMODStudioCalls &Calls = GetStudioModule().GetStudioCalls();
+    int Position = 0;
+    Calls.GetTimelinePosition(StudioInstance, &Position);
+    VirtualStartTime = FApp::GetCurrentTime() - Position / 1000.0;
+
+    Calls.Stop(StudioInstance, FMOD_STUDIO_STOP_IMMEDIATE);
+    ReleaseStudioInstance();
+    bVirtual = true;
+    GetStudioModule().GetEmitterManager().Register(this, nullptr, VirtualDistance);
+    UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p virtualized"), this);
+}
+
+bool UFMODAudioComponent::Devirtualize()
+{
+    if (!bVirtual)
+    {
+        return true;
+    }
+    if (HasVirtualPlaybackFinished())
+    {
+        return false;
+    }
+
+    int32 Position = GetVirtualTimelinePosition();
+    if (EventLength > 0)
+    {
+        // Looping regions aren't known here, so sustained events are assumed to loop over their whole length
+        Position %= EventLength;
+    }
+
+    const FFMODEventDescriptionInfo *EventInfo =
+        GetStudioModule().GetStudioCalls().GetEventDescriptionInfo(Event.Get(), EFMODSystemContext::Max);
+    bVirtual = false;
+    if (!EventInfo || !StartStudioInstance(EventInfo->Description, Position))
+    {
+        return false;
     }
+    UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p devirtualized at %d ms"), this, Position);
+    return true;
+}
+
+bool UFMODAudioComponent::HasVirtualPlaybackFinished() const
+{
+    return bVirtualStopped || (bOneshot && EventLength > 0 && GetVirtualTimelinePosition() >= EventLength);
 }
 
 void UFMODAudioComponent::Stop()
@@ -689,7 +794,12 @@ void UFMODAudioComponent::Stop()
     UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p Stop"), this);
     if (StudioInstance)
     {
-        StudioInstance->stop(FMOD_STUDIO_STOP_ALLOWFADEOUT);
+        GetStudioModule().GetStudioCalls().Stop(StudioInstance, FMOD_STUDIO_STOP_ALLOWFADEOUT);
+    }
+    if (bVirtual)
+    {
+        // Completed by the emitter manager, like a real instance that has stopped
+        bVirtualStopped = true;
     }
 
     wasOccluded = false;
@@ -708,21 +818,34 @@ void UFMODAudioComponent::ReleaseEventCache()
 }
 
 void UFMODAudioComponent::ReleaseEventInstance()
+{
+    ReleaseStudioInstance();
+    bVirtual = false;
+
+    if (EmitterIndex != INDEX_NONE)
+    {
+        GetStudioModule().GetEmitterManager().Unregister(this);
+    }
+}
+
+void UFMODAudioComponent::ReleaseStudioInstance()
 {
     if (StudioInstance)
     {
+        FFMODStudioCalls &Calls = GetStudioModule().GetStudioCalls();
         if (NeedDestroyProgrammerSoundCallback)
         {
             // We need a callback to destroy a programmer sound
-            StudioInstance->setCallback(UFMODAudioComponent_EventCallbackDestroyProgrammerSound, FMOD_STUDIO_EVENT_CALLBACK_DESTROY_PROGRAMMER_SOUND);
+            Calls.SetCallback(
+                StudioInstance, UFMODAudioComponent_EventCallbackDestroyProgrammerSound, FMOD_STUDIO_EVENT_CALLBACK_DESTROY_PROGRAMMER_SOUND);
         }
         else
         {
             // We don't want any more callbacks
-            StudioInstance->setCallback(nullptr);
+            Calls.SetCallback(StudioInstance, nullptr);
         }
 
-        StudioInstance->release();
+        Calls.Release(StudioInstance);
         StudioInstance = nullptr;
     }
 }
@@ -800,7 +923,7 @@ void UFMODAudioComponent::SetParameter(FName Name, float Value)
 {
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
+        FMOD_RESULT Result = SetInstanceParameter(Name, Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Name.ToString());
@@ -809,12 +932,71 @@ void UFMODAudioComponent::SetParameter(FName Name, float Value)
     ParameterCache.FindOrAdd(Name) = Value;
 }
 
+void UFMODAudioComponent::SetParameters(TArrayView<const FName> Names, TArrayView<const float> Values)
+{
+    check(Names.Num() == Values.Num());
+
+    TArray<FMOD_STUDIO_PARAMETER_ID, TInlineAllocator<16>> BatchIDs;
+    TArray<float, TInlineAllocator<16>> BatchValues;
+    for (int32 i = 0; i < Names.Num(); ++i)
+    {
+        // The cache holds the last value set, which a new instance also starts with
+        const float *CachedValue = ParameterCache.Find(Names[i]);
+        if (CachedValue && *CachedValue == Values[i])
+        {
+            continue;
+        }
+        ParameterCache.Add(Names[i], Values[i]);
+
+        if (StudioInstance)
+        {
+            FMOD_STUDIO_PARAMETER_ID ParameterID;
+            if (FindParameterID(Names[i], ParameterID))
+            {
+                BatchIDs.Add(ParameterID);
+                BatchValues.Add(Values[i]);
+            }
+            else if (SetInstanceParameter(Names[i], Values[i]) != FMOD_OK)
+            {
+                UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Names[i].ToString());
+            }
+        }
+    }
+
+    if (BatchIDs.Num() > 0)
+    {
+        FMOD_RESULT Result =
+            GetStudioModule().GetStudioCalls().SetParametersByIDs(StudioInstance, BatchIDs.GetData(), BatchValues.GetData(), BatchIDs.Num());
+        if (Result != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to set %d parameters"), BatchIDs.Num());
+        }
+    }
+}
+
+bool UFMODAudioComponent::FindParameterID(FName Name, FMOD_STUDIO_PARAMETER_ID &OutID) const
+{
+    const UFMODEvent *EventPtr = Event.Get();
+    return EventPtr && EventPtr->FindParameterID(Name, OutID);
+}
+
+FMOD_RESULT UFMODAudioComponent::SetInstanceParameter(FName Name, float Value)
+{
+    // Parameters the event doesn't know about still go through the name lookup so errors are reported the same way
+    FMOD_STUDIO_PARAMETER_ID ParameterID;
+    if (FindParameterID(Name, ParameterID))
+    {
+        return GetStudioModule().GetStudioCalls().SetParameterByID(StudioInstance, ParameterID, Value);
+    }
+    return GetStudioModule().GetStudioCalls().SetParameterByName(StudioInstance, TCHAR_TO_UTF8(*Name.ToString()), Value);
+}
+
 void UFMODAudioComponent::SetProperty(EFMODEventProperty::Type Property, float Value)
 {
     verify(Property < EFMODEventProperty::Count);
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setProperty((FMOD_STUDIO_EVENT_PROPERTY)Property, Value);
+        FMOD_RESULT Result = GetStudioModule().GetStudioCalls().SetProperty(StudioInstance, (FMOD_STUDIO_EVENT_PROPERTY)Property, Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set property %d"), (int)Property);
@@ -827,7 +1009,7 @@ float UFMODAudioComponent::GetProperty(EFMODEventProperty::Type Property)
 {
     verify(Property < EFMODEventProperty::Count);
     float outValue = 0;
-    if (Event)
+    if (StudioInstance)
     {
         FMOD_RESULT Result = StudioInstance->getProperty((FMOD_STUDIO_EVENT_PROPERTY)Property, &outValue);
         if (Result != FMOD_OK)
@@ -835,6 +1017,11 @@ float UFMODAudioComponent::GetProperty(EFMODEventProperty::Type Property)
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get property %d"), (int)Property);
         }
     }
+    else if (bVirtual)
+    {
+        // Virtual events have no instance to ask, so report what will be applied when they get one
+        return StoredProperties[Property];
+    }
     return StoredProperties[Property] = outValue;
 }
 
@@ -845,9 +1032,13 @@ int32 UFMODAudioComponent::GetLength() const
 
 void UFMODAudioComponent::SetTimelinePosition(int32 Time)
 {
-    if (StudioInstance)
+    if (bVirtual)
     {
-        FMOD_RESULT Result = StudioInstance->setTimelinePosition(Time);
+        VirtualStartTime = FApp::GetCurrentTime() - Time / 1000.0;
+    }
+    else if (StudioInstance)
+    {
+        FMOD_RESULT Result = GetStudioModule().GetStudioCalls().SetTimelinePosition(StudioInstance, Time);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set timeline position"));
@@ -858,9 +1049,13 @@ void UFMODAudioComponent::SetTimelinePosition(int32 Time)
 int32 UFMODAudioComponent::GetTimelinePosition()
 {
     int Time = 0;
-    if (StudioInstance)
+    if (bVirtual)
+    {
+        Time = GetVirtualTimelinePosition();
+    }
+    else if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getTimelinePosition(&Time);
+        FMOD_RESULT Result = GetStudioModule().GetStudioCalls().GetTimelinePosition(StudioInstance, &Time);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get timeline position"));
@@ -880,7 +1075,9 @@ float UFMODAudioComponent::GetParameter(FName Name)
     float Value = CachedValue ? *CachedValue : 0.0;
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
+        FMOD_STUDIO_PARAMETER_ID ParameterID;
+        FMOD_RESULT Result = FindParameterID(Name, ParameterID) ? StudioInstance->getParameterByID(ParameterID, &Value) :
+                                                                  StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get parameter %s"), *Name.ToString());
@@ -899,7 +1096,10 @@ void UFMODAudioComponent::GetParameterValue(FName Name, float &UserValue, float
     float *CachedValue = ParameterCache.Find(Name);
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
+        FMOD_STUDIO_PARAMETER_ID ParameterID;
+        FMOD_RESULT Result = FindParameterID(Name, ParameterID) ?
+                                 StudioInstance->getParameterByID(ParameterID, &UserValue, &FinalValue) :
+                                 StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
         if (Result != FMOD_OK)
         {
             UserValue = FinalValue = 0;
@@ -0,0 +1,184 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODAudioVolumeCache.h"
+#include "Components/BrushComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Sound/AudioVolume.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+/** Distance the caller has to move before its audio volume is resolved again */
+static const float AUDIO_VOLUME_CACHE_DISTANCE = 50.0f;
+
+/** Size of the grid cells used to find candidate volumes */
+static const float AUDIO_VOLUME_GRID_CELL_SIZE = 2000.0f;
+
+/** Volumes covering more cells than this are tested for every lookup instead */
+static const int32 AUDIO_VOLUME_GRID_MAX_CELLS = 1024;
+
+AAudioVolume *FFMODAudioVolumeCache::GetAudioSettings(
+    UWorld *World, const FVector &Location, FFMODAudioVolumeCacheEntry &Entry, FInteriorSettings *OutInteriorSettings)
+{
+    FWorldVolumes &Data = GetWorldVolumes(World);
+
+    if (Entry.World != World || Entry.Generation != Data.Generation ||
+        FVector::DistSquared(Entry.Location, Location) > FMath::Square(AUDIO_VOLUME_CACHE_DISTANCE))
+    {
+        Entry.World = World;
+        Entry.Volume = FindVolume(Data, Location);
+        Entry.Location = Location;
+        Entry.Generation = Data.Generation;
+    }
+
+    if (OutInteriorSettings)
+    {
+        // Settings are cheap to read, so only the volume itself is cached
+        *OutInteriorSettings = Entry.Volume ? Entry.Volume->GetInteriorSettings() : World->GetWorldSettings(true)->DefaultAmbientZoneSettings;
+    }
+    return Entry.Volume;
+}
+
+void FFMODAudioVolumeCache::Reset()
+{
+    Worlds.Reset();
+}
+
+FFMODAudioVolumeCache::FWorldVolumes &FFMODAudioVolumeCache::GetWorldVolumes(UWorld *World)
+{
+    FWorldVolumes *Data = Worlds.Find(World);
+    if (!Data)
+    {
+        // Drop worlds that have gone away, e.g. previous PIE sessions
+        for (auto It = Worlds.CreateIterator(); It; ++It)
+        {
+            if (!It.Key().IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+
+        Data = &Worlds.Add(World);
+        Rebuild(World, *Data);
+        Data->LastValidatedFrame = GFrameCounter;
+    }
+    else if (Data->LastValidatedFrame != GFrameCounter)
+    {
+        if (HaveVolumesChanged(World, *Data))
+        {
+            Rebuild(World, *Data);
+        }
+        Data->LastValidatedFrame = GFrameCounter;
+    }
+    return *Data;
+}
+
+bool FFMODAudioVolumeCache::HaveVolumesChanged(const UWorld *World, const FWorldVolumes &Data) const
+{
+    if (World->AudioVolumes != Data.WorldVolumes)
+    {
+        return true;
+    }
+
+    for (int32 i = 0; i < Data.WorldVolumes.Num(); ++i)
+    {
+        const AAudioVolume *Volume = Data.WorldVolumes[i];
+        const UBrushComponent *Brush = Volume->GetBrushComponent();
+        if (Volume->GetEnabled() != Data.WorldEnabled[i] || (Brush && !Brush->Bounds.GetBox().Equals(Data.WorldBounds[i])))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FFMODAudioVolumeCache::Rebuild(const UWorld *World, FWorldVolumes &Data)
+{
+    // Generations are unique across worlds so entries can't match a new world allocated at the same address
+    Data.Generation = ++NextGeneration;
+    Data.Volumes.Reset();
+    Data.Bounds.Reset();
+    Data.Grid.Reset();
+    Data.LargeVolumes.Reset();
+    Data.WorldVolumes = World->AudioVolumes;
+    Data.WorldBounds.Reset();
+    Data.WorldEnabled.Reset();
+
+    for (AAudioVolume *Volume : World->AudioVolumes)
+    {
+        const UBrushComponent *Brush = Volume->GetBrushComponent();
+        const FBox Box = Brush ? Brush->Bounds.GetBox() : FBox(ForceInit);
+        Data.WorldBounds.Add(Box);
+        Data.WorldEnabled.Add(Volume->GetEnabled());
+
+        if (!Volume->GetEnabled() || !Box.IsValid)
+        {
+            continue;
+        }
+
+        // Pad the bounds slightly so points on the brush surface still reach EncompassesPoint
+        const FBox PaddedBox = Box.ExpandBy(1.0f);
+        const int32 Index = Data.Volumes.Add(Volume);
+        Data.Bounds.Add(PaddedBox);
+
+        const FIntVector MinCell = GetCell(PaddedBox.Min);
+        const FIntVector MaxCell = GetCell(PaddedBox.Max);
+        const int64 CellCount =
+            int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+        if (CellCount > AUDIO_VOLUME_GRID_MAX_CELLS)
+        {
+            Data.LargeVolumes.Add(Index);
+            continue;
+        }
+
+        for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+            {
+                for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+                {
+                    Data.Grid.FindOrAdd(FIntVector(X, Y, Z)).Add(Index);
+                }
+            }
+        }
+    }
+}
+
+AAudioVolume *FFMODAudioVolumeCache::FindVolume(const FWorldVolumes &Data, const FVector &Location) const
+{
+    static const TArray<int32> NoVolumes;
+    const TArray<int32> *CellVolumes = Data.Grid.Find(GetCell(Location));
+    if (!CellVolumes)
+    {
+        CellVolumes = &NoVolumes;
+    }
+
+    // Both lists are in priority order, so merge them and stop at the first volume containing the location
+    int32 CellIndex = 0;
+    int32 LargeIndex = 0;
+    while (CellIndex < CellVolumes->Num() || LargeIndex < Data.LargeVolumes.Num())
+    {
+        int32 Index;
+        if (LargeIndex >= Data.LargeVolumes.Num() ||
+            (CellIndex < CellVolumes->Num() && (*CellVolumes)[CellIndex] < Data.LargeVolumes[LargeIndex]))
+        {
+            Index = (*CellVolumes)[CellIndex++];
+        }
+        else
+        {
+            Index = Data.LargeVolumes[LargeIndex++];
+        }
+
+        if (Data.Bounds[Index].IsInside(Location) && Data.Volumes[Index]->EncompassesPoint(Location))
+        {
+            return Data.Volumes[Index];
+        }
+    }
+    return nullptr;
+}
+
+FIntVector FFMODAudioVolumeCache::GetCell(const FVector &Location)
+{
+    return FIntVector(FMath::FloorToInt(Location.X / AUDIO_VOLUME_GRID_CELL_SIZE), FMath::FloorToInt(Location.Y / AUDIO_VOLUME_GRID_CELL_SIZE),
+        FMath::FloorToInt(Location.Z / AUDIO_VOLUME_GRID_CELL_SIZE));
+}
@@ -0,0 +1,84 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AAudioVolume;
+class UWorld;
+struct FInteriorSettings;
+
+/** The audio volume last resolved for an emitter or listener */
+struct FFMODAudioVolumeCacheEntry
+{
+    FFMODAudioVolumeCacheEntry()
+        : World(nullptr)
+        , Volume(nullptr)
+        , Location(FVector::ZeroVector)
+        , Generation(0)
+    {
+    }
+
+    const UWorld *World;
+    AAudioVolume *Volume;
+    FVector Location;
+    uint32 Generation;
+};
+
+/**
+ * Replacement for UWorld::GetAudioSettings which reuses the previous result until the caller has moved
+ * far enough or the world's audio volumes have changed. Lookups that miss only test the volumes whose
+ * bounds overlap the caller's grid cell.
+ */
+class FFMODAudioVolumeCache
+{
+public:
+    FFMODAudioVolumeCache()
+        : NextGeneration(0)
+    {
+    }
+
+    /** Return the audio volume at the given location and its interior settings, updating the cache entry if needed */
+    AAudioVolume *GetAudioSettings(UWorld *World, const FVector &Location, FFMODAudioVolumeCacheEntry &Entry, FInteriorSettings *OutInteriorSettings);
+
+    /** Forget all cached worlds */
+    void Reset();
+
+private:
+    struct FWorldVolumes
+    {
+        FWorldVolumes()
+            : Generation(0)
+            , LastValidatedFrame(0)
+        {
+        }
+
+        /** Enabled volumes in the world's priority order */
+        TArray<AAudioVolume *> Volumes;
+        TArray<FBox> Bounds;
+
+        /** Indices into Volumes for each grid cell, in ascending order */
+        TMap<FIntVector, TArray<int32>> Grid;
+
+        /** Volumes too large to add to the grid, tested for every lookup */
+        TArray<int32> LargeVolumes;
+
+        /** Snapshot of the world's volume list used to detect changes */
+        TArray<AAudioVolume *> WorldVolumes;
+        TArray<FBox> WorldBounds;
+        TArray<bool> WorldEnabled;
+
+        uint32 Generation;
+        uint64 LastValidatedFrame;
+    };
+
+    FWorldVolumes &GetWorldVolumes(UWorld *World);
+    bool HaveVolumesChanged(const UWorld *World, const FWorldVolumes &Data) const;
+    void Rebuild(const UWorld *World, FWorldVolumes &Data);
+    AAudioVolume *FindVolume(const FWorldVolumes &Data, const FVector &Location) const;
+    static FIntVector GetCell(const FVector &Location);
+
+    TMap<TWeakObjectPtr<UWorld>, FWorldVolumes> Worlds;
+    uint32 NextGeneration;
+};
@@ -0,0 +1,145 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODBankFileCache.h"
+#include "HAL/FileManager.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+/** Bump when the layout of the bank file cache changes */
+static const int32 BANK_FILE_CACHE_VERSION = 1;
+
+void FFMODBankFileCache::Update(const TArray<FString> &Paths, FReadGuids ReadGuids)
+{
+    if (!bLoaded)
+    {
+        Load();
+        bLoaded = true;
+    }
+
+    // Reuse the cached GUID of any file that hasn't changed since it was last read
+    TMap<FString, FFMODBankFileInfo> FileInfos;
+    TArray<FString> ChangedPaths;
+
+    for (const FString &Path : Paths)
+    {
+        FFileStatData Stat = IFileManager::Get().GetStatData(*Path);
+        const FFMODBankFileInfo *Cached = Files.Find(Path);
+
+        if (Cached && Stat.bIsValid && Cached->Size == Stat.FileSize && Cached->Timestamp == Stat.ModificationTime)
+        {
+            FileInfos.Add(Path, *Cached);
+        }
+        else
+        {
+            FFMODBankFileInfo &Info = FileInfos.Add(Path);
+            Info.Size = Stat.FileSize;
+            Info.Timestamp = Stat.ModificationTime;
+            ChangedPaths.Add(Path);
+        }
+    }
+
+    NumRead = ChangedPaths.Num();
+    if (ChangedPaths.Num() > 0)
+    {
+        UE_LOG(LogFMOD, Log, TEXT("Reading GUIDs of %d changed bank files (%d cached)"), ChangedPaths.Num(), Paths.Num() - ChangedPaths.Num());
+        ReadGuids(ChangedPaths, FileInfos);
+    }
+
+    for (const FString &Path : ChangedPaths)
+    {
+        if (!FileInfos.FindChecked(Path).Guid.IsValid())
+        {
+            UE_LOG(LogFMOD, Error, TEXT("Failed to register disk file for bank: %s"), *Path);
+            FileInfos.Remove(Path);
+        }
+    }
+
+    // Record what changed since the last update so that loaded banks can be updated selectively
+    ChangedFiles.Reset();
+    for (const TMap<FString, FFMODBankFileInfo>::ElementType &Entry : FileInfos)
+    {
+        const FFMODBankFileInfo *Previous = Files.Find(Entry.Key);
+        if (!Previous || Previous->Size != Entry.Value.Size || Previous->Timestamp != Entry.Value.Timestamp)
+        {
+            ChangedFiles.Add(Entry.Key);
+        }
+    }
+    for (const TMap<FString, FFMODBankFileInfo>::ElementType &Entry : Files)
+    {
+        if (!FileInfos.Contains(Entry.Key))
+        {
+            ChangedFiles.Add(Entry.Key);
+        }
+    }
+
+    bool bCacheChanged = ChangedPaths.Num() > 0 || FileInfos.Num() != Files.Num();
+    Files = MoveTemp(FileInfos);
+
+    if (bCacheChanged)
+    {
+        Save();
+    }
+}
+
+void FFMODBankFileCache::Load()
+{
+    Files.Reset();
+
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*CachePath, FILEREAD_Silent));
+    if (!Reader)
+    {
+        return;
+    }
+
+    int32 Version = 0;
+    int32 Count = 0;
+    *Reader << Version;
+    *Reader << Count;
+
+    if (Version != BANK_FILE_CACHE_VERSION || Count < 0)
+    {
+        return;
+    }
+
+    for (int32 i = 0; i < Count && !Reader->IsError(); ++i)
+    {
+        FString Path;
+        FFMODBankFileInfo Info;
+        *Reader << Path;
+        *Reader << Info.Size;
+        *Reader << Info.Timestamp;
+        *Reader << Info.Guid;
+        Files.Add(Path, Info);
+    }
+
+    if (Reader->IsError())
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Ignoring corrupt bank file cache: %s"), *CachePath);
+        Files.Reset();
+    }
+}
+
+void FFMODBankFileCache::Save() const
+{
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*CachePath, FILEWRITE_Silent));
+    if (!Writer)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Could not write bank file cache: %s"), *CachePath);
+        return;
+    }
+
+    int32 Version = BANK_FILE_CACHE_VERSION;
+    int32 Count = Files.Num();
+    *Writer << Version;
+    *Writer << Count;
+
+    for (const TMap<FString, FFMODBankFileInfo>::ElementType &Entry : Files)
+    {
+        FString Path = Entry.Key;
+        FFMODBankFileInfo Info = Entry.Value;
+        *Writer << Path;
+        *Writer << Info.Size;
+        *Writer << Info.Timestamp;
+        *Writer << Info.Guid;
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+/** What is known about a bank file on disk */
+struct FFMODBankFileInfo
+{
+    FFMODBankFileInfo()
+        : Size(0)
+    {
+    }
+
+    int64 Size;
+    FDateTime Timestamp;
+    FGuid Guid;
+};
+
+/**
+ * GUIDs of the bank files on disk, persisted between sessions so that only files whose size or timestamp
+ * changed have to be read again.
+ */
+class FFMODBankFileCache
+{
+public:
+    /** Fill in the GUIDs of the given files, leaving the GUID invalid for any that can't be read */
+    typedef TFunctionRef<void(const TArray<FString> &Paths, TMap<FString, FFMODBankFileInfo> &FileInfos)> FReadGuids;
+
+    FFMODBankFileCache(const FString &InCachePath)
+        : CachePath(InCachePath)
+        , bLoaded(false)
+        , NumRead(0)
+    {
+    }
+
+    /** Bring the cache up to date with the given bank files, reading the GUIDs of changed files only */
+    void Update(const TArray<FString> &Paths, FReadGuids ReadGuids);
+
+    /** Files with a known GUID after the last update */
+    const TMap<FString, FFMODBankFileInfo> &GetFiles() const { return Files; }
+
+    /** Full paths of the bank files that were added, modified or removed by the last update */
+    const TSet<FString> &GetChangedFiles() const { return ChangedFiles; }
+
+    /** Number of files whose GUIDs had to be read by the last update */
+    int32 GetNumRead() const { return NumRead; }
+
+private:
+    void Load();
+    void Save() const;
+
+    FString CachePath;
+    bool bLoaded;
+    int32 NumRead;
+
+    TMap<FString, FFMODBankFileInfo> Files;
+    TSet<FString> ChangedFiles;
+};
@@ -0,0 +1,303 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODBankLoader.h"
+#include "FMODProgrammerSoundCache.h"
+#include "FMODSettings.h"
+#include "FMODStudioCalls.h"
+#include "FMODUtils.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "fmod_studio.hpp"
+#include "fmod_errors.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+FFMODBankLoader::FFMODBankLoader()
+    : System(nullptr)
+    , NumLoading(0)
+    , NumRequested(0)
+    , NumFinished(0)
+{
+}
+
+void FFMODBankLoader::Reset(FMOD::Studio::System *InSystem)
+{
+    // Banks belong to the old system, which unloads them when it is released
+    System = InSystem;
+    Banks.Reset();
+    Queue.Reset();
+    MapBanks.Reset();
+    SampleDataLastUsed.Reset();
+    NumLoading = 0;
+    NumRequested = 0;
+    NumFinished = 0;
+}
+
+void FFMODBankLoader::RequestBank(const FString &Path, int32 Priority, bool bLoadSampleData)
+{
+    if (System == nullptr)
+    {
+        return;
+    }
+
+    FBankRequest *Request = Banks.Find(Path);
+    if (!Request)
+    {
+        Request = &Banks.Add(Path);
+        Request->Priority = Priority;
+        Request->bLoadSampleData = bLoadSampleData;
+        Queue.Add(Path);
+        SortQueue();
+        ++NumRequested;
+    }
+    else
+    {
+        // A failed load is tried again when the bank is next requested, e.g. once the file has been downloaded
+        const bool bRetry = Request->State == Failed;
+        if (bRetry)
+        {
+            Request->State = Queued;
+            Queue.Add(Path);
+            ++NumRequested;
+        }
+        if (Request->State == Queued && (bRetry || Priority > Request->Priority))
+        {
+            Request->Priority = FMath::Max(Request->Priority, Priority);
+            SortQueue();
+        }
+        if (bLoadSampleData && !Request->bLoadSampleData)
+        {
+            Request->bLoadSampleData = true;
+            if (Request->State == Loaded)
+            {
+                verifyfmod(IFMODStudioModule::Get().GetStudioCalls().LoadSampleData(Request->Bank));
+            }
+        }
+    }
+    ++Request->RefCount;
+}
+
+void FFMODBankLoader::ReleaseBank(const FString &Path)
+{
+    FBankRequest *Request = Banks.Find(Path);
+    if (!Request || --Request->RefCount > 0)
+    {
+        return;
+    }
+
+    if (Request->State == Queued)
+    {
+        Queue.Remove(Path);
+        --NumRequested;
+    }
+    else if (Request->State == Loading)
+    {
+        --NumLoading;
+        --NumRequested;
+    }
+
+    if (Request->Bank)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Unloading bank: %s"), *Path);
+        IFMODStudioModule::Get().GetProgrammerSoundCache().ReleaseAudioTableSounds();
+        IFMODStudioModule::Get().GetStudioCalls().Unload(Request->Bank);
+    }
+    Banks.Remove(Path);
+}
+
+void FFMODBankLoader::SetMap(const FString &MapName)
+{
+    if (System == nullptr)
+    {
+        return;
+    }
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    TArray<FString> PreviousBanks = MoveTemp(MapBanks);
+    MapBanks.Reset();
+
+    for (const FFMODMapBankManifest &Manifest : Settings.MapBankManifests)
+    {
+        if (Manifest.Map.GetLongPackageName() != MapName)
+        {
+            continue;
+        }
+
+        for (const FString &Bank : Manifest.Banks)
+        {
+            FString Path = Settings.GetFullBankPath() / Bank;
+            if (FPaths::GetExtension(Path).IsEmpty())
+            {
+                Path += TEXT(".bank");
+            }
+            RequestBank(Path, Manifest.Priority, Manifest.bLoadSampleData);
+            MapBanks.Add(Path);
+        }
+    }
+
+    // Release after requesting so banks shared with the new map stay loaded
+    for (const FString &Path : PreviousBanks)
+    {
+        ReleaseBank(Path);
+    }
+}
+
+void FFMODBankLoader::Update()
+{
+    if (System == nullptr)
+    {
+        return;
+    }
+
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    bool bProgressed = false;
+
+    if (NumLoading > 0)
+    {
+        for (TMap<FString, FBankRequest>::ElementType &Entry : Banks)
+        {
+            FBankRequest &Request = Entry.Value;
+            if (Request.State != Loading)
+            {
+                continue;
+            }
+
+            FMOD_STUDIO_LOADING_STATE LoadingState = FMOD_STUDIO_LOADING_STATE_ERROR;
+            FMOD_RESULT Result = Calls.GetLoadingState(Request.Bank, &LoadingState);
+            if (LoadingState == FMOD_STUDIO_LOADING_STATE_LOADING)
+            {
+                continue;
+            }
+
+            --NumLoading;
+            bProgressed = true;
+
+            if (Result == FMOD_OK && LoadingState == FMOD_STUDIO_LOADING_STATE_LOADED)
+            {
+                Request.State = Loaded;
+                if (Request.bLoadSampleData)
+                {
+                    verifyfmod(Calls.LoadSampleData(Request.Bank));
+                }
+            }
+            else
+            {
+                UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank: %s (%s)"), *Entry.Key, UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+                Calls.Unload(Request.Bank);
+                Request.Bank = nullptr;
+                Request.State = Failed;
+            }
+            ++NumFinished;
+        }
+    }
+
+    // Limit the loads in flight so high priority banks requested later don't wait behind everything else
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    while (Queue.Num() > 0 && NumLoading < Settings.BankLoadsPerFrame)
+    {
+        const FString Path = Queue[0];
+        Queue.RemoveAt(0);
+
+        FBankRequest &Request = Banks.FindChecked(Path);
+        UE_LOG(LogFMOD, Log, TEXT("Loading bank: %s"), *Path);
+        FMOD_RESULT Result = Calls.LoadBankFile(System, TCHAR_TO_UTF8(*Path), FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &Request.Bank);
+
+        if (Result == FMOD_OK)
+        {
+            Request.State = Loading;
+            ++NumLoading;
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank: %s (%s)"), *Path, UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+            Request.Bank = nullptr;
+            Request.State = Failed;
+            ++NumFinished;
+            bProgressed = true;
+        }
+    }
+
+    if (bProgressed)
+    {
+        ProgressDelegate.Broadcast(NumFinished, NumRequested);
+        if (NumPending() == 0)
+        {
+            NumRequested = 0;
+            NumFinished = 0;
+        }
+    }
+
+    EvictSampleData();
+}
+
+void FFMODBankLoader::TouchEvent(FMOD::Studio::EventDescription *EventDesc)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (System == nullptr || Settings.TotalMemoryBudgetForSampleData <= 0)
+    {
+        return;
+    }
+
+    double *LastUsed = SampleDataLastUsed.Find(EventDesc);
+    if (!LastUsed)
+    {
+        // This is in addition to the reference held by the event's instances, so the data outlives them
+        if (EventDesc->loadSampleData() != FMOD_OK)
+        {
+            return;
+        }
+        LastUsed = &SampleDataLastUsed.Add(EventDesc);
+    }
+    *LastUsed = FApp::GetCurrentTime();
+}
+
+void FFMODBankLoader::SortQueue()
+{
+    Queue.StableSort([this](const FString &A, const FString &B) { return Banks.FindChecked(A).Priority > Banks.FindChecked(B).Priority; });
+}
+
+void FFMODBankLoader::EvictSampleData()
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (SampleDataLastUsed.Num() == 0 || Settings.TotalMemoryBudgetForSampleData <= 0)
+    {
+        return;
+    }
+
+    // FMOD only reports sample data memory separately in logging builds, so the budget is for everything FMOD allocates
+    int CurrentAlloc = 0;
+    int MaxAlloc = 0;
+    FMOD::Memory_GetStats(&CurrentAlloc, &MaxAlloc, false);
+    if (int64(CurrentAlloc) <= int64(Settings.TotalMemoryBudgetForSampleData) * 1024 * 1024)
+    {
+        return;
+    }
+
+    // Sample data unloads asynchronously, so only evict one event per frame to avoid evicting more than needed
+    FMOD::Studio::EventDescription *Oldest = nullptr;
+    double OldestTime = DBL_MAX;
+    for (auto It = SampleDataLastUsed.CreateIterator(); It; ++It)
+    {
+        FMOD::Studio::EventDescription *EventDesc = It.Key();
+        if (!EventDesc->isValid())
+        {
+            // Its bank was unloaded
+            It.RemoveCurrent();
+            continue;
+        }
+
+        int InstanceCount = 0;
+        EventDesc->getInstanceCount(&InstanceCount);
+        if (InstanceCount == 0 && It.Value() < OldestTime)
+        {
+            Oldest = EventDesc;
+            OldestTime = It.Value();
+        }
+    }
+
+    if (Oldest)
+    {
+        Oldest->unloadSampleData();
+        SampleDataLastUsed.Remove(Oldest);
+    }
+}
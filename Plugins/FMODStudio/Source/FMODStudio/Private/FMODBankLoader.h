@@ -0,0 +1,99 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FMODStudioModule.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class Bank;
+class EventDescription;
+class System;
+}
+}
+
+/**
+ * Loads runtime banks over several frames in priority order, instead of queuing them all and blocking until they have loaded.
+ * Bank requests are reference counted so banks shared by several maps stay loaded across level travel. Also keeps the sample
+ * data of recently played events loaded, evicting the least recently used once FMOD's total memory use exceeds the budget.
+ */
+class FFMODBankLoader
+{
+public:
+    FFMODBankLoader();
+
+    /** Forget all requests and start loading banks into the given system, which may be null */
+    void Reset(FMOD::Studio::System *InSystem);
+
+    /** Request a bank file, raising its priority if it is still queued */
+    void RequestBank(const FString &Path, int32 Priority, bool bLoadSampleData);
+
+    /** Release a request, unloading the bank once nothing needs it */
+    void ReleaseBank(const FString &Path);
+
+    /** Request the banks listed in the settings for a map, releasing those of the previous map */
+    void SetMap(const FString &MapName);
+
+    /** Check loads in flight, issue queued loads and enforce the sample data budget */
+    void Update();
+
+    /** Note that an event is being played, so that its sample data is kept loaded while the budget allows */
+    void TouchEvent(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Number of requested banks that have not finished loading */
+    int32 NumPending() const { return Queue.Num() + NumLoading; }
+
+    FFMODBankLoadProgress &OnProgress() { return ProgressDelegate; }
+
+private:
+    enum EBankState
+    {
+        Queued,
+        Loading,
+        Loaded,
+        Failed
+    };
+
+    struct FBankRequest
+    {
+        FBankRequest()
+            : Bank(nullptr)
+            , RefCount(0)
+            , Priority(0)
+            , bLoadSampleData(false)
+            , State(Queued)
+        {
+        }
+
+        FMOD::Studio::Bank *Bank;
+        int32 RefCount;
+        int32 Priority;
+        bool bLoadSampleData;
+        EBankState State;
+    };
+
+    void SortQueue();
+    void EvictSampleData();
+
+    FMOD::Studio::System *System;
+
+    TMap<FString, FBankRequest> Banks;
+
+    /** Paths of banks waiting to be loaded, highest priority first */
+    TArray<FString> Queue;
+    int32 NumLoading;
+
+    /** Banks requested for the current map */
+    TArray<FString> MapBanks;
+
+    /** Progress since the loader was last idle */
+    int32 NumRequested;
+    int32 NumFinished;
+    FFMODBankLoadProgress ProgressDelegate;
+
+    /** Time each event with retained sample data was last played */
+    TMap<FMOD::Studio::EventDescription *, double> SampleDataLastUsed;
+};
@@ -1,35 +1,72 @@
 // Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
 
 #include "FMODBankUpdateNotifier.h"
-#include "FMODSettings.h"
-#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
 
 #include "FMODStudioPrivatePCH.h"
 
+/** Seconds without further bank writes before a notification is sent */
+static const double BANK_UPDATE_SETTLE_TIME = 1.0;
+
 FFMODBankUpdateNotifier::FFMODBankUpdateNotifier()
     : bUpdateEnabled(true)
-    , NextRefreshTime(FDateTime::MinValue())
+    , LastChangeTime(0.0)
 {
 }
 
-void FFMODBankUpdateNotifier::SetFilePath(const FString &InPath)
+FFMODBankUpdateNotifier::~FFMODBankUpdateNotifier()
 {
-    FilePath = InPath;
-    NextRefreshTime = FDateTime::MinValue();
-    FileTime = FDateTime::MinValue();
+    StopWatching();
 }
 
-void FFMODBankUpdateNotifier::Update()
+void FFMODBankUpdateNotifier::SetBankDirectory(const FString &InDirectory)
 {
-    if (bUpdateEnabled)
+    FString NewDirectory = FPaths::ConvertRelativePathToFull(InDirectory);
+    if (NewDirectory == Directory && WatcherHandle.IsValid())
+    {
+        return;
+    }
+
+    StopWatching();
+    Directory = NewDirectory;
+    PendingFiles.Reset();
+
+#if WITH_EDITOR
+    if (InDirectory.IsEmpty())
     {
-        FDateTime CurTime = FDateTime::UtcNow();
-        if (CurTime >= NextRefreshTime)
+        return;
+    }
+
+    FDirectoryWatcherModule &DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    IDirectoryWatcher *DirectoryWatcher = DirectoryWatcherModule.Get();
+    if (DirectoryWatcher)
+    {
+        if (!DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory,
+                IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FFMODBankUpdateNotifier::HandleDirectoryChanged), WatcherHandle))
         {
-            NextRefreshTime = CurTime + FTimespan(0, 0, 1);
-            Refresh();
+            UE_LOG(LogFMOD, Warning, TEXT("Unable to watch bank directory for changes: %s"), *Directory);
+            WatcherHandle.Reset();
         }
     }
+#endif
+}
+
+void FFMODBankUpdateNotifier::Update()
+{
+    if (bUpdateEnabled && PendingFiles.Num() > 0 && FPlatformTime::Seconds() - LastChangeTime >= BANK_UPDATE_SETTLE_TIME)
+    {
+        UE_LOG(LogFMOD, Log, TEXT("%d bank files have changed in %s"), PendingFiles.Num(), *Directory);
+
+        TSet<FString> ChangedFiles = MoveTemp(PendingFiles);
+        PendingFiles.Reset();
+        BanksUpdatedEvent.Broadcast(ChangedFiles);
+    }
 }
 
 void FFMODBankUpdateNotifier::EnableUpdate(bool bEnable)
@@ -39,21 +76,37 @@ void FFMODBankUpdateNotifier::EnableUpdate(bool bEnable)
     if (bEnable)
     {
         // Refreshing right after update is enabled is not desirable
-        NextRefreshTime = FDateTime::UtcNow() + FTimespan(0, 0, 1);
+        LastChangeTime = FPlatformTime::Seconds();
     }
 }
 
-void FFMODBankUpdateNotifier::Refresh()
+void FFMODBankUpdateNotifier::HandleDirectoryChanged(const TArray<FFileChangeData> &FileChanges)
 {
-    if (!FilePath.IsEmpty())
+#if WITH_EDITOR
+    for (const FFileChangeData &Change : FileChanges)
     {
-        const FDateTime NewFileTime = IFileManager::Get().GetTimeStamp(*FilePath);
-        if (NewFileTime != FileTime)
+        if (FPaths::GetExtension(Change.Filename) == TEXT("bank"))
         {
-            FileTime = NewFileTime;
-            UE_LOG(LogFMOD, Log, TEXT("File has changed: %s"), *FilePath);
+            PendingFiles.Add(FPaths::ConvertRelativePathToFull(Change.Filename));
+            LastChangeTime = FPlatformTime::Seconds();
+        }
+    }
+#endif
+}
 
-            BanksUpdatedEvent.Broadcast();
+void FFMODBankUpdateNotifier::StopWatching()
+{
+#if WITH_EDITOR
+    if (WatcherHandle.IsValid())
+    {
+        // The watcher may already have been unloaded during shutdown
+        FDirectoryWatcherModule *DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+        IDirectoryWatcher *DirectoryWatcher = DirectoryWatcherModule ? DirectoryWatcherModule->Get() : nullptr;
+        if (DirectoryWatcher)
+        {
+            DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Directory, WatcherHandle);
         }
+        WatcherHandle.Reset();
     }
+#endif
 }
@@ -2,27 +2,42 @@
 
 #pragma once
 
+#include "Containers/Set.h"
 #include "Containers/UnrealString.h"
-#include "Misc/DateTime.h"
 #include "Delegates/Delegate.h"
+#include "Delegates/IDelegateInstance.h"
 
+struct FFileChangeData;
+
+/** Full paths of the bank files written since the last notification */
+DECLARE_MULTICAST_DELEGATE_OneParam(FFMODBanksUpdated, const TSet<FString> &);
+
+/**
+ * Watches the bank directory for bank files written by FMOD Studio. Changes are collected until none have arrived for a short
+ * while, so that one Studio build, which writes many banks, sends a single notification.
+ */
 class FFMODBankUpdateNotifier
 {
 public:
     FFMODBankUpdateNotifier();
+    ~FFMODBankUpdateNotifier();
 
-    void SetFilePath(const FString &InPath);
+    void SetBankDirectory(const FString &InDirectory);
     void Update();
 
+    /** Hold notifications while disabled, changes made in the meantime are sent once it is enabled again */
     void EnableUpdate(bool bEnable);
 
-    FSimpleMulticastDelegate BanksUpdatedEvent;
+    FFMODBanksUpdated BanksUpdatedEvent;
 
 private:
-    void Refresh();
+    void HandleDirectoryChanged(const TArray<FFileChangeData> &FileChanges);
+    void StopWatching();
 
     bool bUpdateEnabled;
-    FString FilePath;
-    FDateTime NextRefreshTime;
-    FDateTime FileTime;
+    FString Directory;
+    FDelegateHandle WatcherHandle;
+
+    TSet<FString> PendingFiles;
+    double LastChangeTime;
 };
@@ -9,6 +9,11 @@
 #include "FMODEvent.h"
 #include "FMODBus.h"
 #include "FMODVCA.h"
+#include "FMODEventPool.h"
+#include "FMODBankLoader.h"
+#include "FMODHandleCache.h"
+#include "FMODStudioCalls.h"
+#include "FMODProgrammerSoundCache.h"
 #include "fmod_studio.hpp"
 #include "fmod_errors.h"
 #include "FMODStudioPrivatePCH.h"
@@ -38,6 +43,8 @@ FFMODEventInstance UFMODBlueprintStatics::PlayEventAtLocation(
         FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
         if (EventDesc != nullptr)
         {
+            IFMODStudioModule::Get().GetBankLoader().TouchEvent(EventDesc);
+
             FMOD::Studio::EventInstance *EventInst = nullptr;
             EventDesc->createInstance(&EventInst);
             if (EventInst != nullptr)
@@ -58,6 +65,46 @@ FFMODEventInstance UFMODBlueprintStatics::PlayEventAtLocation(
     return Instance;
 }
 
+void UFMODBlueprintStatics::PlayOneShot2D(UObject *WorldContextObject, class UFMODEvent *Event)
+{
+    PlayOneShotAtLocation(WorldContextObject, Event, FTransform());
+}
+
+void UFMODBlueprintStatics::PlayOneShotAtLocation(UObject *WorldContextObject, class UFMODEvent *Event, const FTransform &Location)
+{
+    UWorld *ThisWorld = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+    if (!FMODUtils::IsWorldAudible(ThisWorld, false) || !IsValid(Event))
+    {
+        return;
+    }
+
+    FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
+    if (EventDesc == nullptr)
+    {
+        return;
+    }
+    IFMODStudioModule::Get().GetBankLoader().TouchEvent(EventDesc);
+
+    // Pooled instances are kept alive for reuse instead of being released
+    FMOD::Studio::EventInstance *EventInst = IFMODStudioModule::Get().GetEventPool().AcquireInstance(EventDesc);
+    const bool bPooled = EventInst != nullptr;
+    if (!bPooled)
+    {
+        EventDesc->createInstance(&EventInst);
+    }
+    if (EventInst != nullptr)
+    {
+        FMOD_3D_ATTRIBUTES EventAttr = { { 0 } };
+        FMODUtils::Assign(EventAttr, Location);
+        EventInst->set3DAttributes(&EventAttr);
+        EventInst->start();
+        if (!bPooled)
+        {
+            EventInst->release();
+        }
+    }
+}
+
 class UFMODAudioComponent *UFMODBlueprintStatics::PlayEventAttached(class UFMODEvent *Event, class USceneComponent *AttachToComponent,
     FName AttachPointName, FVector Location, EAttachLocation::Type LocationType, bool bStopWhenAttachedToDestroyed, bool bAutoPlay, bool bAutoDestroy)
 {
@@ -117,6 +164,46 @@ class UFMODAudioComponent *UFMODBlueprintStatics::PlayEventAttached(class UFMODE
     return AudioComponent;
 }
 
+UFMODAudioComponent *UFMODBlueprintStatics::PlayEventAttachedOneShot(UFMODEvent *Event, USceneComponent *AttachToComponent, FName AttachPointName)
+{
+    if (Event == nullptr || AttachToComponent == nullptr)
+    {
+        return nullptr;
+    }
+
+    FFMODEventPool &Pool = IFMODStudioModule::Get().GetEventPool();
+    AActor *Actor = AttachToComponent->GetOwner();
+    UFMODAudioComponent *AudioComponent = Actor ? Pool.AcquireComponent(Actor) : nullptr;
+    if (AudioComponent)
+    {
+        // Start like a new component, without the parameters and properties set on the last one-shot
+        AudioComponent->ParameterCache.Empty();
+        AudioComponent->bDefaultParameterValuesCached = false;
+        for (float &Property : AudioComponent->StoredProperties)
+        {
+            Property = -1.0f;
+        }
+        AudioComponent->SetEvent(Event);
+        AudioComponent->AttachToComponent(AttachToComponent, FAttachmentTransformRules::KeepRelativeTransform, AttachPointName);
+        AudioComponent->SetRelativeLocation(FVector::ZeroVector);
+        AudioComponent->Play();
+        return AudioComponent;
+    }
+
+    AudioComponent =
+        PlayEventAttached(Event, AttachToComponent, AttachPointName, FVector::ZeroVector, EAttachLocation::KeepRelativeOffset, false, false, true);
+    if (AudioComponent)
+    {
+        // Pooled components stay around after they finish so the next one-shot can reuse them
+        if (Pool.AddComponent(AudioComponent))
+        {
+            AudioComponent->bAutoDestroy = false;
+        }
+        AudioComponent->Play();
+    }
+    return AudioComponent;
+}
+
 UFMODAsset *UFMODBlueprintStatics::FindAssetByName(const FString &Name)
 {
     return IFMODStudioModule::Get().FindAssetByName(Name);
@@ -163,6 +250,8 @@ void UFMODBlueprintStatics::UnloadBank(class UFMODBank *Bank)
         FMOD_RESULT result = StudioSystem->getBankByID(&guid, &bank);
         if (result == FMOD_OK && bank != nullptr)
         {
+            // Cached programmer sounds may point into an audio table in this bank
+            IFMODStudioModule::Get().GetProgrammerSoundCache().ReleaseAudioTableSounds();
             bank->unload();
         }
     }
@@ -242,57 +331,78 @@ void UFMODBlueprintStatics::UnloadEventSampleData(UObject *WorldContextObject, c
     }
 }
 
+bool UFMODBlueprintStatics::LoadProgrammerSound(const FString &Name)
+{
+    return IFMODStudioModule::Get().GetProgrammerSoundCache().LoadSound(Name);
+}
+
+void UFMODBlueprintStatics::UnloadProgrammerSound(const FString &Name)
+{
+    IFMODStudioModule::Get().GetProgrammerSoundCache().UnloadSound(Name);
+}
+
 TArray<FFMODEventInstance> UFMODBlueprintStatics::FindEventInstances(UObject *WorldContextObject, UFMODEvent *Event)
 {
     TArray<FFMODEventInstance> Instances;
-    if (IsValid(Event))
+    GetEventInstances(Event, Instances);
+    return Instances;
+}
+
+int32 UFMODBlueprintStatics::GetEventInstances(UFMODEvent *Event, TArray<FFMODEventInstance> &OutInstances)
+{
+    OutInstances.Reset();
+    if (!IsValid(Event))
     {
-        FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
-        if (EventDesc != nullptr)
+        return 0;
+    }
+
+    FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
+    if (EventDesc == nullptr)
+    {
+        return 0;
+    }
+
+    int Capacity = 0;
+    EventDesc->getInstanceCount(&Capacity);
+    if (Capacity > 0)
+    {
+        TArray<FMOD::Studio::EventInstance *, TInlineAllocator<64>> InstancePointers;
+        InstancePointers.SetNumUninitialized(Capacity);
+        int Count = 0;
+        EventDesc->getInstanceList(InstancePointers.GetData(), Capacity, &Count);
+        const FFMODEventPool &Pool = IFMODStudioModule::Get().GetEventPool();
+        OutInstances.Reserve(Count);
+        for (int i = 0; i < Count; ++i)
         {
-            int Capacity = 0;
-            EventDesc->getInstanceCount(&Capacity);
-            if (Capacity > 0)
+            // The pool may restart its instances for another one-shot at any time, so they aren't handed out
+            if (!Pool.OwnsInstance(EventDesc, InstancePointers[i]))
             {
-                TArray<FMOD::Studio::EventInstance *> InstancePointers;
-                InstancePointers.SetNum(Capacity, true);
-                int Count = 0;
-                EventDesc->getInstanceList(InstancePointers.GetData(), Capacity, &Count);
-                Instances.SetNum(Count, true);
-                for (int i = 0; i < Count; ++i)
-                {
-                    Instances[i].Instance = InstancePointers[i];
-                }
+                OutInstances[OutInstances.AddUninitialized()].Instance = InstancePointers[i];
             }
         }
     }
-    return Instances;
+    return OutInstances.Num();
 }
 
 void UFMODBlueprintStatics::BusSetVolume(class UFMODBus *Bus, float Volume)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    if (IsValid(Bus))
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
+        IFMODStudioModule &Module = IFMODStudioModule::Get();
+        FMOD::Studio::Bus *bus = Module.GetHandleCache().GetBus(Bus->AssetGuid);
+        if (bus != nullptr)
         {
-            bus->setVolume(Volume);
+            Module.GetStudioCalls().SetVolume(bus, Volume);
         }
     }
 }
 
 void UFMODBlueprintStatics::BusSetPaused(class UFMODBus *Bus, bool bPaused)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    if (IsValid(Bus))
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
+        FMOD::Studio::Bus *bus = IFMODStudioModule::Get().GetHandleCache().GetBus(Bus->AssetGuid);
+        if (bus != nullptr)
         {
             bus->setPaused(bPaused);
         }
@@ -301,13 +411,10 @@ void UFMODBlueprintStatics::BusSetPaused(class UFMODBus *Bus, bool bPaused)
 
 void UFMODBlueprintStatics::BusSetMute(class UFMODBus *Bus, bool bMute)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    if (IsValid(Bus))
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
+        FMOD::Studio::Bus *bus = IFMODStudioModule::Get().GetHandleCache().GetBus(Bus->AssetGuid);
+        if (bus != nullptr)
         {
             bus->setMute(bMute);
         }
@@ -316,13 +423,10 @@ void UFMODBlueprintStatics::BusSetMute(class UFMODBus *Bus, bool bMute)
 
 void UFMODBlueprintStatics::BusStopAllEvents(UFMODBus *Bus, EFMOD_STUDIO_STOP_MODE stopMode)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Bus))
+    if (IsValid(Bus))
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Bus->AssetGuid);
-        FMOD::Studio::Bus *bus = nullptr;
-        FMOD_RESULT result = StudioSystem->getBusByID(&guid, &bus);
-        if (result == FMOD_OK && bus != nullptr)
+        FMOD::Studio::Bus *bus = IFMODStudioModule::Get().GetHandleCache().GetBus(Bus->AssetGuid);
+        if (bus != nullptr)
         {
             bus->stopAllEvents((FMOD_STUDIO_STOP_MODE)stopMode);
         }
@@ -331,25 +435,38 @@ void UFMODBlueprintStatics::BusStopAllEvents(UFMODBus *Bus, EFMOD_STUDIO_STOP_MO
 
 void UFMODBlueprintStatics::VCASetVolume(class UFMODVCA *Vca, float Volume)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
-    if (StudioSystem != nullptr && IsValid(Vca))
+    if (IsValid(Vca))
     {
-        FMOD::Studio::ID guid = FMODUtils::ConvertGuid(Vca->AssetGuid);
-        FMOD::Studio::VCA *vca = nullptr;
-        FMOD_RESULT result = StudioSystem->getVCAByID(&guid, &vca);
-        if (result == FMOD_OK && vca != nullptr)
+        IFMODStudioModule &Module = IFMODStudioModule::Get();
+        FMOD::Studio::VCA *vca = Module.GetHandleCache().GetVCA(Vca->AssetGuid);
+        if (vca != nullptr)
         {
-            vca->setVolume(Volume);
+            Module.GetStudioCalls().SetVolume(vca, Volume);
         }
     }
 }
 
 void UFMODBlueprintStatics::SetGlobalParameterByName(FName Name, float Value)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
+    // The handle cache holds the runtime system
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODHandleCache &HandleCache = Module.GetHandleCache();
+    FMOD::Studio::System *StudioSystem = HandleCache.GetSystem();
     if (StudioSystem != nullptr)
     {
-        FMOD_RESULT Result = StudioSystem->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
+        FFMODStudioCalls &Calls = Module.GetStudioCalls();
+        FMOD_STUDIO_PARAMETER_ID ParameterID;
+        FMOD_RESULT Result = FMOD_ERR_INVALID_PARAM;
+        if (HandleCache.GetGlobalParameterID(Name, ParameterID))
+        {
+            Result = Calls.SetParameterByID(StudioSystem, ParameterID, Value);
+            if (Result != FMOD_OK)
+            {
+                // The ID may belong to a bank that has since been unloaded, try the name once more
+                HandleCache.InvalidateGlobalParameter(Name);
+                Result = Calls.SetParameterByName(StudioSystem, TCHAR_TO_UTF8(*Name.ToString()), Value);
+            }
+        }
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Name.ToString());
@@ -359,25 +476,31 @@ void UFMODBlueprintStatics::SetGlobalParameterByName(FName Name, float Value)
 
 float UFMODBlueprintStatics::GetGlobalParameterByName(FName Name)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
     float Value = 0.0f;
-    if (StudioSystem != nullptr)
-    {
-        FMOD_RESULT Result = StudioSystem->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
-        if (Result != FMOD_OK)
-        {
-            UE_LOG(LogFMOD, Warning, TEXT("Failed to get event instance parameter %s"), *Name.ToString());
-        }
-    }
+    float FinalValue = 0.0f;
+    GetGlobalParameterValueByName(Name, Value, FinalValue);
     return Value;
 }
 
 void UFMODBlueprintStatics::GetGlobalParameterValueByName(FName Name, float &UserValue, float &FinalValue)
 {
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODHandleCache &HandleCache = Module.GetHandleCache();
+    FMOD::Studio::System *StudioSystem = HandleCache.GetSystem();
     if (StudioSystem != nullptr)
     {
-        FMOD_RESULT Result = StudioSystem->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
+        FFMODStudioCalls &Calls = Module.GetStudioCalls();
+        FMOD_STUDIO_PARAMETER_ID ParameterID;
+        FMOD_RESULT Result = FMOD_ERR_INVALID_PARAM;
+        if (HandleCache.GetGlobalParameterID(Name, ParameterID))
+        {
+            Result = Calls.GetParameterByID(StudioSystem, ParameterID, &UserValue, &FinalValue);
+            if (Result != FMOD_OK)
+            {
+                HandleCache.InvalidateGlobalParameter(Name);
+                Result = Calls.GetParameterByName(StudioSystem, TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
+            }
+        }
         if (Result != FMOD_OK)
         {
             UserValue = FinalValue = 0.0f;
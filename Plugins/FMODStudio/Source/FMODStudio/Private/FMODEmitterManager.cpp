@@ -0,0 +1,215 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODEmitterManager.h"
+#include "FMODAudioComponent.h"
+#include "FMODListener.h"
+#include "FMODSettings.h"
+#include "FMODStudioCalls.h"
+#include "Engine/World.h"
+#include "fmod_studio.hpp"
+
+#include "FMODStudioPrivatePCH.h"
+
+FFMODEmitterManager::FFMODEmitterManager(const FFMODListener *InListeners, const int &InListenerCount, FFMODAudioVolumeCache &InAudioVolumeCache)
+    : Listeners(InListeners)
+    , ListenerCount(InListenerCount)
+    , AudioVolumeCache(InAudioVolumeCache)
+    , VirtualCount(0)
+    , ListenerUpdateCount(0)
+{
+}
+
+void FFMODEmitterManager::Register(UFMODAudioComponent *Component, FMOD::Studio::EventInstance *Instance, float VirtualDistance)
+{
+    if (Component->EmitterIndex != INDEX_NONE)
+    {
+        const int32 Index = Component->EmitterIndex;
+        VirtualCount += (Instance == nullptr) - (Instances[Index] == nullptr);
+        Instances[Index] = Instance;
+        VirtualDistances[Index] = VirtualDistance;
+        return;
+    }
+
+    Component->EmitterIndex = Components.Add(Component);
+    Instances.Add(Instance);
+    AActor *Owner = Component->GetOwner();
+    Positions.Add(Owner ? Owner->GetTransform().GetTranslation() : Component->GetComponentLocation());
+    NearestListeners.Add(INDEX_NONE);
+    AudioVolumes.AddDefaulted();
+    VirtualDistances.Add(VirtualDistance);
+    PositionsChanged.Add(true);
+    VirtualCount += (Instance == nullptr);
+}
+
+void FFMODEmitterManager::Unregister(UFMODAudioComponent *Component)
+{
+    if (Component->EmitterIndex != INDEX_NONE)
+    {
+        RemoveAt(Component->EmitterIndex);
+        Component->EmitterIndex = INDEX_NONE;
+    }
+}
+
+void FFMODEmitterManager::RemoveAt(int32 Index)
+{
+    VirtualCount -= (Instances[Index] == nullptr);
+    Components.RemoveAtSwap(Index, 1, false);
+    Instances.RemoveAtSwap(Index, 1, false);
+    Positions.RemoveAtSwap(Index, 1, false);
+    NearestListeners.RemoveAtSwap(Index, 1, false);
+    AudioVolumes.RemoveAtSwap(Index, 1, false);
+    VirtualDistances.RemoveAtSwap(Index, 1, false);
+    PositionsChanged.RemoveAtSwap(Index, 1, false);
+
+    // The last emitter was moved into the freed slot
+    if (Index < Components.Num() && Components[Index].IsValid())
+    {
+        Components[Index]->EmitterIndex = Index;
+    }
+}
+
+void FFMODEmitterManager::SetPosition(UFMODAudioComponent *Component, const FVector &Position)
+{
+    if (Component->EmitterIndex != INDEX_NONE)
+    {
+        Positions[Component->EmitterIndex] = Position;
+        NearestListeners[Component->EmitterIndex] = INDEX_NONE;
+        PositionsChanged[Component->EmitterIndex] = true;
+    }
+}
+
+int32 FFMODEmitterManager::FindNearestListener(const FVector &Location) const
+{
+    float BestDistSq = FLT_MAX;
+    int32 BestListener = 0;
+    for (int32 i = 0; i < ListenerCount; ++i)
+    {
+        const float DistSq = FVector::DistSquared(Location, Listeners[i].Transform.GetTranslation());
+        if (DistSq < BestDistSq)
+        {
+            BestListener = i;
+            BestDistSq = DistSq;
+        }
+    }
+    return BestListener;
+}
+
+const FFMODListener &FFMODEmitterManager::GetNearestListener(const UFMODAudioComponent *Component, const FVector &Location) const
+{
+    int32 Index = Component->EmitterIndex;
+    if (Index != INDEX_NONE && NearestListeners[Index] != INDEX_NONE && NearestListeners[Index] < ListenerCount)
+    {
+        return Listeners[NearestListeners[Index]];
+    }
+    return Listeners[FindNearestListener(Location)];
+}
+
+AAudioVolume *FFMODEmitterManager::GetAudioSettings(
+    const UFMODAudioComponent *Component, UWorld *World, const FVector &Location, FInteriorSettings *OutInteriorSettings)
+{
+    if (Component->EmitterIndex != INDEX_NONE)
+    {
+        return AudioVolumeCache.GetAudioSettings(World, Location, AudioVolumes[Component->EmitterIndex], OutInteriorSettings);
+    }
+
+    FFMODAudioVolumeCacheEntry Entry;
+    return AudioVolumeCache.GetAudioSettings(World, Location, Entry, OutInteriorSettings);
+}
+
+void FFMODEmitterManager::Update(bool bListenerMoved)
+{
+    // Components can be destroyed without stopping, e.g. when an editor world is torn down
+    for (int32 Index = Components.Num() - 1; Index >= 0; --Index)
+    {
+        if (!Components[Index].IsValid())
+        {
+            RemoveAt(Index);
+        }
+    }
+
+    const int32 Count = Components.Num();
+
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        if (bListenerMoved || NearestListeners[Index] == INDEX_NONE)
+        {
+            NearestListeners[Index] = FindNearestListener(Positions[Index]);
+        }
+    }
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    const float Hysteresis = Settings.VirtualizationHysteresis;
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+
+    CompletedComponents.Reset();
+    ListenerUpdateCount = 0;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        UFMODAudioComponent *Component = Components[Index].Get();
+        if (!Component->IsActive())
+        {
+            continue;
+        }
+
+        // Components used to do this in their tick, which doesn't run while their world is paused
+        UWorld *World = Component->GetWorld();
+        if (World && World->IsPaused() && !Component->PrimaryComponentTick.bTickEvenWhenPaused)
+        {
+            continue;
+        }
+
+        // Virtualizing only swaps the instance in this slot, so it is safe while iterating
+        const float VirtualDistance = VirtualDistances[Index];
+        if (VirtualDistance > 0.0f && (bListenerMoved || PositionsChanged[Index]))
+        {
+            const float DistSq = FVector::DistSquared(Positions[Index], Listeners[NearestListeners[Index]].Transform.GetTranslation());
+            if (Instances[Index] == nullptr && DistSq <= FMath::Square(VirtualDistance))
+            {
+                if (!Component->Devirtualize())
+                {
+                    CompletedComponents.Add(Component);
+                    continue;
+                }
+            }
+            else if (Instances[Index] != nullptr && DistSq > FMath::Square(VirtualDistance + Hysteresis))
+            {
+                Component->Virtualize();
+            }
+        }
+        PositionsChanged[Index] = false;
+
+        if (Instances[Index] == nullptr)
+        {
+            if (Component->HasVirtualPlaybackFinished())
+            {
+                CompletedComponents.Add(Component);
+            }
+            continue;
+        }
+
+        if (bListenerMoved)
+        {
+            ++ListenerUpdateCount;
+            Component->UpdateInteriorVolumes();
+            Component->UpdateAttenuation();
+            Component->ApplyVolumeLPF();
+        }
+
+        FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+        Calls.GetPlaybackState(Instances[Index], &State);
+        if (State == FMOD_STUDIO_PLAYBACK_STOPPED)
+        {
+            CompletedComponents.Add(Component);
+        }
+    }
+
+    // Completion unregisters the component, so it can't happen while iterating
+    for (const TWeakObjectPtr<UFMODAudioComponent> &Component : CompletedComponents)
+    {
+        // Stopped delegates may have destroyed or restarted other components in the list
+        if (Component.IsValid() && Component->IsActive())
+        {
+            Component->OnPlaybackCompleted();
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "FMODAudioVolumeCache.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class EventInstance;
+}
+}
+
+class UFMODAudioComponent;
+struct FFMODListener;
+
+/**
+ * Updates all playing audio components in a single pass each frame instead of ticking them individually.
+ * Per-emitter state is kept in parallel arrays indexed by UFMODAudioComponent::EmitterIndex.
+ */
+class FFMODEmitterManager
+{
+public:
+    FFMODEmitterManager(const FFMODListener *InListeners, const int &InListenerCount, FFMODAudioVolumeCache &InAudioVolumeCache);
+
+    /**
+     * Start updating a component, or update the instance of one that is already registered. Components with a virtual distance
+     * are virtualized when every listener is further away than that plus the hysteresis margin, and get a new instance once a
+     * listener is back within it. A null instance registers a component that is already virtual.
+     */
+    void Register(UFMODAudioComponent *Component, FMOD::Studio::EventInstance *Instance, float VirtualDistance = 0.0f);
+
+    /** Stop updating a component */
+    void Unregister(UFMODAudioComponent *Component);
+
+    /** Record the location of a registered component, called when its transform changes */
+    void SetPosition(UFMODAudioComponent *Component, const FVector &Position);
+
+    /** Return the listener nearest to a component, using the cached result when there is one */
+    const FFMODListener &GetNearestListener(const UFMODAudioComponent *Component, const FVector &Location) const;
+
+    /** Return the audio volume at a component's location, reusing the last result while the component stays close to it */
+    AAudioVolume *GetAudioSettings(const UFMODAudioComponent *Component, UWorld *World, const FVector &Location, FInteriorSettings *OutInteriorSettings);
+
+    /** Update virtualization, ambient volumes, attenuation and playback state for every registered component */
+    void Update(bool bListenerMoved);
+
+    /** Number of registered components */
+    int32 Num() const { return Components.Num(); }
+
+    /** Number of registered components playing without an instance */
+    int32 NumVirtual() const { return VirtualCount; }
+
+    /** Number of components given the listener dependent update, interior volumes and attenuation, by the last Update */
+    int32 NumListenerUpdates() const { return ListenerUpdateCount; }
+
+private:
+    void RemoveAt(int32 Index);
+    int32 FindNearestListener(const FVector &Location) const;
+
+    const FFMODListener *Listeners;
+    const int &ListenerCount;
+    FFMODAudioVolumeCache &AudioVolumeCache;
+
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> Components;
+    TArray<FMOD::Studio::EventInstance *> Instances;
+    TArray<FVector> Positions;
+    TArray<int32> NearestListeners;
+    TArray<FFMODAudioVolumeCacheEntry> AudioVolumes;
+    TArray<float> VirtualDistances;
+
+    /** Set when a component has moved since its range was last checked */
+    TArray<bool> PositionsChanged;
+
+    int32 VirtualCount;
+    int32 ListenerUpdateCount;
+
+    /** Scratch list of components whose events stopped this frame */
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> CompletedComponents;
+};
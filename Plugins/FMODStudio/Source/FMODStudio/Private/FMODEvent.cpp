@@ -2,6 +2,7 @@
 
 #include "FMODEvent.h"
 #include "FMODStudioModule.h"
+#include "FMODStudioCalls.h"
 #include "fmod_studio.hpp"
 
 UFMODEvent::UFMODEvent(const FObjectInitializer &ObjectInitializer)
@@ -42,17 +43,24 @@ void UFMODEvent::GetParameterDescriptions(TArray<FMOD_STUDIO_PARAMETER_DESCRIPTI
 {
     if (IFMODStudioModule::Get().AreBanksLoaded())
     {
-        FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(this, EFMODSystemContext::Auditioning);
+        const FFMODEventDescriptionInfo *Info = IFMODStudioModule::Get().GetEventDescriptionInfo(this, EFMODSystemContext::Auditioning);
 
-        if (EventDesc)
+        if (Info)
         {
-            int ParameterCount;
-            EventDesc->getParameterDescriptionCount(&ParameterCount);
-            Parameters.SetNumUninitialized(ParameterCount);
-            for (int ParameterIndex = 0; ParameterIndex < ParameterCount; ++ParameterIndex)
-            {
-                EventDesc->getParameterDescriptionByIndex(ParameterIndex, &Parameters[ParameterIndex]);
-            }
+            Parameters = Info->Parameters;
         }
     }
 }
+
+bool UFMODEvent::FindParameterID(const FName &Name, FMOD_STUDIO_PARAMETER_ID &OutID) const
+{
+    // Parameter IDs come from the bank, so they are the same for every Studio system that loaded it
+    const FFMODEventDescriptionInfo *Info = IFMODStudioModule::Get().GetStudioCalls().GetEventDescriptionInfo(this, EFMODSystemContext::Max);
+    const FMOD_STUDIO_PARAMETER_ID *ID = Info ? Info->ParameterIDs.Find(Name) : nullptr;
+    if (ID)
+    {
+        OutID = *ID;
+        return true;
+    }
+    return false;
+}
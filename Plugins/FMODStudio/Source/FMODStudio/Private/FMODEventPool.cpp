@@ -0,0 +1,302 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODEventPool.h"
+#include "FMODAudioComponent.h"
+#include "FMODSettings.h"
+#include "FMODUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/App.h"
+#include "fmod_studio.hpp"
+
+#include "FMODStudioPrivatePCH.h"
+
+// Seconds between checks for idle pooled instances
+static const double IDLE_CHECK_INTERVAL = 1.0;
+
+FMOD::Studio::EventInstance *FFMODEventPool::AcquireInstance(FMOD::Studio::EventDescription *EventDesc)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (Settings.EventInstancePoolSize <= 0)
+    {
+        return nullptr;
+    }
+
+    FMOD_GUID EventID = { 0 };
+    EventDesc->getID(&EventID);
+
+    FInstancePool &Pool = InstancePools.FindOrAdd(EventDesc);
+    if (Pool.bDefaultsCached && FMemory::Memcmp(&Pool.EventID, &EventID, sizeof(EventID)) != 0)
+    {
+        // The description this pool was made for is gone and another one has the same address
+        ReleaseInstances(Pool);
+        Pool = FInstancePool();
+    }
+    if (!Pool.bDefaultsCached)
+    {
+        Pool.EventID = EventID;
+        CacheDefaults(EventDesc, Pool);
+    }
+
+    int32 Index = INDEX_NONE;
+    for (int32 i = Pool.Instances.Num() - 1; i >= 0; --i)
+    {
+        // Instances become invalid when their bank is unloaded
+        if (!Pool.Instances[i]->isValid())
+        {
+            RemoveInstanceAt(Pool, i);
+            continue;
+        }
+
+        FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+        Pool.Instances[i]->getPlaybackState(&State);
+        if (Index == INDEX_NONE && State == FMOD_STUDIO_PLAYBACK_STOPPED)
+        {
+            Index = i;
+        }
+    }
+
+    if (Index != INDEX_NONE)
+    {
+        ++Stats.InstancesReused;
+    }
+    else if (Pool.Instances.Num() < Settings.EventInstancePoolSize)
+    {
+        FMOD::Studio::EventInstance *Instance = nullptr;
+        if (EventDesc->createInstance(&Instance) != FMOD_OK || !Instance)
+        {
+            return nullptr;
+        }
+        ++Stats.InstancesCreated;
+
+        Pool.Instances.Add(Instance);
+        Pool.StartTimes.Add(FApp::GetCurrentTime());
+        Pool.IdleTimes.Add(0.0);
+        return Instance;
+    }
+    else
+    {
+        Index = FindInstanceToSteal(Pool);
+        verifyfmod(Pool.Instances[Index]->stop(FMOD_STUDIO_STOP_IMMEDIATE));
+        ++Stats.InstancesStolen;
+    }
+
+    FMOD::Studio::EventInstance *Instance = Pool.Instances[Index];
+    ResetInstance(Instance, Pool);
+    Pool.StartTimes[Index] = FApp::GetCurrentTime();
+    Pool.IdleTimes[Index] = 0.0;
+    return Instance;
+}
+
+bool FFMODEventPool::OwnsInstance(FMOD::Studio::EventDescription *EventDesc, FMOD::Studio::EventInstance *Instance) const
+{
+    const FInstancePool *Pool = InstancePools.Find(EventDesc);
+    return Pool && Pool->Instances.Contains(Instance);
+}
+
+void FFMODEventPool::ResetInstance(FMOD::Studio::EventInstance *Instance, const FInstancePool &Pool) const
+{
+    Instance->setVolume(1.0f);
+    Instance->setPitch(1.0f);
+    Instance->setPaused(false);
+    for (int Property = 0; Property < FMOD_STUDIO_EVENT_PROPERTY_MAX; ++Property)
+    {
+        // -1 reverts the property to the value set in Studio
+        Instance->setProperty((FMOD_STUDIO_EVENT_PROPERTY)Property, -1.0f);
+    }
+    if (Pool.ParameterIDs.Num() > 0)
+    {
+        Instance->setParametersByIDs(Pool.ParameterIDs.GetData(), Pool.DefaultValues.GetData(), Pool.ParameterIDs.Num(), true);
+    }
+}
+
+void FFMODEventPool::Update()
+{
+    const double CurrentTime = FApp::GetCurrentTime();
+    if (InstancePools.Num() == 0 || CurrentTime < NextIdleCheckTime)
+    {
+        return;
+    }
+    NextIdleCheckTime = CurrentTime + IDLE_CHECK_INTERVAL;
+
+    // Released instances let the bank loader unload the event's sample data
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    for (auto It = InstancePools.CreateIterator(); It; ++It)
+    {
+        FInstancePool &Pool = It.Value();
+        for (int32 i = Pool.Instances.Num() - 1; i >= 0; --i)
+        {
+            FMOD::Studio::EventInstance *Instance = Pool.Instances[i];
+            if (!Instance->isValid())
+            {
+                RemoveInstanceAt(Pool, i);
+                continue;
+            }
+
+            FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+            Instance->getPlaybackState(&State);
+            if (State != FMOD_STUDIO_PLAYBACK_STOPPED)
+            {
+                Pool.IdleTimes[i] = 0.0;
+            }
+            else if (Pool.IdleTimes[i] == 0.0)
+            {
+                Pool.IdleTimes[i] = CurrentTime;
+            }
+            else if (CurrentTime - Pool.IdleTimes[i] >= Settings.EventInstancePoolIdleTime)
+            {
+                Instance->release();
+                RemoveInstanceAt(Pool, i);
+                ++Stats.InstancesReleased;
+            }
+        }
+        if (Pool.Instances.Num() == 0)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FFMODEventPool::RemoveInstanceAt(FInstancePool &Pool, int32 Index)
+{
+    Pool.Instances.RemoveAtSwap(Index);
+    Pool.StartTimes.RemoveAtSwap(Index);
+    Pool.IdleTimes.RemoveAtSwap(Index);
+}
+
+void FFMODEventPool::ReleaseInstances(FInstancePool &Pool)
+{
+    for (FMOD::Studio::EventInstance *Instance : Pool.Instances)
+    {
+        if (Instance->isValid())
+        {
+            Instance->stop(FMOD_STUDIO_STOP_IMMEDIATE);
+            Instance->release();
+        }
+    }
+    Pool.Instances.Reset();
+    Pool.StartTimes.Reset();
+    Pool.IdleTimes.Reset();
+}
+
+void FFMODEventPool::CacheDefaults(FMOD::Studio::EventDescription *EventDesc, FInstancePool &Pool)
+{
+    int ParameterCount = 0;
+    EventDesc->getParameterDescriptionCount(&ParameterCount);
+    for (int ParameterIndex = 0; ParameterIndex < ParameterCount; ++ParameterIndex)
+    {
+        FMOD_STUDIO_PARAMETER_DESCRIPTION ParameterDescription;
+        if (EventDesc->getParameterDescriptionByIndex(ParameterIndex, &ParameterDescription) == FMOD_OK &&
+            ParameterDescription.type == FMOD_STUDIO_PARAMETER_GAME_CONTROLLED &&
+            !(ParameterDescription.flags & (FMOD_STUDIO_PARAMETER_READONLY | FMOD_STUDIO_PARAMETER_GLOBAL)))
+        {
+            Pool.ParameterIDs.Add(ParameterDescription.id);
+            Pool.DefaultValues.Add(ParameterDescription.defaultvalue);
+        }
+    }
+    Pool.bDefaultsCached = true;
+}
+
+int32 FFMODEventPool::FindInstanceToSteal(const FInstancePool &Pool) const
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    int32 BestIndex = 0;
+    if (Settings.InstanceStealPolicy == EFMODInstanceStealPolicy::Quietest)
+    {
+        float BestVolume = FLT_MAX;
+        for (int32 i = 0; i < Pool.Instances.Num(); ++i)
+        {
+            float Volume = 0.0f;
+            float FinalVolume = 0.0f;
+            Pool.Instances[i]->getVolume(&Volume, &FinalVolume);
+            if (FinalVolume < BestVolume)
+            {
+                BestVolume = FinalVolume;
+                BestIndex = i;
+            }
+        }
+    }
+    else
+    {
+        for (int32 i = 1; i < Pool.Instances.Num(); ++i)
+        {
+            if (Pool.StartTimes[i] < Pool.StartTimes[BestIndex])
+            {
+                BestIndex = i;
+            }
+        }
+    }
+    return BestIndex;
+}
+
+UFMODAudioComponent *FFMODEventPool::AcquireComponent(AActor *Owner)
+{
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> *Pool = ComponentPools.Find(Owner);
+    if (!Pool)
+    {
+        return nullptr;
+    }
+
+    for (int32 i = Pool->Num() - 1; i >= 0; --i)
+    {
+        UFMODAudioComponent *Component = (*Pool)[i].Get();
+        if (!IsValid(Component) || !Component->IsRegistered())
+        {
+            Pool->RemoveAtSwap(i);
+        }
+        else if (!Component->IsActive())
+        {
+            ++Stats.ComponentsReused;
+            return Component;
+        }
+    }
+    return nullptr;
+}
+
+bool FFMODEventPool::AddComponent(UFMODAudioComponent *Component)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    AActor *Owner = Component->GetOwner();
+    if (!Owner || Settings.AttachedComponentPoolSize <= 0)
+    {
+        return false;
+    }
+
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> *Pool = ComponentPools.Find(Owner);
+    if (!Pool)
+    {
+        // Drop pools for actors that have been destroyed
+        for (auto It = ComponentPools.CreateIterator(); It; ++It)
+        {
+            if (!It.Key().IsValid())
+            {
+                It.RemoveCurrent();
+            }
+        }
+        Pool = &ComponentPools.Add(Owner);
+    }
+
+    if (Pool->Num() >= Settings.AttachedComponentPoolSize)
+    {
+        return false;
+    }
+
+    Pool->Add(Component);
+    ++Stats.ComponentsCreated;
+    return true;
+}
+
+void FFMODEventPool::ResetInstances()
+{
+    for (auto &Entry : InstancePools)
+    {
+        ReleaseInstances(Entry.Value);
+    }
+    InstancePools.Reset();
+}
+
+void FFMODEventPool::Reset()
+{
+    ResetInstances();
+    ComponentPools.Reset();
+}
@@ -0,0 +1,120 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "fmod_studio_common.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class EventDescription;
+class EventInstance;
+}
+}
+
+class AActor;
+class UFMODAudioComponent;
+
+/** Running totals reported through the FMOD stats group */
+struct FFMODEventPoolStats
+{
+    FFMODEventPoolStats()
+        : InstancesCreated(0)
+        , InstancesReused(0)
+        , InstancesStolen(0)
+        , InstancesReleased(0)
+        , ComponentsCreated(0)
+        , ComponentsReused(0)
+    {
+    }
+
+    uint32 InstancesCreated;
+    uint32 InstancesReused;
+    uint32 InstancesStolen;
+    uint32 InstancesReleased;
+    uint32 ComponentsCreated;
+    uint32 ComponentsReused;
+};
+
+/**
+ * Recycles event instances for fire-and-forget one-shots, and audio components for one-shots that follow a component.
+ * Pooled instances are owned by the pool and must not be handed out, since the pool may restart them for another one-shot.
+ * They are released once they have been idle for the configured time, or when the pool is reset.
+ */
+class FFMODEventPool
+{
+public:
+    FFMODEventPool()
+        : NextIdleCheckTime(0.0)
+    {
+    }
+
+    /**
+     * Return an instance of the event ready to be started, reusing a finished instance or stealing a playing one once the
+     * pool is full. Returns nullptr if instance pooling is disabled.
+     */
+    FMOD::Studio::EventInstance *AcquireInstance(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Return whether an instance of the event belongs to the pool */
+    bool OwnsInstance(FMOD::Studio::EventDescription *EventDesc, FMOD::Studio::EventInstance *Instance) const;
+
+    /** Return a finished pooled audio component owned by the actor, or nullptr if there isn't one */
+    UFMODAudioComponent *AcquireComponent(AActor *Owner);
+
+    /** Add a new audio component to its owner's pool, returns false if the pool is full */
+    bool AddComponent(UFMODAudioComponent *Component);
+
+    /** Release instances that have been stopped for longer than the pool's idle time */
+    void Update();
+
+    /** Stop and release all pooled instances, e.g. before the banks their events come from are unloaded */
+    void ResetInstances();
+
+    /** Stop and release all pooled instances and forget pooled components */
+    void Reset();
+
+    const FFMODEventPoolStats &GetStats() const { return Stats; }
+
+private:
+    struct FInstancePool
+    {
+        FInstancePool()
+            : bDefaultsCached(false)
+        {
+            FMemory::Memzero(EventID);
+        }
+
+        TArray<FMOD::Studio::EventInstance *> Instances;
+        TArray<double> StartTimes;
+
+        /** Time each instance was first seen stopped, or 0 while it is in use */
+        TArray<double> IdleTimes;
+
+        /** ID of the event the pool was created for, in case its description is released and the address reused */
+        FMOD_GUID EventID;
+
+        /** Default values of the event's local game controlled parameters, restored when an instance is reused */
+        TArray<FMOD_STUDIO_PARAMETER_ID> ParameterIDs;
+        TArray<float> DefaultValues;
+        bool bDefaultsCached;
+    };
+
+    void CacheDefaults(FMOD::Studio::EventDescription *EventDesc, FInstancePool &Pool);
+    int32 FindInstanceToSteal(const FInstancePool &Pool) const;
+
+    /** Restore the state a new instance of the event would have */
+    void ResetInstance(FMOD::Studio::EventInstance *Instance, const FInstancePool &Pool) const;
+
+    void ReleaseInstances(FInstancePool &Pool);
+    void RemoveInstanceAt(FInstancePool &Pool, int32 Index);
+
+    TMap<FMOD::Studio::EventDescription *, FInstancePool> InstancePools;
+    TMap<TWeakObjectPtr<AActor>, TArray<TWeakObjectPtr<UFMODAudioComponent>>> ComponentPools;
+    FFMODEventPoolStats Stats;
+
+    /** Time of the next check for idle instances */
+    double NextIdleCheckTime;
+};
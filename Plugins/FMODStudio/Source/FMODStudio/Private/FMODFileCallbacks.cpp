@@ -3,9 +3,9 @@
 #include "FMODFileCallbacks.h"
 #include "FMODUtils.h"
 #include "HAL/FileManager.h"
-#include "GenericPlatform/GenericPlatformProcess.h"
-#include "HAL/Runnable.h"
-#include "HAL/RunnableThread.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Async/AsyncFileHandle.h"
 #include "Misc/ScopeLock.h"
 #include "FMODStudioPrivatePCH.h"
 
@@ -42,190 +42,93 @@ FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file,
     return FMOD_OK;
 }
 
-class FFMODFileSystem : public FRunnable
+/** Per-file state, handed to FMOD as the file handle */
+struct FFMODAsyncFile
 {
-public:
-    FFMODFileSystem()
-        : mHandleIn(nullptr)
-        , mName(nullptr)
-        , mFileSize(nullptr)
-        , mHandleOut(nullptr)
-        , mBuffer(nullptr)
-        , mSizeBytes(0)
-        , mBytesRead(nullptr)
-        , mSeekPosition(0)
-        , mCommand(COMMAND_MAX)
-        , mResult(FMOD_OK)
-        , mReferenceCount(0)
-        , mThread(nullptr)
-        , mCommandReadyEvent(nullptr)
-        , mCommandCompleteEvent(nullptr)
+    FFMODAsyncFile(IAsyncReadFileHandle *InHandle, int64 InSize)
+        : Handle(InHandle)
+        , Size(InSize)
     {
     }
 
-    static FMOD_RESULT F_CALLBACK OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/);
-    static FMOD_RESULT F_CALLBACK CloseCallback(void *handle, void * /*userdata*/);
-    static FMOD_RESULT F_CALLBACK ReadCallback(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread, void * /*userdata*/);
-    static FMOD_RESULT F_CALLBACK SeekCallback(void *handle, unsigned int pos, void * /*userdata*/);
+    IAsyncReadFileHandle *Handle;
+    int64 Size;
 
-    static FMOD_RESULT OpenInternal(const char *name, unsigned int *filesize, void **handle);
-    static FMOD_RESULT CloseInternal(void *handle);
-    static FMOD_RESULT ReadInternal(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread);
-    static FMOD_RESULT SeekInternal(void *handle, unsigned int pos);
+    /** Guards Requests against concurrent reads and cancels */
+    FCriticalSection Lock;
 
-    void IncrementReferenceCount()
-    {
-        FScopeLock lock(&mCrit);
+    /** Read requests that haven't been deleted yet, with the FMOD read they serve */
+    TArray<TPair<FMOD_ASYNCREADINFO *, IAsyncReadRequest *>> Requests;
+};
 
-        ++mReferenceCount;
+/**
+ * Implements FMOD's asynchronous file callbacks on top of IAsyncReadFileHandle.
+ * Every open file has its own handle and request list, so streams never wait on each other.
+ */
+class FFMODFileSystem
+{
+public:
+    FFMODFileSystem()
+        : mReferenceCount(0)
+        , mOpenFileCount(0)
+    {
+    }
 
-        if (mReferenceCount == 1)
-        {
-            check(!mThread);
+    static FMOD_RESULT F_CALLBACK OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK CloseCallback(void *handle, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK AsyncReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK AsyncCancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
 
-            mCommandReadyEvent = FGenericPlatformProcess::GetSynchEventFromPool();
-            mCommandCompleteEvent = FGenericPlatformProcess::GetSynchEventFromPool();
-            mThread = FRunnableThread::Create(this, TEXT("FMOD File Access Coordinator"));
-        }
-    }
+    void IncrementReferenceCount() { mReferenceCount.Increment(); }
 
     void DecrementReferenceCount()
     {
-        FScopeLock lock(&mCrit);
-
-        check(mReferenceCount > 0);
-        check(mThread);
-
-        --mReferenceCount;
+        verify(mReferenceCount.Decrement() >= 0);
 
-        if (mReferenceCount == 0)
+        if (mReferenceCount.GetValue() == 0 && mOpenFileCount.GetValue() != 0)
         {
-            verifyfmod(RunCommand(COMMAND_STOP));
-            mThread->WaitForCompletion();
-
-            FGenericPlatformProcess::ReturnSynchEventToPool(mCommandReadyEvent);
-            mCommandReadyEvent = nullptr;
-            FGenericPlatformProcess::ReturnSynchEventToPool(mCommandCompleteEvent);
-            mCommandCompleteEvent = nullptr;
-            delete mThread;
-            mThread = nullptr;
+            UE_LOG(LogFMOD, Warning, TEXT("FFMODFileSystem released with %d files still open"), mOpenFileCount.GetValue());
         }
     }
 
     void Attach(FMOD::System *system, int32 fileBufferSize)
     {
-        check(mThread);
-
-        verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, ReadCallback, SeekCallback, 0, 0, fileBufferSize));
-    }
-
-    uint32 Run() override
-    {
-        bool stopRequested = false;
-
-        while (!stopRequested)
-        {
-            mCommandReadyEvent->Wait();
-
-            switch (mCommand)
-            {
-                case COMMAND_OPEN:
-                    mResult = OpenInternal(mName, mFileSize, mHandleOut);
-                    break;
-                case COMMAND_CLOSE:
-                    mResult = CloseInternal(mHandleIn);
-                    break;
-                case COMMAND_READ:
-                    mResult = ReadInternal(mHandleIn, mBuffer, mSizeBytes, mBytesRead);
-                    break;
-                case COMMAND_SEEK:
-                    mResult = SeekInternal(mHandleIn, mSeekPosition);
-                    break;
-                case COMMAND_STOP:
-                    stopRequested = true;
-                    mResult = FMOD_OK;
-                    break;
-            }
-
-            mCommandCompleteEvent->Trigger();
-        }
+        check(mReferenceCount.GetValue() > 0);
 
-        return 0;
+        verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, nullptr, nullptr, AsyncReadCallback, AsyncCancelCallback, fileBufferSize));
     }
 
 private:
-    enum Command
-    {
-        COMMAND_OPEN,
-        COMMAND_CLOSE,
-        COMMAND_READ,
-        COMMAND_SEEK,
-        COMMAND_STOP,
-        COMMAND_MAX,
-    };
-
-    FMOD_RESULT RunCommand(Command command)
-    {
-        check(mThread);
-
-        mCommand = command;
-        mCommandReadyEvent->Trigger();
-        mCommandCompleteEvent->Wait();
+    /** Delete requests that have finished, including their completion callback */
+    static void DeleteCompletedRequests(FFMODAsyncFile *File);
 
-        return mResult;
-    }
-
-    // Parameter for Close, Seek and Read
-    void *mHandleIn;
-
-    // Parameters for Open
-    const char *mName;
-    unsigned int *mFileSize;
-    void **mHandleOut;
-
-    // Parameters for Read
-    void *mBuffer;
-    unsigned int mSizeBytes;
-    unsigned int *mBytesRead;
-
-    // Parameter for Seek
-    unsigned int mSeekPosition;
-
-    Command mCommand;
-    FMOD_RESULT mResult;
-
-    int mReferenceCount;
-    FRunnableThread *mThread;
-    FEvent *mCommandReadyEvent;
-    FEvent *mCommandCompleteEvent;
-
-    FCriticalSection mCrit;
+    FThreadSafeCounter mReferenceCount;
+    FThreadSafeCounter mOpenFileCount;
 };
 
 static FFMODFileSystem gFileSystem;
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/)
-{
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mName = name;
-    gFileSystem.mFileSize = filesize;
-    gFileSystem.mHandleOut = handle;
-
-    return gFileSystem.RunCommand(COMMAND_OPEN);
-}
-
-FMOD_RESULT FFMODFileSystem::OpenInternal(const char *name, unsigned int *filesize, void **handle)
 {
     if (name)
     {
-        FArchive *Archive = IFileManager::Get().CreateFileReader(UTF8_TO_TCHAR(name));
-        UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::OpenInternal opening '%s' returned archive %p"), UTF8_TO_TCHAR(name), Archive);
-        if (!Archive)
+        const TCHAR *Path = UTF8_TO_TCHAR(name);
+        int64 Size = IFileManager::Get().FileSize(Path);
+        if (Size < 0)
         {
             return FMOD_ERR_FILE_NOTFOUND;
         }
-        *filesize = Archive->TotalSize();
-        *handle = Archive;
+
+        IAsyncReadFileHandle *Handle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(Path);
+        UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::OpenCallback opening '%s' returned handle %p"), Path, Handle);
+        if (!Handle)
+        {
+            return FMOD_ERR_FILE_NOTFOUND;
+        }
+
+        *filesize = (unsigned int)Size;
+        *handle = new FFMODAsyncFile(Handle, Size);
+        gFileSystem.mOpenFileCount.Increment();
         UE_LOG(LogFMOD, Verbose, TEXT("  TotalSize = %d"), *filesize);
     }
 
@@ -233,82 +136,124 @@ FMOD_RESULT FFMODFileSystem::OpenInternal(const char *name, unsigned int *filesi
 }
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::CloseCallback(void *handle, void * /*userdata*/)
-{
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-
-    return gFileSystem.RunCommand(COMMAND_CLOSE);
-}
-
-FMOD_RESULT FFMODFileSystem::CloseInternal(void *handle)
 {
     if (!handle)
     {
         return FMOD_ERR_INVALID_PARAM;
     }
 
-    FArchive *Archive = (FArchive *)handle;
-    UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::CloseCallback closing archive %p"), Archive);
-    delete Archive;
+    FFMODAsyncFile *File = (FFMODAsyncFile *)handle;
+    UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::CloseCallback closing handle %p"), File->Handle);
+
+    // FMOD cancels outstanding reads before closing, but the requests still have to finish before they can be deleted
+    for (const TPair<FMOD_ASYNCREADINFO *, IAsyncReadRequest *> &Request : File->Requests)
+    {
+        Request.Value->WaitCompletion();
+        delete Request.Value;
+    }
+    delete File->Handle;
+    delete File;
+    gFileSystem.mOpenFileCount.Decrement();
 
     return FMOD_OK;
 }
 
-FMOD_RESULT F_CALLBACK FFMODFileSystem::ReadCallback(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread, void * /*userdata*/)
+void FFMODFileSystem::DeleteCompletedRequests(FFMODAsyncFile *File)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-    gFileSystem.mBuffer = buffer;
-    gFileSystem.mSizeBytes = sizebytes;
-    gFileSystem.mBytesRead = bytesread;
+    FScopeLock Lock(&File->Lock);
 
-    return gFileSystem.RunCommand(COMMAND_READ);
+    for (int32 i = File->Requests.Num() - 1; i >= 0; --i)
+    {
+        IAsyncReadRequest *Request = File->Requests[i].Value;
+        if (Request->PollCompletion())
+        {
+            delete Request;
+            File->Requests.RemoveAtSwap(i);
+        }
+    }
 }
 
-FMOD_RESULT FFMODFileSystem::ReadInternal(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread)
+FMOD_RESULT F_CALLBACK FFMODFileSystem::AsyncReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
 {
-    if (!handle)
+    if (!info->handle)
     {
         return FMOD_ERR_INVALID_PARAM;
     }
 
-    if (bytesread)
-    {
-        FArchive *Archive = (FArchive *)handle;
+    FFMODAsyncFile *File = (FFMODAsyncFile *)info->handle;
+    DeleteCompletedRequests(File);
 
-        int64 BytesLeft = Archive->TotalSize() - Archive->Tell();
-        int64 ReadAmount = FMath::Min((int64)sizebytes, BytesLeft);
+    const int64 ReadSize = FMath::Min((int64)info->sizebytes, File->Size - (int64)info->offset);
+    if (ReadSize <= 0)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT(" -> EOF "));
+        info->bytesread = 0;
+        info->done(info, FMOD_ERR_FILE_EOF);
+        return FMOD_OK;
+    }
 
-        Archive->Serialize(buffer, ReadAmount);
-        *bytesread = (unsigned int)ReadAmount;
-        if (ReadAmount < (int64)sizebytes)
+    FAsyncFileCallBack Callback = [info, ReadSize](bool bWasCancelled, IAsyncReadRequest *Request) {
+        FMOD_RESULT Result = FMOD_OK;
+        if (bWasCancelled)
         {
-            UE_LOG(LogFMOD, Verbose, TEXT(" -> EOF "));
-            return FMOD_ERR_FILE_EOF;
+            info->bytesread = 0;
+            Result = FMOD_ERR_FILE_DISKEJECTED;
         }
-    }
+        else
+        {
+            info->bytesread = (unsigned int)ReadSize;
+            if (ReadSize < (int64)info->sizebytes)
+            {
+                UE_LOG(LogFMOD, Verbose, TEXT(" -> EOF "));
+                Result = FMOD_ERR_FILE_EOF;
+            }
+        }
+        info->done(info, Result);
+    };
 
-    return FMOD_OK;
-}
+    // FMOD priorities go from 0 to 100, with 100 being the most urgent
+    EAsyncIOPriorityAndFlags Priority = AIOP_Normal;
+    if (info->priority >= 100)
+    {
+        Priority = AIOP_CriticalPath;
+    }
+    else if (info->priority >= 50)
+    {
+        Priority = AIOP_High;
+    }
 
-FMOD_RESULT F_CALLBACK FFMODFileSystem::SeekCallback(void *handle, unsigned int pos, void * /*userdata*/)
-{
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-    gFileSystem.mSeekPosition = pos;
+    FScopeLock Lock(&File->Lock);
+    IAsyncReadRequest *Request = File->Handle->ReadRequest(info->offset, ReadSize, Priority, &Callback, (uint8 *)info->buffer);
+    if (!Request)
+    {
+        return FMOD_ERR_FILE_BAD;
+    }
+    File->Requests.Add(TPair<FMOD_ASYNCREADINFO *, IAsyncReadRequest *>(info, Request));
 
-    return gFileSystem.RunCommand(COMMAND_SEEK);
+    return FMOD_OK;
 }
 
-FMOD_RESULT FFMODFileSystem::SeekInternal(void *handle, unsigned int pos)
+FMOD_RESULT F_CALLBACK FFMODFileSystem::AsyncCancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
 {
-    if (!handle)
+    if (!info->handle)
     {
         return FMOD_ERR_INVALID_PARAM;
     }
 
-    FArchive *Archive = (FArchive *)handle;
-    Archive->Seek(pos);
+    FFMODAsyncFile *File = (FFMODAsyncFile *)info->handle;
+
+    // FMOD may reuse the info as soon as we return, so wait for the completion callback to run.
+    // The lock stops the request being deleted under us; completion callbacks never take it.
+    FScopeLock Lock(&File->Lock);
+    for (const TPair<FMOD_ASYNCREADINFO *, IAsyncReadRequest *> &Entry : File->Requests)
+    {
+        if (Entry.Key == info && !Entry.Value->PollCompletion())
+        {
+            Entry.Value->Cancel();
+            Entry.Value->WaitCompletion();
+            break;
+        }
+    }
 
     return FMOD_OK;
 }
@@ -327,3 +272,13 @@ void AttachFMODFileSystem(FMOD::System *system, int32 fileBufferSize)
 {
     gFileSystem.Attach(system, fileBufferSize);
 }
+
+FFMODFileSystemCallbacks GetFMODFileSystemCallbacks()
+{
+    FFMODFileSystemCallbacks Callbacks;
+    Callbacks.Open = FFMODFileSystem::OpenCallback;
+    Callbacks.Close = FFMODFileSystem::CloseCallback;
+    Callbacks.AsyncRead = FFMODFileSystem::AsyncReadCallback;
+    Callbacks.AsyncCancel = FFMODFileSystem::AsyncCancelCallback;
+    return Callbacks;
+}
@@ -10,3 +10,14 @@ FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file,
 void AcquireFMODFileSystem();
 void ReleaseFMODFileSystem();
 void AttachFMODFileSystem(FMOD::System *system, FGenericPlatformTypes::int32 fileBufferSize);
+
+/** The callbacks AttachFMODFileSystem gives FMOD, for tests that stand in for an FMOD system */
+struct FFMODFileSystemCallbacks
+{
+    FMOD_FILE_OPEN_CALLBACK Open;
+    FMOD_FILE_CLOSE_CALLBACK Close;
+    FMOD_FILE_ASYNCREAD_CALLBACK AsyncRead;
+    FMOD_FILE_ASYNCCANCEL_CALLBACK AsyncCancel;
+};
+
+FFMODFileSystemCallbacks GetFMODFileSystemCallbacks();
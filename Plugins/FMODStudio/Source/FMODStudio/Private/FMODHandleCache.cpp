@@ -0,0 +1,96 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODHandleCache.h"
+#include "FMODStudioCalls.h"
+#include "FMODUtils.h"
+#include "fmod_studio.hpp"
+
+#include "FMODStudioPrivatePCH.h"
+
+FFMODHandleCache::FFMODHandleCache()
+    : System(nullptr)
+{
+}
+
+void FFMODHandleCache::Reset(FMOD::Studio::System *InSystem)
+{
+    System = InSystem;
+    Buses.Reset();
+    VCAs.Reset();
+    GlobalParameterIDs.Reset();
+}
+
+FMOD::Studio::Bus *FFMODHandleCache::GetBus(const FGuid &Guid)
+{
+    if (System == nullptr)
+    {
+        return nullptr;
+    }
+
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    FMOD::Studio::Bus **Cached = Buses.Find(Guid);
+    if (Cached && Calls.IsValid(*Cached))
+    {
+        return *Cached;
+    }
+
+    // Failed lookups aren't remembered, the bank holding the bus may not have loaded yet
+    FMOD::Studio::ID ID = FMODUtils::ConvertGuid(Guid);
+    FMOD::Studio::Bus *Bus = nullptr;
+    if (Calls.GetBusByID(System, ID, &Bus) != FMOD_OK || Bus == nullptr)
+    {
+        Buses.Remove(Guid);
+        return nullptr;
+    }
+    Buses.Add(Guid, Bus);
+    return Bus;
+}
+
+FMOD::Studio::VCA *FFMODHandleCache::GetVCA(const FGuid &Guid)
+{
+    if (System == nullptr)
+    {
+        return nullptr;
+    }
+
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    FMOD::Studio::VCA **Cached = VCAs.Find(Guid);
+    if (Cached && Calls.IsValid(*Cached))
+    {
+        return *Cached;
+    }
+
+    FMOD::Studio::ID ID = FMODUtils::ConvertGuid(Guid);
+    FMOD::Studio::VCA *VCA = nullptr;
+    if (Calls.GetVCAByID(System, ID, &VCA) != FMOD_OK || VCA == nullptr)
+    {
+        VCAs.Remove(Guid);
+        return nullptr;
+    }
+    VCAs.Add(Guid, VCA);
+    return VCA;
+}
+
+bool FFMODHandleCache::GetGlobalParameterID(FName Name, FMOD_STUDIO_PARAMETER_ID &OutID)
+{
+    if (System == nullptr)
+    {
+        return false;
+    }
+
+    if (const FMOD_STUDIO_PARAMETER_ID *Cached = GlobalParameterIDs.Find(Name))
+    {
+        OutID = *Cached;
+        return true;
+    }
+
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    FMOD_STUDIO_PARAMETER_DESCRIPTION Description;
+    if (Calls.GetParameterDescriptionByName(System, TCHAR_TO_UTF8(*Name.ToString()), &Description) != FMOD_OK)
+    {
+        return false;
+    }
+    GlobalParameterIDs.Add(Name, Description.id);
+    OutID = Description.id;
+    return true;
+}
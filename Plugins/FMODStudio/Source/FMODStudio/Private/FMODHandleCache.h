@@ -0,0 +1,48 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fmod_studio_common.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class Bus;
+class VCA;
+class System;
+}
+}
+
+/**
+ * Remembers the runtime system's bus and VCA handles and global parameter IDs, so mixer blueprints that set them every frame
+ * don't look them up by GUID or name each time. Handles are checked on use, so entries from unloaded banks are looked up again.
+ */
+class FFMODHandleCache
+{
+public:
+    FFMODHandleCache();
+
+    /** Forget all handles and look them up in the given system from now on, which may be null */
+    void Reset(FMOD::Studio::System *InSystem);
+
+    /** System the handles are looked up in, null while there is no runtime system */
+    FMOD::Studio::System *GetSystem() const { return System; }
+
+    FMOD::Studio::Bus *GetBus(const FGuid &Guid);
+    FMOD::Studio::VCA *GetVCA(const FGuid &Guid);
+
+    /** Find the ID of a global parameter, returns false if the system doesn't have one with this name */
+    bool GetGlobalParameterID(FName Name, FMOD_STUDIO_PARAMETER_ID &OutID);
+
+    /** Forget a global parameter ID that the system no longer recognises, e.g. because its bank was reloaded */
+    void InvalidateGlobalParameter(FName Name) { GlobalParameterIDs.Remove(Name); }
+
+private:
+    FMOD::Studio::System *System;
+
+    TMap<FGuid, FMOD::Studio::Bus *> Buses;
+    TMap<FGuid, FMOD::Studio::VCA *> VCAs;
+    TMap<FName, FMOD_STUDIO_PARAMETER_ID> GlobalParameterIDs;
+};
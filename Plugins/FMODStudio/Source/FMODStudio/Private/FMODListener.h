@@ -48,6 +48,12 @@ struct FFMODListener
     float ExteriorVolumeInterp;
     float ExteriorLPFInterp;
 
+    /** Time passed since the attributes were last passed to FMOD */
+    float PendingDeltaSeconds;
+
+    /** Whether the attributes have been passed to FMOD since the listener was reset */
+    bool bAttributesSet;
+
     FVector GetUp() const { return Transform.GetUnitAxis(EAxis::Z); }
     FVector GetFront() const { return Transform.GetUnitAxis(EAxis::Y); }
     FVector GetRight() const { return Transform.GetUnitAxis(EAxis::X); }
@@ -80,6 +86,8 @@ struct FFMODListener
         , InteriorLPFInterp(0.f)
         , ExteriorVolumeInterp(0.f)
         , ExteriorLPFInterp(0.f)
+        , PendingDeltaSeconds(0.f)
+        , bAttributesSet(false)
     {
     }
 };
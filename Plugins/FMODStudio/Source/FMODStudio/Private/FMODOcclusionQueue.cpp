@@ -0,0 +1,78 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODOcclusionQueue.h"
+#include "FMODAudioComponent.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+void FFMODOcclusionQueue::Add(UFMODAudioComponent *Component)
+{
+    Queue.Add(Component);
+}
+
+int32 FFMODOcclusionQueue::Update(int32 MaxTraces, TFunctionRef<bool(UFMODAudioComponent &Component, uint32 TraceId)> StartTrace)
+{
+    int32 TraceCount = 0;
+    int32 Index = 0;
+    for (; Index < Queue.Num() && TraceCount < MaxTraces; ++Index)
+    {
+        UFMODAudioComponent *Component = Queue[Index].Get();
+        if (!IsValid(Component))
+        {
+            continue;
+        }
+
+        uint32 TraceId = NextTraceId++;
+        if (!StartTrace(*Component, TraceId))
+        {
+            // Let the component request another trace once it can be traced
+            Component->bOcclusionTracePending = false;
+            continue;
+        }
+        TracesInFlight.Add(TraceId, Component);
+        ++TraceCount;
+    }
+    Queue.RemoveAt(0, Index, false);
+    return TraceCount;
+}
+
+void FFMODOcclusionQueue::Complete(uint32 TraceId, bool bIsOccluded)
+{
+    TWeakObjectPtr<UFMODAudioComponent> Component;
+    if (TracesInFlight.RemoveAndCopyValue(TraceId, Component) && Component.IsValid())
+    {
+        Component->ApplyOcclusion(bIsOccluded);
+    }
+}
+
+void FFMODOcclusionQueue::RemoveWorld(UWorld *World)
+{
+    // Traces started in a world that is torn down never complete, so their entries would otherwise stay in the map
+    auto IsStale = [World](const TWeakObjectPtr<UFMODAudioComponent> &Component) {
+        if (!Component.IsValid())
+        {
+            return true;
+        }
+        if (Component->GetWorld() == World)
+        {
+            Component->bOcclusionTracePending = false;
+            return true;
+        }
+        return false;
+    };
+
+    Queue.RemoveAll(IsStale);
+    for (auto It = TracesInFlight.CreateIterator(); It; ++It)
+    {
+        if (IsStale(It.Value()))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FFMODOcclusionQueue::Reset()
+{
+    Queue.Reset();
+    TracesInFlight.Reset();
+}
@@ -0,0 +1,52 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Templates/Function.h"
+
+class UFMODAudioComponent;
+class UWorld;
+
+/**
+ * Spreads occlusion traces for audio components over multiple frames. Components are traced in the order they were queued,
+ * and keep their trace pending flag set until the trace completes or is dropped.
+ */
+class FFMODOcclusionQueue
+{
+public:
+    FFMODOcclusionQueue()
+        : NextTraceId(0)
+    {
+    }
+
+    /** Queue a component for an occlusion trace */
+    void Add(UFMODAudioComponent *Component);
+
+    /**
+     * Start traces for up to MaxTraces queued components. StartTrace returns false if the component can't be traced, in which
+     * case it doesn't count towards the limit and can request a trace again. Returns the number of traces started.
+     */
+    int32 Update(int32 MaxTraces, TFunctionRef<bool(UFMODAudioComponent &Component, uint32 TraceId)> StartTrace);
+
+    /** Apply the result of a trace started by Update */
+    void Complete(uint32 TraceId, bool bIsOccluded);
+
+    /** Drop queued and in flight traces for components in a world that is being cleaned up, or that no longer exist */
+    void RemoveWorld(UWorld *World);
+
+    /** Drop all queued and in flight traces */
+    void Reset();
+
+    int32 NumQueued() const { return Queue.Num(); }
+    int32 NumInFlight() const { return TracesInFlight.Num(); }
+
+private:
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> Queue;
+
+    /** Components with a trace in flight, keyed by the id passed to StartTrace */
+    TMap<uint32, TWeakObjectPtr<UFMODAudioComponent>> TracesInFlight;
+
+    uint32 NextTraceId;
+};
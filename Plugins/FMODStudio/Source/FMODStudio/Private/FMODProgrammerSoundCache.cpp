@@ -0,0 +1,327 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODProgrammerSoundCache.h"
+#include "FMODSettings.h"
+#include "FMODStudioCalls.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "fmod_studio.hpp"
+
+#include "FMODStudioPrivatePCH.h"
+
+FFMODProgrammerSoundCache::FFMODProgrammerSoundCache()
+    : System(nullptr)
+{
+}
+
+void FFMODProgrammerSoundCache::Reset(FMOD::Studio::System *InSystem)
+{
+    TArray<FMOD::Sound *, TInlineAllocator<16>> Unused;
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        DropEntries(false, Unused);
+        System = InSystem;
+    }
+
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    for (FMOD::Sound *Sound : Unused)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Releasing programmer sound for system reset"));
+        Calls.Release(Sound);
+    }
+}
+
+bool FFMODProgrammerSoundCache::Acquire(FMOD::Studio::System *InSystem, const FString &Name, FMOD::Sound *&OutSound, int32 &OutSubsoundIndex)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (InSystem == System && System != nullptr)
+        {
+            FMOD::Sound *Stream = nullptr;
+            FEntry *Entry = FindOrCreateEntry(Name, Stream, OutSubsoundIndex);
+            if (!Entry)
+            {
+                // Streams aren't cached, so Release treats them like any other uncached sound
+                OutSound = Stream;
+                return Stream != nullptr;
+            }
+            ++Entry->RefCount;
+            Entry->LastUsed = FPlatformTime::Seconds();
+            OutSound = Entry->Sound;
+            OutSubsoundIndex = Entry->SubsoundIndex;
+            return true;
+        }
+    }
+
+    // Sounds for the auditioning and editor systems aren't worth keeping
+    bool bStreamed = false;
+    return CreateSound(InSystem, Name, OutSound, OutSubsoundIndex, bStreamed);
+}
+
+void FFMODProgrammerSoundCache::Release(FMOD::Sound *Sound)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (const FString *Name = SoundNames.Find(Sound))
+        {
+            FEntry &Entry = Entries.FindChecked(*Name);
+            --Entry.RefCount;
+            Entry.LastUsed = FPlatformTime::Seconds();
+            return;
+        }
+
+        if (int32 *InstanceCount = DroppedSounds.Find(Sound))
+        {
+            if (--*InstanceCount > 0)
+            {
+                return;
+            }
+            DroppedSounds.Remove(Sound);
+        }
+    }
+
+    UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
+    verifyfmod(IFMODStudioModule::Get().GetStudioCalls().Release(Sound));
+}
+
+bool FFMODProgrammerSoundCache::LoadSound(const FString &Name)
+{
+    FMOD::Sound *Stream = nullptr;
+    {
+        FScopeLock ScopeLock(&Lock);
+        int32 SubsoundIndex = -1;
+        FEntry *Entry = FindOrCreateEntry(Name, Stream, SubsoundIndex);
+        if (Entry)
+        {
+            if (!Entry->bLoaded)
+            {
+                Entry->bLoaded = true;
+                ++Entry->RefCount;
+            }
+            Entry->LastUsed = FPlatformTime::Seconds();
+            return true;
+        }
+    }
+
+    if (Stream)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Not preloading programmer sound '%s', it is streamed"), *Name);
+        IFMODStudioModule::Get().GetStudioCalls().Release(Stream);
+    }
+    return false;
+}
+
+void FFMODProgrammerSoundCache::UnloadSound(const FString &Name)
+{
+    FScopeLock ScopeLock(&Lock);
+    FEntry *Entry = Entries.Find(Name);
+    if (Entry && Entry->bLoaded)
+    {
+        Entry->bLoaded = false;
+        --Entry->RefCount;
+    }
+}
+
+void FFMODProgrammerSoundCache::Update()
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    const int64 Budget = int64(Settings.ProgrammerSoundMemoryBudget) * 1024 * 1024;
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    TArray<FMOD::Sound *, TInlineAllocator<16>> Evicted;
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (Entries.Num() == 0)
+        {
+            return;
+        }
+
+        TArray<TPair<double, FString>, TInlineAllocator<64>> Unused;
+        int64 UnusedSize = 0;
+        for (auto It = Entries.CreateIterator(); It; ++It)
+        {
+            FEntry &Entry = It.Value();
+            if (Entry.RefCount > 0)
+            {
+                continue;
+            }
+
+            if (Entry.Size == 0)
+            {
+                FMOD_OPENSTATE OpenState = FMOD_OPENSTATE_ERROR;
+                Calls.GetOpenState(Entry.Sound, &OpenState);
+                if (OpenState == FMOD_OPENSTATE_ERROR)
+                {
+                    // Let the next play try again
+                    SoundNames.Remove(Entry.Sound);
+                    Evicted.Add(Entry.Sound);
+                    It.RemoveCurrent();
+                    continue;
+                }
+                if (OpenState != FMOD_OPENSTATE_READY)
+                {
+                    // The size isn't known until a non-blocking sound has opened, keep it until then
+                    continue;
+                }
+
+                unsigned int Length = 0;
+                Calls.GetLength(Entry.Sound, &Length, FMOD_TIMEUNIT_RAWBYTES);
+                Entry.Size = FMath::Max(Length, 1u);
+            }
+
+            Unused.Emplace(Entry.LastUsed, It.Key());
+            UnusedSize += Entry.Size;
+        }
+
+        if (UnusedSize > Budget)
+        {
+            Unused.Sort([](const TPair<double, FString> &A, const TPair<double, FString> &B) { return A.Key < B.Key; });
+            for (const TPair<double, FString> &It : Unused)
+            {
+                if (UnusedSize <= Budget)
+                {
+                    break;
+                }
+
+                FEntry Entry;
+                Entries.RemoveAndCopyValue(It.Value, Entry);
+                SoundNames.Remove(Entry.Sound);
+                UnusedSize -= Entry.Size;
+                Evicted.Add(Entry.Sound);
+                ++Stats.SoundsEvicted;
+            }
+        }
+    }
+
+    // Releasing a sound can wait for it to finish opening, so don't hold up FMOD's thread
+    for (FMOD::Sound *Sound : Evicted)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Evicting programmer sound"));
+        Calls.Release(Sound);
+    }
+}
+
+void FFMODProgrammerSoundCache::ReleaseAudioTableSounds()
+{
+    TArray<FMOD::Sound *, TInlineAllocator<16>> Unused;
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        DropEntries(true, Unused);
+    }
+
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    for (FMOD::Sound *Sound : Unused)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Releasing programmer sound for bank unload"));
+        Calls.Release(Sound);
+    }
+}
+
+void FFMODProgrammerSoundCache::DropEntries(bool bAudioTableOnly, TArray<FMOD::Sound *, TInlineAllocator<16>> &OutUnused)
+{
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        const FEntry &Entry = It.Value();
+        if (bAudioTableOnly && !Entry.bFromAudioTable)
+        {
+            continue;
+        }
+
+        SoundNames.Remove(Entry.Sound);
+        const int32 InstanceCount = Entry.RefCount - (Entry.bLoaded ? 1 : 0);
+        if (InstanceCount > 0)
+        {
+            DroppedSounds.Add(Entry.Sound, InstanceCount);
+        }
+        else
+        {
+            OutUnused.Add(Entry.Sound);
+        }
+        It.RemoveCurrent();
+    }
+}
+
+FFMODProgrammerSoundCache::FEntry *FFMODProgrammerSoundCache::FindOrCreateEntry(
+    const FString &Name, FMOD::Sound *&OutStream, int32 &OutSubsoundIndex)
+{
+    if (FEntry *Entry = Entries.Find(Name))
+    {
+        ++Stats.SoundsReused;
+        return Entry;
+    }
+
+    // Sounds are created non-blocking, so this doesn't wait on the disk
+    FEntry NewEntry;
+    bool bStreamed = false;
+    if (!CreateSound(System, Name, NewEntry.Sound, NewEntry.SubsoundIndex, bStreamed))
+    {
+        return nullptr;
+    }
+    if (bStreamed)
+    {
+        OutStream = NewEntry.Sound;
+        OutSubsoundIndex = NewEntry.SubsoundIndex;
+        return nullptr;
+    }
+    NewEntry.bFromAudioTable = !IsFileName(Name);
+    ++Stats.SoundsCreated;
+
+    SoundNames.Add(NewEntry.Sound, Name);
+    return &Entries.Add(Name, NewEntry);
+}
+
+bool FFMODProgrammerSoundCache::CreateSound(
+    FMOD::Studio::System *InSystem, const FString &Name, FMOD::Sound *&OutSound, int32 &OutSubsoundIndex, bool &bOutStreamed)
+{
+    if (InSystem == nullptr)
+    {
+        return false;
+    }
+
+    FFMODStudioCalls &Calls = IFMODStudioModule::Get().GetStudioCalls();
+    FMOD_MODE SoundMode = FMOD_LOOP_NORMAL | FMOD_CREATECOMPRESSEDSAMPLE | FMOD_NONBLOCKING;
+
+    bOutStreamed = false;
+    if (IsFileName(Name))
+    {
+        // Load via file
+        FString SoundPath = Name;
+        if (FPaths::IsRelative(SoundPath))
+        {
+            SoundPath = FPaths::ProjectContentDir() / SoundPath;
+        }
+
+        FMOD::Sound *Sound = nullptr;
+        if (Calls.CreateSound(InSystem, TCHAR_TO_UTF8(*SoundPath), SoundMode, nullptr, &Sound) != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound file '%s'"), *SoundPath);
+            return false;
+        }
+        UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from file '%s'"), *SoundPath);
+        OutSound = Sound;
+        OutSubsoundIndex = -1;
+        return true;
+    }
+
+    // Load via FMOD Studio asset table
+    FMOD_STUDIO_SOUND_INFO SoundInfo = { 0 };
+    if (Calls.GetSoundInfo(InSystem, TCHAR_TO_UTF8(*Name), &SoundInfo) != FMOD_OK)
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to find FMOD audio entry '%s'"), *Name);
+        return false;
+    }
+
+    FMOD::Sound *Sound = nullptr;
+    if (Calls.CreateSound(InSystem, SoundInfo.name_or_data, SoundMode | SoundInfo.mode, &SoundInfo.exinfo, &Sound) != FMOD_OK)
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to load FMOD audio entry '%s'"), *Name);
+        return false;
+    }
+    UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound using audio entry '%s'"), *Name);
+    OutSound = Sound;
+    OutSubsoundIndex = SoundInfo.subsoundindex;
+    bOutStreamed = (SoundInfo.mode & FMOD_CREATESTREAM) != 0;
+    return true;
+}
@@ -0,0 +1,133 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+namespace FMOD
+{
+class Sound;
+namespace Studio
+{
+class System;
+}
+}
+
+/** Running totals reported through the FMOD stats group */
+struct FFMODProgrammerSoundStats
+{
+    FFMODProgrammerSoundStats()
+        : SoundsCreated(0)
+        , SoundsReused(0)
+        , SoundsEvicted(0)
+    {
+    }
+
+    uint32 SoundsCreated;
+    uint32 SoundsReused;
+    uint32 SoundsEvicted;
+};
+
+/**
+ * Shares programmer sounds created for audio table keys and file paths between event instances, so a line played many times is
+ * only opened once. Sounds are reference counted by the instances using them and by explicit preloads; unreferenced sounds stay
+ * cached until their memory exceeds the budget in the settings, then the least recently used are released.
+ * Streamed audio table entries are never cached, as a stream can only be played by one instance at a time.
+ * Acquire and Release are called from FMOD's thread, everything else from the game thread.
+ */
+class FFMODProgrammerSoundCache
+{
+public:
+    FFMODProgrammerSoundCache();
+
+    /**
+     * Drop all cached sounds and cache sounds for the given system from now on. Must be called before the old system is released.
+     * Sounds still used by instances are released when the last of those instances releases them.
+     */
+    void Reset(FMOD::Studio::System *InSystem);
+
+    /**
+     * Return the sound for an audio table key or file path, creating it if needed. Sounds for other systems than the cache's
+     * are created uncached. Every successful call must be matched by a call to Release.
+     */
+    bool Acquire(FMOD::Studio::System *InSystem, const FString &Name, FMOD::Sound *&OutSound, int32 &OutSubsoundIndex);
+
+    /** Release a sound returned by Acquire */
+    void Release(FMOD::Sound *Sound);
+
+    /** Start loading a sound ahead of its event being played, and keep it loaded until UnloadSound is called */
+    bool LoadSound(const FString &Name);
+    void UnloadSound(const FString &Name);
+
+    /** Release the least recently used unreferenced sounds once they exceed the memory budget */
+    void Update();
+
+    /**
+     * Drop all sounds created from audio table entries, which point into the data of the bank holding the table. Must be called
+     * before a bank is unloaded. Sounds still used by instances are released when the last of those instances releases them.
+     */
+    void ReleaseAudioTableSounds();
+
+    const FFMODProgrammerSoundStats &GetStats() const { return Stats; }
+
+private:
+    struct FEntry
+    {
+        FEntry()
+            : Sound(nullptr)
+            , SubsoundIndex(-1)
+            , bFromAudioTable(false)
+            , RefCount(0)
+            , bLoaded(false)
+            , LastUsed(0.0)
+            , Size(0)
+        {
+        }
+
+        FMOD::Sound *Sound;
+        int32 SubsoundIndex;
+        bool bFromAudioTable;
+
+        /** Number of instances using the sound, plus one while it is explicitly loaded */
+        int32 RefCount;
+        bool bLoaded;
+        double LastUsed;
+
+        /** Size of the sound's data, read once it has finished opening */
+        uint32 Size;
+    };
+
+    /** Create a sound from an audio table entry, or from a file if the name has an extension */
+    static bool CreateSound(
+        FMOD::Studio::System *InSystem, const FString &Name, FMOD::Sound *&OutSound, int32 &OutSubsoundIndex, bool &bOutStreamed);
+
+    /** Return true if the name is a file path rather than an audio table key */
+    static bool IsFileName(const FString &Name) { return Name.Contains(TEXT(".")); }
+
+    /**
+     * Find or create the entry for a name, must be called with the lock held. A streamed sound is returned in OutStream instead of
+     * being given an entry, in which case this returns nullptr.
+     */
+    FEntry *FindOrCreateEntry(const FString &Name, FMOD::Sound *&OutStream, int32 &OutSubsoundIndex);
+
+    /**
+     * Remove all entries, or only those from the audio table, must be called with the lock held. Sounds still used by instances
+     * move to DroppedSounds, the others are added to OutUnused for the caller to release once the lock is released.
+     */
+    void DropEntries(bool bAudioTableOnly, TArray<FMOD::Sound *, TInlineAllocator<16>> &OutUnused);
+
+    /** Guards everything below, as instances acquire and release sounds on FMOD's thread */
+    FCriticalSection Lock;
+
+    FMOD::Studio::System *System;
+    TMap<FString, FEntry> Entries;
+
+    /** Names of the cached sounds, to find their entries when FMOD hands them back */
+    TMap<FMOD::Sound *, FString> SoundNames;
+
+    /** Sounds dropped from the cache while instances were still using them, with the number of those instances */
+    TMap<FMOD::Sound *, int32> DroppedSounds;
+
+    FFMODProgrammerSoundStats Stats;
+};
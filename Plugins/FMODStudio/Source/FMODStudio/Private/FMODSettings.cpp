@@ -36,6 +36,19 @@ UFMODSettings::UFMODSettings(const FObjectInitializer &ObjectInitializer)
     EditorLiveUpdatePort = 9265;
     bMatchHardwareSampleRate = true;
     bLockAllBuses = false;
+    OcclusionTracesPerFrame = 32;
+    EventInstancePoolSize = 16;
+    InstanceStealPolicy = EFMODInstanceStealPolicy::Oldest;
+    EventInstancePoolIdleTime = 10.0f;
+    AttachedComponentPoolSize = 4;
+    bVirtualizeOutOfRangeEvents = false;
+    VirtualizationHysteresis = 500.0f;
+    bStreamBankLoading = false;
+    BankLoadsPerFrame = 4;
+    TotalMemoryBudgetForSampleData = 0;
+    ProgrammerSoundMemoryBudget = 16;
+    StatsSampleInterval = 0.1f;
+    StatsWindowSize = 600;
 }
 
 FString UFMODSettings::GetFullBankPath() const
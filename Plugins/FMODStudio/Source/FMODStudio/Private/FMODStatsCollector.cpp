@@ -0,0 +1,232 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODStatsCollector.h"
+#include "FMODSettings.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "fmod_studio.hpp"
+
+#include "FMODStudioPrivatePCH.h"
+
+void FFMODStatsWindow::SetCapacity(int32 NewCapacity)
+{
+    NewCapacity = FMath::Max(NewCapacity, 1);
+    if (NewCapacity == Capacity)
+    {
+        return;
+    }
+
+    // Unroll the ring so the oldest sample is first, dropping the oldest ones that no longer fit
+    TArray<FFMODStatsSample> Ordered;
+    Ordered.Reserve(NewCapacity);
+    int32 NumToDrop = FMath::Max(Samples.Num() - NewCapacity, 0);
+    ForEach([&Ordered, &NumToDrop](const FFMODStatsSample &Sample) {
+        if (NumToDrop > 0)
+        {
+            --NumToDrop;
+        }
+        else
+        {
+            Ordered.Add(Sample);
+        }
+    });
+
+    Samples = MoveTemp(Ordered);
+    Capacity = NewCapacity;
+    NextSample = Samples.Num() % Capacity;
+}
+
+void FFMODStatsWindow::Add(const FFMODStatsSample &Sample)
+{
+    if (Samples.Num() < Capacity)
+    {
+        Samples.Add(Sample);
+        NextSample = Samples.Num() % Capacity;
+    }
+    else
+    {
+        Samples[NextSample] = Sample;
+        NextSample = (NextSample + 1) % Capacity;
+    }
+}
+
+void FFMODStatsWindow::Reset()
+{
+    Samples.Reset();
+    NextSample = 0;
+}
+
+const FFMODStatsSample &FFMODStatsWindow::GetLatest() const
+{
+    check(Samples.Num() > 0);
+    return Samples[(NextSample + Samples.Num() - 1) % Samples.Num()];
+}
+
+FFMODStatsCollector::FFMODStatsCollector()
+    : LastSampleTime(0.0)
+    , bCapturing(false)
+    , bSummaryDirty(false)
+    , CaptureCommand(TEXT("fmod.Stats.Capture"), TEXT("Sample FMOD stats even while stat FMOD isn't displayed. Usage: fmod.Stats.Capture [0|1]"),
+          FConsoleCommandWithArgsDelegate::CreateRaw(this, &FFMODStatsCollector::HandleCaptureCommand))
+    , DumpCommand(TEXT("fmod.Stats.DumpCSV"), TEXT("Write the sampled FMOD stats to a CSV file. Usage: fmod.Stats.DumpCSV [Filename]"),
+          FConsoleCommandWithArgsDelegate::CreateRaw(this, &FFMODStatsCollector::HandleDumpCommand))
+{
+}
+
+bool FFMODStatsCollector::Update(FMOD::Studio::System *System, bool bStatsViewed)
+{
+    if (System == nullptr || !(bStatsViewed || bCapturing))
+    {
+        return false;
+    }
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    const double CurrentTime = FApp::GetCurrentTime();
+    if (Window.Num() > 0 && CurrentTime - LastSampleTime < Settings.StatsSampleInterval)
+    {
+        return false;
+    }
+    LastSampleTime = CurrentTime;
+
+    Window.SetCapacity(Settings.StatsWindowSize);
+
+    FFMODStatsSample Sample;
+    Sample.Time = CurrentTime;
+
+    FMOD_STUDIO_CPU_USAGE Usage = {};
+    System->getCPUUsage(&Usage);
+    Sample.DSPUsage = Usage.dspusage;
+    Sample.StudioUsage = Usage.studiousage;
+
+    int CurrentAlloc = 0;
+    int MaxAlloc = 0;
+    FMOD::Memory_GetStats(&CurrentAlloc, &MaxAlloc, false);
+    Sample.CurrentMemory = CurrentAlloc;
+    Sample.MaxMemory = MaxAlloc;
+
+    int Channels = 0;
+    int RealChannels = 0;
+    FMOD::System *CoreSystem = nullptr;
+    System->getCoreSystem(&CoreSystem);
+    CoreSystem->getChannelsPlaying(&Channels, &RealChannels);
+    Sample.Channels = Channels;
+    Sample.RealChannels = RealChannels;
+
+    Window.Add(Sample);
+    bSummaryDirty = true;
+    return true;
+}
+
+void FFMODStatsCollector::Reset()
+{
+    Window.Reset();
+    LastSampleTime = 0.0;
+    CachedSummary = FFMODStatsSummary();
+    bSummaryDirty = false;
+}
+
+const FFMODStatsSample &FFMODStatsCollector::GetLatest() const
+{
+    return Window.GetLatest();
+}
+
+FFMODStatsRange FFMODStatsCollector::GetRange(float (*Value)(const FFMODStatsSample &)) const
+{
+    FFMODStatsRange Range;
+    if (Window.Num() == 0)
+    {
+        return Range;
+    }
+
+    TArray<float> Values;
+    Values.Reserve(Window.Num());
+    Window.ForEach([&Values, Value](const FFMODStatsSample &Sample) { Values.Add(Value(Sample)); });
+    Values.Sort();
+
+    Range.Min = Values[0];
+    Range.Max = Values.Last();
+    Range.P95 = Values[FMath::Min(FMath::CeilToInt(0.95f * Values.Num()) - 1, Values.Num() - 1)];
+    return Range;
+}
+
+const FFMODStatsSummary &FFMODStatsCollector::GetSummary() const
+{
+    if (!bSummaryDirty)
+    {
+        return CachedSummary;
+    }
+    bSummaryDirty = false;
+
+    CachedSummary.NumSamples = Window.Num();
+    CachedSummary.DSPUsage = GetRange([](const FFMODStatsSample &Sample) { return Sample.DSPUsage; });
+    CachedSummary.StudioUsage = GetRange([](const FFMODStatsSample &Sample) { return Sample.StudioUsage; });
+    CachedSummary.CurrentMemory = GetRange([](const FFMODStatsSample &Sample) { return (float)Sample.CurrentMemory; });
+    CachedSummary.RealChannels = GetRange([](const FFMODStatsSample &Sample) { return (float)Sample.RealChannels; });
+    CachedSummary.VirtualChannels = GetRange([](const FFMODStatsSample &Sample) { return (float)(Sample.Channels - Sample.RealChannels); });
+    return CachedSummary;
+}
+
+bool FFMODStatsCollector::DumpToCSV(const FString &Path) const
+{
+    FString Contents = TEXT("Time,DSPUsage,StudioUsage,CurrentMemory,MaxMemory,Channels,RealChannels,VirtualChannels\n");
+    double StartTime = -1.0;
+    Window.ForEach([&Contents, &StartTime](const FFMODStatsSample &Sample) {
+        if (StartTime < 0.0)
+        {
+            StartTime = Sample.Time;
+        }
+        Contents += FString::Printf(TEXT("%.3f,%.2f,%.2f,%d,%d,%d,%d,%d\n"), Sample.Time - StartTime, Sample.DSPUsage, Sample.StudioUsage,
+            Sample.CurrentMemory, Sample.MaxMemory, Sample.Channels, Sample.RealChannels, Sample.Channels - Sample.RealChannels);
+    });
+    return FFileHelper::SaveStringToFile(Contents, *Path);
+}
+
+void FFMODStatsCollector::SetCapturing(bool bEnable)
+{
+    if (bEnable && !bCapturing)
+    {
+        // Start the capture with a fresh window
+        Reset();
+    }
+    bCapturing = bEnable;
+}
+
+void FFMODStatsCollector::HandleCaptureCommand(const TArray<FString> &Args)
+{
+    SetCapturing(Args.Num() > 0 ? FCString::ToBool(*Args[0]) : !bCapturing);
+    UE_LOG(LogFMOD, Display, TEXT("FMOD stats capture %s"), bCapturing ? TEXT("started") : TEXT("stopped"));
+}
+
+void FFMODStatsCollector::HandleDumpCommand(const TArray<FString> &Args)
+{
+    if (Window.Num() == 0)
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("No FMOD stats have been sampled, use stat FMOD or fmod.Stats.Capture 1 first"));
+        return;
+    }
+
+    FString Path = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("FMODStats-%s.csv"), *FDateTime::Now().ToString());
+    if (FPaths::IsRelative(Path))
+    {
+        Path = FPaths::ProfilingDir() / TEXT("FMOD") / Path;
+    }
+
+    if (!DumpToCSV(Path))
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to write FMOD stats to %s"), *Path);
+        return;
+    }
+
+    const FFMODStatsSummary &Summary = GetSummary();
+    UE_LOG(LogFMOD, Display, TEXT("Wrote %d FMOD stats samples to %s"), Summary.NumSamples, *Path);
+    UE_LOG(LogFMOD, Display, TEXT("  CPU Mixer: min %.2f%% max %.2f%% p95 %.2f%%"), Summary.DSPUsage.Min, Summary.DSPUsage.Max, Summary.DSPUsage.P95);
+    UE_LOG(LogFMOD, Display, TEXT("  CPU Studio: min %.2f%% max %.2f%% p95 %.2f%%"), Summary.StudioUsage.Min, Summary.StudioUsage.Max,
+        Summary.StudioUsage.P95);
+    UE_LOG(LogFMOD, Display, TEXT("  Memory: min %.0f max %.0f p95 %.0f bytes"), Summary.CurrentMemory.Min, Summary.CurrentMemory.Max,
+        Summary.CurrentMemory.P95);
+    UE_LOG(LogFMOD, Display, TEXT("  Real channels: min %.0f max %.0f p95 %.0f"), Summary.RealChannels.Min, Summary.RealChannels.Max,
+        Summary.RealChannels.P95);
+    UE_LOG(LogFMOD, Display, TEXT("  Virtual channels: min %.0f max %.0f p95 %.0f"), Summary.VirtualChannels.Min, Summary.VirtualChannels.Max,
+        Summary.VirtualChannels.P95);
+}
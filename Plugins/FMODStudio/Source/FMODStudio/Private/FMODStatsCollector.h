@@ -0,0 +1,146 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class System;
+}
+}
+
+/** Performance counters read from the runtime system at one point in time */
+struct FFMODStatsSample
+{
+    double Time;
+    float DSPUsage;
+    float StudioUsage;
+    int32 CurrentMemory;
+    int32 MaxMemory;
+    int32 Channels;
+    int32 RealChannels;
+};
+
+/** Ring buffer holding the most recent samples */
+class FFMODStatsWindow
+{
+public:
+    FFMODStatsWindow()
+        : NextSample(0)
+        , Capacity(1)
+    {
+    }
+
+    /** Change how many samples are kept, keeping the newest ones in order */
+    void SetCapacity(int32 NewCapacity);
+
+    /** Add a sample, replacing the oldest once the window is full */
+    void Add(const FFMODStatsSample &Sample);
+
+    void Reset();
+
+    int32 Num() const { return Samples.Num(); }
+    int32 GetCapacity() const { return Capacity; }
+
+    /** Most recent sample, only valid if the window isn't empty */
+    const FFMODStatsSample &GetLatest() const;
+
+    /** Call Func with each sample, oldest first */
+    template <typename FuncType> void ForEach(FuncType Func) const
+    {
+        // Before the window fills NextSample is Samples.Num(), so the oldest is at 0 either way
+        const int32 Oldest = (Samples.Num() > 0) ? NextSample % Samples.Num() : 0;
+        for (int32 i = 0; i < Samples.Num(); ++i)
+        {
+            Func(Samples[(Oldest + i) % Samples.Num()]);
+        }
+    }
+
+private:
+    /** NextSample is the oldest sample once the window is full */
+    TArray<FFMODStatsSample> Samples;
+    int32 NextSample;
+    int32 Capacity;
+};
+
+/** Spread of one counter over the sample window */
+struct FFMODStatsRange
+{
+    FFMODStatsRange()
+        : Min(0.0f)
+        , Max(0.0f)
+        , P95(0.0f)
+    {
+    }
+
+    float Min;
+    float Max;
+    float P95;
+};
+
+struct FFMODStatsSummary
+{
+    FFMODStatsSummary()
+        : NumSamples(0)
+    {
+    }
+
+    int32 NumSamples;
+    FFMODStatsRange DSPUsage;
+    FFMODStatsRange StudioUsage;
+    FFMODStatsRange CurrentMemory;
+    FFMODStatsRange RealChannels;
+    FFMODStatsRange VirtualChannels;
+};
+
+/**
+ * Samples FMOD's CPU, memory and channel counters at the interval set in the settings, keeping a rolling window of samples.
+ * Nothing is read from FMOD unless the caller is displaying the stats or a capture has been started with fmod.Stats.Capture.
+ * The window can be written out with fmod.Stats.DumpCSV for soak tests run without a profiler attached.
+ */
+class FFMODStatsCollector
+{
+public:
+    FFMODStatsCollector();
+
+    /** Take a sample if one is due and someone wants it, returns true if a new sample was taken */
+    bool Update(FMOD::Studio::System *System, bool bStatsViewed);
+
+    /** Forget all samples, e.g. when the runtime system is released */
+    void Reset();
+
+    /** Number of samples in the window */
+    int32 NumSamples() const { return Window.Num(); }
+
+    /** Most recent sample, only valid once Update has returned true */
+    const FFMODStatsSample &GetLatest() const;
+
+    /** Min, max and 95th percentile of each counter over the window, recalculated only after a new sample is taken */
+    const FFMODStatsSummary &GetSummary() const;
+
+    /** Write the window to a CSV file, oldest sample first */
+    bool DumpToCSV(const FString &Path) const;
+
+    void SetCapturing(bool bEnable);
+    bool IsCapturing() const { return bCapturing; }
+
+private:
+    FFMODStatsRange GetRange(float (*Value)(const FFMODStatsSample &)) const;
+
+    void HandleCaptureCommand(const TArray<FString> &Args);
+    void HandleDumpCommand(const TArray<FString> &Args);
+
+    FFMODStatsWindow Window;
+    double LastSampleTime;
+    bool bCapturing;
+
+    mutable FFMODStatsSummary CachedSummary;
+    mutable bool bSummaryDirty;
+
+    FAutoConsoleCommand CaptureCommand;
+    FAutoConsoleCommand DumpCommand;
+};
@@ -0,0 +1,223 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODStudioCalls.h"
+#include "fmod_studio.hpp"
+
+#include "FMODStudioPrivatePCH.h"
+
+const FFMODEventDescriptionInfo *FFMODStudioCalls::GetEventDescriptionInfo(const UFMODEvent *Event, EFMODSystemContext::Type Context)
+{
+    return IFMODStudioModule::Get().GetEventDescriptionInfo(Event, Context);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetEventByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::EventDescription **OutEventDesc)
+{
+    return System->getEventByID(&ID, OutEventDesc);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetParameterDescriptionByName(
+    FMOD::Studio::EventDescription *EventDesc, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter)
+{
+    return EventDesc->getParameterDescriptionByName(Name, OutParameter);
+}
+
+FMOD_RESULT FFMODStudioCalls::CreateInstance(FMOD::Studio::EventDescription *EventDesc, FMOD::Studio::EventInstance **OutInstance)
+{
+    return EventDesc->createInstance(OutInstance);
+}
+
+bool FFMODStudioCalls::IsValid(FMOD::Studio::EventInstance *Instance)
+{
+    return Instance->isValid();
+}
+
+FMOD_RESULT FFMODStudioCalls::Start(FMOD::Studio::EventInstance *Instance)
+{
+    return Instance->start();
+}
+
+FMOD_RESULT FFMODStudioCalls::Stop(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_STOP_MODE Mode)
+{
+    return Instance->stop(Mode);
+}
+
+FMOD_RESULT FFMODStudioCalls::Release(FMOD::Studio::EventInstance *Instance)
+{
+    return Instance->release();
+}
+
+FMOD_RESULT FFMODStudioCalls::GetPlaybackState(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PLAYBACK_STATE *OutState)
+{
+    return Instance->getPlaybackState(OutState);
+}
+
+FMOD_RESULT FFMODStudioCalls::Set3DAttributes(FMOD::Studio::EventInstance *Instance, const FMOD_3D_ATTRIBUTES &Attributes)
+{
+    return Instance->set3DAttributes(&Attributes);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetParameterByID(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PARAMETER_ID ID, float Value)
+{
+    return Instance->setParameterByID(ID, Value);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetParametersByIDs(FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID *IDs, float *Values, int Count)
+{
+    return Instance->setParametersByIDs(IDs, Values, Count, false);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetParameterByName(FMOD::Studio::EventInstance *Instance, const char *Name, float Value)
+{
+    return Instance->setParameterByName(Name, Value);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetProperty(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_PROPERTY Property, float Value)
+{
+    return Instance->setProperty(Property, Value);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetCallback(
+    FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_CALLBACK Callback, FMOD_STUDIO_EVENT_CALLBACK_TYPE CallbackMask)
+{
+    return Instance->setCallback(Callback, CallbackMask);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetUserData(FMOD::Studio::EventInstance *Instance, void *UserData)
+{
+    return Instance->setUserData(UserData);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetTimelinePosition(FMOD::Studio::EventInstance *Instance, int Position)
+{
+    return Instance->setTimelinePosition(Position);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetTimelinePosition(FMOD::Studio::EventInstance *Instance, int *OutPosition)
+{
+    return Instance->getTimelinePosition(OutPosition);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetNumListeners(FMOD::Studio::System *System, int NumListeners)
+{
+    return System->setNumListeners(NumListeners);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetListenerAttributes(FMOD::Studio::System *System, int Listener, const FMOD_3D_ATTRIBUTES &Attributes)
+{
+    return System->setListenerAttributes(Listener, &Attributes);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetBusByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::Bus **OutBus)
+{
+    return System->getBusByID(&ID, OutBus);
+}
+
+bool FFMODStudioCalls::IsValid(FMOD::Studio::Bus *Bus)
+{
+    return Bus->isValid();
+}
+
+FMOD_RESULT FFMODStudioCalls::SetVolume(FMOD::Studio::Bus *Bus, float Volume)
+{
+    return Bus->setVolume(Volume);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetVCAByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::VCA **OutVCA)
+{
+    return System->getVCAByID(&ID, OutVCA);
+}
+
+bool FFMODStudioCalls::IsValid(FMOD::Studio::VCA *VCA)
+{
+    return VCA->isValid();
+}
+
+FMOD_RESULT FFMODStudioCalls::SetVolume(FMOD::Studio::VCA *VCA, float Volume)
+{
+    return VCA->setVolume(Volume);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetParameterDescriptionByName(
+    FMOD::Studio::System *System, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter)
+{
+    return System->getParameterDescriptionByName(Name, OutParameter);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetParameterByID(FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float Value)
+{
+    return System->setParameterByID(ID, Value);
+}
+
+FMOD_RESULT FFMODStudioCalls::SetParameterByName(FMOD::Studio::System *System, const char *Name, float Value)
+{
+    return System->setParameterByName(Name, Value);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetParameterByID(
+    FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float *OutValue, float *OutFinalValue)
+{
+    return System->getParameterByID(ID, OutValue, OutFinalValue);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetParameterByName(FMOD::Studio::System *System, const char *Name, float *OutValue, float *OutFinalValue)
+{
+    return System->getParameterByName(Name, OutValue, OutFinalValue);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetSoundInfo(FMOD::Studio::System *System, const char *Key, FMOD_STUDIO_SOUND_INFO *OutInfo)
+{
+    return System->getSoundInfo(Key, OutInfo);
+}
+
+FMOD_RESULT FFMODStudioCalls::CreateSound(
+    FMOD::Studio::System *System, const char *NameOrData, FMOD_MODE Mode, FMOD_CREATESOUNDEXINFO *ExInfo, FMOD::Sound **OutSound)
+{
+    FMOD::System *CoreSystem = nullptr;
+    FMOD_RESULT Result = System->getCoreSystem(&CoreSystem);
+    if (Result != FMOD_OK)
+    {
+        return Result;
+    }
+    return CoreSystem->createSound(NameOrData, Mode, ExInfo, OutSound);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetOpenState(FMOD::Sound *Sound, FMOD_OPENSTATE *OutState)
+{
+    return Sound->getOpenState(OutState, nullptr, nullptr, nullptr);
+}
+
+FMOD_RESULT FFMODStudioCalls::GetLength(FMOD::Sound *Sound, unsigned int *OutLength, FMOD_TIMEUNIT Unit)
+{
+    return Sound->getLength(OutLength, Unit);
+}
+
+FMOD_RESULT FFMODStudioCalls::Release(FMOD::Sound *Sound)
+{
+    return Sound->release();
+}
+
+FMOD_RESULT FFMODStudioCalls::LoadBankFile(
+    FMOD::Studio::System *System, const char *Filename, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **OutBank)
+{
+    return System->loadBankFile(Filename, Flags, OutBank);
+}
+
+FMOD_RESULT FFMODStudioCalls::FlushCommands(FMOD::Studio::System *System)
+{
+    return System->flushCommands();
+}
+
+FMOD_RESULT FFMODStudioCalls::GetLoadingState(FMOD::Studio::Bank *Bank, FMOD_STUDIO_LOADING_STATE *OutState)
+{
+    return Bank->getLoadingState(OutState);
+}
+
+FMOD_RESULT FFMODStudioCalls::LoadSampleData(FMOD::Studio::Bank *Bank)
+{
+    return Bank->loadSampleData();
+}
+
+FMOD_RESULT FFMODStudioCalls::Unload(FMOD::Studio::Bank *Bank)
+{
+    return Bank->unload();
+}
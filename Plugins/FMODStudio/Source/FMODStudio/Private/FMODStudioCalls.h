@@ -0,0 +1,95 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FMODStudioModule.h"
+#include "fmod_studio_common.h"
+
+namespace FMOD
+{
+class Sound;
+namespace Studio
+{
+class System;
+class EventDescription;
+class EventInstance;
+class Bank;
+class Bus;
+class VCA;
+}
+}
+
+class UFMODEvent;
+struct FFMODEventDescriptionInfo;
+
+/**
+ * The Studio API calls made on the plugin's hot paths: starting, updating and stopping emitters, listener updates, reverb snapshots,
+ * mixer and global parameter lookups, programmer sounds and bank loading. This implementation passes every call straight to FMOD,
+ * and event description lookups to the module. Tests replace it through IFMODStudioModule::SetStudioCalls to count and time the
+ * calls, or to run those paths without a Studio system. Programmer sounds are also acquired and released from FMOD's thread.
+ */
+class FFMODStudioCalls
+{
+public:
+    virtual ~FFMODStudioCalls() {}
+
+    // Event descriptions
+    virtual const FFMODEventDescriptionInfo *GetEventDescriptionInfo(const UFMODEvent *Event, EFMODSystemContext::Type Context);
+    virtual FMOD_RESULT GetEventByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::EventDescription **OutEventDesc);
+    virtual FMOD_RESULT GetParameterDescriptionByName(
+        FMOD::Studio::EventDescription *EventDesc, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter);
+
+    // Event instances
+    virtual FMOD_RESULT CreateInstance(FMOD::Studio::EventDescription *EventDesc, FMOD::Studio::EventInstance **OutInstance);
+    virtual bool IsValid(FMOD::Studio::EventInstance *Instance);
+    virtual FMOD_RESULT Start(FMOD::Studio::EventInstance *Instance);
+    virtual FMOD_RESULT Stop(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_STOP_MODE Mode);
+    virtual FMOD_RESULT Release(FMOD::Studio::EventInstance *Instance);
+    virtual FMOD_RESULT GetPlaybackState(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PLAYBACK_STATE *OutState);
+    virtual FMOD_RESULT Set3DAttributes(FMOD::Studio::EventInstance *Instance, const FMOD_3D_ATTRIBUTES &Attributes);
+    virtual FMOD_RESULT SetParameterByID(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PARAMETER_ID ID, float Value);
+    virtual FMOD_RESULT SetParametersByIDs(FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID *IDs, float *Values, int Count);
+    virtual FMOD_RESULT SetParameterByName(FMOD::Studio::EventInstance *Instance, const char *Name, float Value);
+    virtual FMOD_RESULT SetProperty(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_PROPERTY Property, float Value);
+    virtual FMOD_RESULT SetCallback(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_CALLBACK Callback,
+        FMOD_STUDIO_EVENT_CALLBACK_TYPE CallbackMask = FMOD_STUDIO_EVENT_CALLBACK_ALL);
+    virtual FMOD_RESULT SetUserData(FMOD::Studio::EventInstance *Instance, void *UserData);
+    virtual FMOD_RESULT SetTimelinePosition(FMOD::Studio::EventInstance *Instance, int Position);
+    virtual FMOD_RESULT GetTimelinePosition(FMOD::Studio::EventInstance *Instance, int *OutPosition);
+
+    // Listeners
+    virtual FMOD_RESULT SetNumListeners(FMOD::Studio::System *System, int NumListeners);
+    virtual FMOD_RESULT SetListenerAttributes(FMOD::Studio::System *System, int Listener, const FMOD_3D_ATTRIBUTES &Attributes);
+
+    // Mixer
+    virtual FMOD_RESULT GetBusByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::Bus **OutBus);
+    virtual bool IsValid(FMOD::Studio::Bus *Bus);
+    virtual FMOD_RESULT SetVolume(FMOD::Studio::Bus *Bus, float Volume);
+    virtual FMOD_RESULT GetVCAByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::VCA **OutVCA);
+    virtual bool IsValid(FMOD::Studio::VCA *VCA);
+    virtual FMOD_RESULT SetVolume(FMOD::Studio::VCA *VCA, float Volume);
+
+    // Global parameters
+    virtual FMOD_RESULT GetParameterDescriptionByName(
+        FMOD::Studio::System *System, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter);
+    virtual FMOD_RESULT SetParameterByID(FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float Value);
+    virtual FMOD_RESULT SetParameterByName(FMOD::Studio::System *System, const char *Name, float Value);
+    virtual FMOD_RESULT GetParameterByID(FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float *OutValue, float *OutFinalValue);
+    virtual FMOD_RESULT GetParameterByName(FMOD::Studio::System *System, const char *Name, float *OutValue, float *OutFinalValue);
+
+    // Programmer sounds
+    virtual FMOD_RESULT GetSoundInfo(FMOD::Studio::System *System, const char *Key, FMOD_STUDIO_SOUND_INFO *OutInfo);
+    virtual FMOD_RESULT CreateSound(
+        FMOD::Studio::System *System, const char *NameOrData, FMOD_MODE Mode, FMOD_CREATESOUNDEXINFO *ExInfo, FMOD::Sound **OutSound);
+    virtual FMOD_RESULT GetOpenState(FMOD::Sound *Sound, FMOD_OPENSTATE *OutState);
+    virtual FMOD_RESULT GetLength(FMOD::Sound *Sound, unsigned int *OutLength, FMOD_TIMEUNIT Unit);
+    virtual FMOD_RESULT Release(FMOD::Sound *Sound);
+
+    // Banks
+    virtual FMOD_RESULT LoadBankFile(FMOD::Studio::System *System, const char *Filename, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **OutBank);
+    virtual FMOD_RESULT FlushCommands(FMOD::Studio::System *System);
+    virtual FMOD_RESULT GetLoadingState(FMOD::Studio::Bank *Bank, FMOD_STUDIO_LOADING_STATE *OutState);
+    virtual FMOD_RESULT LoadSampleData(FMOD::Studio::Bank *Bank);
+    virtual FMOD_RESULT Unload(FMOD::Studio::Bank *Bank);
+};
@@ -10,6 +10,15 @@
 #include "FMODUtils.h"
 #include "FMODEvent.h"
 #include "FMODListener.h"
+#include "FMODEmitterManager.h"
+#include "FMODAudioVolumeCache.h"
+#include "FMODEventPool.h"
+#include "FMODOcclusionQueue.h"
+#include "FMODBankLoader.h"
+#include "FMODHandleCache.h"
+#include "FMODProgrammerSoundCache.h"
+#include "FMODStatsCollector.h"
+#include "FMODStudioCalls.h"
 #include "FMODSnapshotReverb.h"
 
 #include "Async/Async.h"
@@ -18,6 +27,7 @@
 #include "Misc/CommandLine.h"
 #include "Misc/CoreDelegates.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/GameViewportClient.h"
 #include "GameFramework/PlayerController.h"
@@ -27,6 +37,7 @@
 #include "Runtime/Media/Public/IMediaClockSink.h"
 #include "Runtime/Media/Public/IMediaModule.h"
 #include "TimerManager.h"
+#include "WorldCollision.h"
 
 #include "fmod_studio.hpp"
 #include "fmod_errors.h"
@@ -48,13 +59,40 @@
 
 DEFINE_LOG_CATEGORY(LogFMOD);
 
-DECLARE_STATS_GROUP(TEXT("FMOD"), STATGROUP_FMOD, STATCAT_Advanced);
+DEFINE_STAT(STAT_FMOD_Play);
+DEFINE_STAT(STAT_FMOD_AttenuationUpdate);
+DEFINE_STAT(STAT_FMOD_ListenerUpdate);
+DEFINE_STAT(STAT_FMOD_LoadBanks);
+DEFINE_STAT(STAT_FMOD_BankReload);
+DEFINE_STAT(STAT_FMOD_SequencerControl);
+DEFINE_STAT(STAT_FMOD_SequencerParameters);
+
 DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Mixer"), STAT_FMOD_CPUMixer, STATGROUP_FMOD);
 DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Studio"), STAT_FMOD_CPUStudio, STATGROUP_FMOD);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Mixer (p95)"), STAT_FMOD_CPUMixer_P95, STATGROUP_FMOD);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Studio (p95)"), STAT_FMOD_CPUStudio_P95, STATGROUP_FMOD);
 DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Current"), STAT_FMOD_Current_Memory, STATGROUP_FMOD);
 DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Max"), STAT_FMOD_Max_Memory, STATGROUP_FMOD);
 DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Channels - Total"), STAT_FMOD_Total_Channels, STATGROUP_FMOD);
 DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Channels - Real"), STAT_FMOD_Real_Channels, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Occlusion Traces"), STAT_FMOD_Occlusion_Traces, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Occlusion Queue"), STAT_FMOD_Occlusion_Queue, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Emitters"), STAT_FMOD_Emitters, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Virtual Emitters"), STAT_FMOD_VirtualEmitters, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Emitter Listener Updates"), STAT_FMOD_EmitterListenerUpdates, STATGROUP_FMOD);
+DECLARE_CYCLE_STAT(TEXT("FMOD Emitter Update"), STAT_FMOD_EmitterUpdate, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Instance Pool - Created"), STAT_FMOD_InstancePool_Created, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Instance Pool - Reused"), STAT_FMOD_InstancePool_Reused, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Instance Pool - Stolen"), STAT_FMOD_InstancePool_Stolen, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Instance Pool - Released"), STAT_FMOD_InstancePool_Released, STATGROUP_FMOD);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD Instance Pool - Hit Rate"), STAT_FMOD_InstancePool_HitRate, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Component Pool - Created"), STAT_FMOD_ComponentPool_Created, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Component Pool - Reused"), STAT_FMOD_ComponentPool_Reused, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Programmer Sounds - Created"), STAT_FMOD_ProgrammerSounds_Created, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Programmer Sounds - Reused"), STAT_FMOD_ProgrammerSounds_Reused, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Programmer Sounds - Evicted"), STAT_FMOD_ProgrammerSounds_Evicted, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Event Description Cache - Hits"), STAT_FMOD_EventDescription_Hits, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Event Description Cache - Misses"), STAT_FMOD_EventDescription_Misses, STATGROUP_FMOD);
 
 const TCHAR *FMODSystemContextNames[EFMODSystemContext::Max] = {
     TEXT("Auditioning"), TEXT("Runtime"), TEXT("Editor"),
@@ -82,6 +120,8 @@ struct FFMODSnapshotEntry
         , FadeDuration(0.0f)
         , FadeIntensityStart(0.0f)
         , FadeIntensityEnd(0.0f)
+        , bHasIntensityID(false)
+        , AppliedIntensity(-1.0f)
     {
     }
 
@@ -115,6 +155,13 @@ struct FFMODSnapshotEntry
     float FadeDuration;
     float FadeIntensityStart;
     float FadeIntensityEnd;
+
+    /** Resolved when the instance is created so blending doesn't look the parameter up by name every frame */
+    FMOD_STUDIO_PARAMETER_ID IntensityID;
+    bool bHasIntensityID;
+
+    /** Intensity last sent to the instance, negative if none has been sent yet */
+    float AppliedIntensity;
 };
 
 class FFMODStudioSystemClockSink : public IMediaClockSink
@@ -150,6 +197,8 @@ public:
     FUpdateListenerPosition UpdateListenerPosition;
 };
 
+struct NamedBankEntry;
+
 class FFMODStudioModule : public IFMODStudioModule
 {
 public:
@@ -167,10 +216,14 @@ public:
         , StudioLibHandle(nullptr)
         , bMixerPaused(false)
         , MemPool(nullptr)
+        , EmitterManager(Listeners, ListenerCount, AudioVolumeCache)
+        , NextSystemGeneration(0)
+        , StudioCalls(&DefaultStudioCalls)
     {
         for (int i = 0; i < EFMODSystemContext::Max; ++i)
         {
             StudioSystem[i] = nullptr;
+            SystemGeneration[i] = 0;
         }
     }
 
@@ -194,8 +247,14 @@ public:
 
     void LoadBanks(EFMODSystemContext::Type Type);
 
+    /** Check the state of queued bank loads once they have been flushed, recording the banks that loaded and any failures */
+    void FinishLoadingBanks(EFMODSystemContext::Type Type, TArray<NamedBankEntry> &BankEntries, bool bLoadSampleData);
+
     /** Called when a newer version of the bank files was detected */
-    void HandleBanksUpdated();
+    void HandleBanksUpdated(const TSet<FString> &NotifiedFiles);
+
+    /** Bring a system's banks up to date with the changed files, recreating the system if the master banks changed */
+    void ReloadChangedBanks(EFMODSystemContext::Type Type, const TSet<FString> &ChangedFiles);
 
     void CreateStudioSystem(EFMODSystemContext::Type Type);
     void DestroyStudioSystem(EFMODSystemContext::Type Type);
@@ -207,11 +266,16 @@ public:
 
     virtual FMOD::Studio::System *GetStudioSystem(EFMODSystemContext::Type Context) override;
     virtual FMOD::Studio::EventDescription *GetEventDescription(const UFMODEvent *Event, EFMODSystemContext::Type Type) override;
+    virtual const FFMODEventDescriptionInfo *GetEventDescriptionInfo(const UFMODEvent *Event, EFMODSystemContext::Type Type) override;
+
+    /** Invalidate the event descriptions cached for a system, whenever its banks change */
+    void InvalidateEventDescriptions(EFMODSystemContext::Type Type);
     virtual FMOD::Studio::EventInstance *CreateAuditioningInstance(const UFMODEvent *Event) override;
     virtual void StopAuditioningInstance() override;
 
     virtual void SetListenerPosition(int ListenerIndex, UWorld *World, const FTransform &ListenerTransform, float DeltaSeconds) override;
     virtual void FinishSetListenerPosition(int ListenerCount) override;
+    virtual void UpdateViewportListener(UWorld *World, const FTransform &ViewTransform) override;
 
     virtual const FFMODListener &GetNearestListener(const FVector &Location) override;
 
@@ -255,6 +319,41 @@ public:
 
     void ResetInterpolation();
 
+    virtual void RequestOcclusionTrace(UFMODAudioComponent *Component) override;
+
+    /** Issue queued occlusion traces up to the per-frame budget */
+    void UpdateOcclusion();
+
+    /** Called when an async occlusion trace completes */
+    void OnOcclusionTraceDone(const FTraceHandle &Handle, FTraceDatum &Datum);
+
+    virtual FFMODEmitterManager &GetEmitterManager() override { return EmitterManager; }
+
+    virtual FFMODEventPool &GetEventPool() override { return EventPool; }
+
+    /** Sample the runtime system's stats when due and publish them to the FMOD stat group */
+    void UpdateSystemStats();
+
+    void UpdatePoolStats();
+
+    virtual FFMODBankLoader &GetBankLoader() override { return BankLoader; }
+
+    virtual FFMODBankLoadProgress &BankLoadProgressEvent() override { return BankLoader.OnProgress(); }
+
+    virtual FFMODHandleCache &GetHandleCache() override { return HandleCache; }
+
+    virtual FFMODProgrammerSoundCache &GetProgrammerSoundCache() override { return ProgrammerSoundCache; }
+
+    virtual FFMODStudioCalls &GetStudioCalls() override { return *StudioCalls; }
+
+    virtual void SetStudioCalls(FFMODStudioCalls *Calls) override { StudioCalls = Calls ? Calls : &DefaultStudioCalls; }
+
+    /** Load the banks listed for a game world's map */
+    void HandlePostWorldInitialization(UWorld *World, const UWorld::InitializationValues IVS);
+
+    /** Drop occlusion traces for components in a world that is being torn down */
+    void HandleWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources);
+
     /** The studio system handle. */
     FMOD::Studio::System *StudioSystem[EFMODSystemContext::Max];
     FMOD::Studio::EventInstance *AuditioningInstance;
@@ -271,12 +370,19 @@ public:
     /** Table of assets with name and guid */
     FFMODAssetTable AssetTable;
 
-    /** Periodically checks for updates of the strings.bank file */
+    /** Watches the bank directory for banks rebuilt by Studio */
     FFMODBankUpdateNotifier BankUpdateNotifier;
 
     /** List of failed bank files */
     TArray<FString> FailedBankLoads[EFMODSystemContext::Max];
 
+    /** Banks loaded into each system, keyed by full file path */
+    TMap<FString, FMOD::Studio::Bank *> LoadedBankFiles[EFMODSystemContext::Max];
+
+    /** Event descriptions cached on event assets are only used while their generation matches their system's */
+    uint32 SystemGeneration[EFMODSystemContext::Max];
+    uint32 NextSystemGeneration;
+
     /** List of required plugins we found when loading banks. */
     TArray<FString> RequiredPlugins;
 
@@ -289,8 +395,14 @@ public:
     FFMODListener Listeners[MAX_LISTENERS];
     int ListenerCount;
 
+    /** Audio volume last resolved for each listener */
+    FFMODAudioVolumeCacheEntry ListenerVolumes[MAX_LISTENERS];
+
+    /** Listener of the editor system, which follows the level viewport */
+    FFMODListener EditorListener;
+
     /** Current snapshot applied via reverb zones*/
-    TArray<FFMODSnapshotEntry> ReverbSnapshots;
+    TMap<UFMODSnapshotReverb *, FFMODSnapshotEntry> ReverbSnapshots;
 
     /** True if simulating */
     bool bSimulating;
@@ -301,7 +413,7 @@ public:
     /** True if we want sound enabled */
     bool bUseSound;
 
-    /** True if we the listener has moved and may have changed audio settings*/
+    /** True if we the listener has moved and may have changed audio settings, cleared once the emitters have been updated */
     bool bListenerMoved;
 
     /** True if we allow live update */
@@ -321,6 +433,36 @@ public:
     void *MemPool;
 
     bool bLoadAllSampleData;
+
+    /** Components waiting for an occlusion trace or with one in flight */
+    FFMODOcclusionQueue OcclusionQueue;
+
+    FTraceDelegate OcclusionTraceDelegate;
+
+    /** Cached audio volume lookups shared by listeners and emitters */
+    FFMODAudioVolumeCache AudioVolumeCache;
+
+    /** Updates all playing audio components */
+    FFMODEmitterManager EmitterManager;
+
+    /** Recycled instances and components for one-shots */
+    FFMODEventPool EventPool;
+
+    /** Streams runtime banks in over several frames */
+    FFMODBankLoader BankLoader;
+
+    /** Bus, VCA and global parameter handles looked up in the runtime system */
+    FFMODHandleCache HandleCache;
+
+    /** Programmer sounds shared between runtime event instances */
+    FFMODProgrammerSoundCache ProgrammerSoundCache;
+
+    /** Samples the runtime system's CPU, memory and channel stats */
+    FFMODStatsCollector StatsCollector;
+
+    /** Studio API calls made by the hot paths, which pass straight to FMOD unless a test has replaced them */
+    FFMODStudioCalls DefaultStudioCalls;
+    FFMODStudioCalls *StudioCalls;
 };
 
 IMPLEMENT_MODULE(FFMODStudioModule, FMODStudio)
@@ -521,6 +663,8 @@ void FFMODStudioModule::StartupModule()
         }
     }
 
+    OcclusionTraceDelegate.BindRaw(this, &FFMODStudioModule::OnOcclusionTraceDone);
+
     OnTick = FTickerDelegate::CreateRaw(this, &FFMODStudioModule::Tick);
     TickDelegateHandle = FTicker::GetCoreTicker().AddTicker(OnTick);
 
@@ -528,6 +672,9 @@ void FFMODStudioModule::StartupModule()
     {
         BankUpdateNotifier.BanksUpdatedEvent.AddRaw(this, &FFMODStudioModule::HandleBanksUpdated);
     }
+
+    FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FFMODStudioModule::HandlePostWorldInitialization);
+    FWorldDelegates::OnWorldCleanup.AddRaw(this, &FFMODStudioModule::HandleWorldCleanup);
 }
 
 inline FMOD_SPEAKERMODE ConvertSpeakerMode(EFMODSpeakerMode::Type Mode)
@@ -703,12 +850,36 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
 
         MediaModule->GetClock().AddSink(ClockSinks[Type].ToSharedRef());
     }
+
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        BankLoader.Reset(StudioSystem[Type]);
+        HandleCache.Reset(StudioSystem[Type]);
+        ProgrammerSoundCache.Reset(StudioSystem[Type]);
+    }
 }
 
 void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
 {
     UE_LOG(LogFMOD, Verbose, TEXT("DestroyStudioSystem for context %s"), FMODSystemContextNames[Type]);
 
+    // Pools are keyed by event description, which doesn't outlive the system
+    EventPool.ResetInstances();
+
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        BankLoader.Reset(nullptr);
+        HandleCache.Reset(nullptr);
+        ProgrammerSoundCache.Reset(nullptr);
+        StatsCollector.Reset();
+        ResetInterpolation();
+    }
+    else if (Type == EFMODSystemContext::Editor)
+    {
+        // A new system starts with default listener attributes
+        EditorListener = FFMODListener();
+    }
+
     if (ClockSinks[Type].IsValid())
     {
         // Calling through the shared ptr enforces thread safety with the media clock
@@ -780,6 +951,8 @@ void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
         verifyfmod(StudioSystem[Type]->release());
         StudioSystem[Type] = nullptr;
     }
+    LoadedBankFiles[Type].Reset();
+    InvalidateEventDescriptions(Type);
 }
 
 bool FFMODStudioModule::Tick(float DeltaTime)
@@ -789,28 +962,31 @@ bool FFMODStudioModule::Tick(float DeltaTime)
         BankUpdateNotifier.Update();
     }
 
+    {
+        SCOPE_CYCLE_COUNTER(STAT_FMOD_EmitterUpdate);
+        EmitterManager.Update(bListenerMoved);
+        bListenerMoved = false;
+        SET_DWORD_STAT(STAT_FMOD_Emitters, EmitterManager.Num());
+        SET_DWORD_STAT(STAT_FMOD_VirtualEmitters, EmitterManager.NumVirtual());
+        SET_DWORD_STAT(STAT_FMOD_EmitterListenerUpdates, EmitterManager.NumListenerUpdates());
+    }
+
+    EventPool.Update();
+    UpdatePoolStats();
+
+    UpdateOcclusion();
+
+    BankLoader.Update();
+
+    ProgrammerSoundCache.Update();
+
     if (ClockSinks[EFMODSystemContext::Auditioning].IsValid())
     {
         verifyfmod(ClockSinks[EFMODSystemContext::Auditioning]->LastResult);
     }
     if (ClockSinks[EFMODSystemContext::Runtime].IsValid())
     {
-        FMOD_STUDIO_CPU_USAGE Usage = {};
-        StudioSystem[EFMODSystemContext::Runtime]->getCPUUsage(&Usage);
-        SET_FLOAT_STAT(STAT_FMOD_CPUMixer, Usage.dspusage);
-        SET_FLOAT_STAT(STAT_FMOD_CPUStudio, Usage.studiousage);
-
-        int currentAlloc, maxAlloc;
-        FMOD::Memory_GetStats(&currentAlloc, &maxAlloc, false);
-        SET_MEMORY_STAT(STAT_FMOD_Current_Memory, currentAlloc);
-        SET_MEMORY_STAT(STAT_FMOD_Max_Memory, maxAlloc);
-
-        int channels, realChannels;
-        FMOD::System *lowlevel;
-        StudioSystem[EFMODSystemContext::Runtime]->getCoreSystem(&lowlevel);
-        lowlevel->getChannelsPlaying(&channels, &realChannels);
-        SET_DWORD_STAT(STAT_FMOD_Real_Channels, realChannels);
-        SET_DWORD_STAT(STAT_FMOD_Total_Channels, channels);
+        UpdateSystemStats();
 
         verifyfmod(ClockSinks[EFMODSystemContext::Runtime]->LastResult);
     }
@@ -821,10 +997,71 @@ bool FFMODStudioModule::Tick(float DeltaTime)
     return true;
 }
 
+void FFMODStudioModule::HandlePostWorldInitialization(UWorld *World, const UWorld::InitializationValues IVS)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (Settings.bStreamBankLoading && World && World->IsGameWorld())
+    {
+        BankLoader.SetMap(UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()));
+    }
+}
+
+void FFMODStudioModule::HandleWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources)
+{
+    OcclusionQueue.RemoveWorld(World);
+}
+
+void FFMODStudioModule::UpdateSystemStats()
+{
+#if STATS
+    const bool bStatsViewed = FThreadStats::IsCollectingData(GET_STATID(STAT_FMOD_CPUMixer));
+#else
+    const bool bStatsViewed = false;
+#endif
+    StatsCollector.Update(StudioSystem[EFMODSystemContext::Runtime], bStatsViewed);
+    if (!bStatsViewed || StatsCollector.NumSamples() == 0)
+    {
+        return;
+    }
+
+    // Counter stats are cleared every frame, so the latest sample is published every frame, not just when it is taken
+
+    const FFMODStatsSample &Sample = StatsCollector.GetLatest();
+    SET_FLOAT_STAT(STAT_FMOD_CPUMixer, Sample.DSPUsage);
+    SET_FLOAT_STAT(STAT_FMOD_CPUStudio, Sample.StudioUsage);
+    SET_MEMORY_STAT(STAT_FMOD_Current_Memory, Sample.CurrentMemory);
+    SET_MEMORY_STAT(STAT_FMOD_Max_Memory, Sample.MaxMemory);
+    SET_DWORD_STAT(STAT_FMOD_Real_Channels, Sample.RealChannels);
+    SET_DWORD_STAT(STAT_FMOD_Total_Channels, Sample.Channels);
+
+    const FFMODStatsSummary &Summary = StatsCollector.GetSummary();
+    SET_FLOAT_STAT(STAT_FMOD_CPUMixer_P95, Summary.DSPUsage.P95);
+    SET_FLOAT_STAT(STAT_FMOD_CPUStudio_P95, Summary.StudioUsage.P95);
+}
+
+void FFMODStudioModule::UpdatePoolStats()
+{
+    const FFMODEventPoolStats &Stats = EventPool.GetStats();
+    const uint32 Requests = Stats.InstancesCreated + Stats.InstancesReused + Stats.InstancesStolen;
+    SET_DWORD_STAT(STAT_FMOD_InstancePool_Created, Stats.InstancesCreated);
+    SET_DWORD_STAT(STAT_FMOD_InstancePool_Reused, Stats.InstancesReused);
+    SET_DWORD_STAT(STAT_FMOD_InstancePool_Stolen, Stats.InstancesStolen);
+    SET_DWORD_STAT(STAT_FMOD_InstancePool_Released, Stats.InstancesReleased);
+    SET_FLOAT_STAT(STAT_FMOD_InstancePool_HitRate, Requests > 0 ? 100.0f * (Requests - Stats.InstancesCreated) / Requests : 0.0f);
+    SET_DWORD_STAT(STAT_FMOD_ComponentPool_Created, Stats.ComponentsCreated);
+    SET_DWORD_STAT(STAT_FMOD_ComponentPool_Reused, Stats.ComponentsReused);
+
+    const FFMODProgrammerSoundStats &SoundStats = ProgrammerSoundCache.GetStats();
+    SET_DWORD_STAT(STAT_FMOD_ProgrammerSounds_Created, SoundStats.SoundsCreated);
+    SET_DWORD_STAT(STAT_FMOD_ProgrammerSounds_Reused, SoundStats.SoundsReused);
+    SET_DWORD_STAT(STAT_FMOD_ProgrammerSounds_Evicted, SoundStats.SoundsEvicted);
+}
+
 void FFMODStudioModule::UpdateListeners()
 {
+    SCOPE_CYCLE_COUNTER(STAT_FMOD_ListenerUpdate);
+
     int ListenerIndex = 0;
-    bListenerMoved = false;
 
 #if WITH_EDITOR
     if (bSimulating)
@@ -893,6 +1130,41 @@ void FFMODStudioModule::UpdateWorldListeners(UWorld *World, int *ListenerIndex)
     }
 }
 
+void FFMODStudioModule::RequestOcclusionTrace(UFMODAudioComponent *Component)
+{
+    OcclusionQueue.Add(Component);
+}
+
+void FFMODStudioModule::UpdateOcclusion()
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
+
+    int32 TraceCount = OcclusionQueue.Update(Settings.OcclusionTracesPerFrame, [this](UFMODAudioComponent &Component, uint32 TraceId) {
+        if (!Component.GetOwner() || !Component.GetWorld())
+        {
+            return false;
+        }
+
+        FCollisionQueryParams Params(NAME_SoundOcclusion, Component.OcclusionDetails.bUseComplexCollisionForOcclusion, Component.GetOwner());
+        const FVector &Location = Component.GetOwner()->GetTransform().GetTranslation();
+        const FFMODListener &Listener = GetNearestListener(Location);
+
+        Component.GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Test, Location, Listener.Transform.GetLocation(),
+            Component.OcclusionDetails.OcclusionTraceChannel, Params, FCollisionResponseParams::DefaultResponseParam,
+            &OcclusionTraceDelegate, TraceId);
+        return true;
+    });
+
+    SET_DWORD_STAT(STAT_FMOD_Occlusion_Traces, TraceCount);
+    SET_DWORD_STAT(STAT_FMOD_Occlusion_Queue, OcclusionQueue.NumQueued());
+}
+
+void FFMODStudioModule::OnOcclusionTraceDone(const FTraceHandle &Handle, FTraceDatum &Datum)
+{
+    OcclusionQueue.Complete(Datum.UserData, Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit);
+}
+
 bool FFMODStudioModule::HasListenerMoved()
 {
     return bListenerMoved;
@@ -922,6 +1194,49 @@ const FFMODListener &FFMODStudioModule::GetNearestListener(const FVector &Locati
     return Listeners[BestListener];
 }
 
+/** Listener movement smaller than this, in UE units, isn't passed on to FMOD */
+static const float LISTENER_MOVE_EPSILON = 0.1f;
+
+/** Listener rotation smaller than this isn't passed on to FMOD */
+static const float LISTENER_ROTATION_EPSILON = 1.e-4f;
+
+/** Pass a listener's new transform to FMOD, returns false if it hasn't moved enough to be worth updating */
+static bool UpdateListenerAttributes(FFMODStudioCalls &Calls, FMOD::Studio::System *System, int ListenerIndex, FFMODListener &Listener,
+    const FTransform &ListenerTransform, float DeltaSeconds)
+{
+    // Callers without a world delta, such as the editor viewport, use the application's frame time
+    Listener.PendingDeltaSeconds += DeltaSeconds > 0.f ? DeltaSeconds : FApp::GetDeltaTime();
+
+    const FVector Offset = ListenerTransform.GetTranslation() - Listener.Transform.GetTranslation();
+    const bool bMoved = Offset.SizeSquared() > FMath::Square(LISTENER_MOVE_EPSILON) ||
+                        !Listener.Transform.GetRotation().Equals(ListenerTransform.GetRotation(), LISTENER_ROTATION_EPSILON);
+    if (Listener.bAttributesSet && !bMoved && Listener.Velocity.IsZero())
+    {
+        return false;
+    }
+
+    // Velocity covers every frame since the last update, so movement too small to pass on still counts, and drops to zero when still
+    Listener.Velocity = (Listener.bAttributesSet && bMoved && Listener.PendingDeltaSeconds > 0.f) ? Offset / Listener.PendingDeltaSeconds :
+                                                                                                     FVector::ZeroVector;
+    Listener.PendingDeltaSeconds = 0.f;
+    Listener.Transform = ListenerTransform;
+    Listener.bAttributesSet = true;
+
+    // We are using a direct copy of the inbuilt transforms but the directions come out wrong.
+    // Several of the audio functions use GetFront() for right, so we do the same here.
+    const FVector Up = Listener.GetUp();
+    const FVector Right = Listener.GetFront();
+    const FVector Forward = Right ^ Up;
+
+    FMOD_3D_ATTRIBUTES Attributes = { { 0 } };
+    Attributes.position = FMODUtils::ConvertWorldVector(ListenerTransform.GetTranslation());
+    Attributes.forward = FMODUtils::ConvertUnitVector(Forward);
+    Attributes.up = FMODUtils::ConvertUnitVector(Up);
+    Attributes.velocity = FMODUtils::ConvertWorldVector(Listener.Velocity);
+    verifyfmod(Calls.SetListenerAttributes(System, ListenerIndex, Attributes));
+    return true;
+}
+
 // Partially copied from FAudioDevice::SetListener
 void FFMODStudioModule::SetListenerPosition(int ListenerIndex, UWorld *World, const FTransform &ListenerTransform, float DeltaSeconds)
 {
@@ -933,36 +1248,39 @@ void FFMODStudioModule::SetListenerPosition(int ListenerIndex, UWorld *World, co
         {
             Listeners[ListenerIndex] = FFMODListener();
             ListenerCount = ListenerIndex + 1;
-            verifyfmod(System->setNumListeners(ListenerCount));
+            verifyfmod(StudioCalls->SetNumListeners(System, ListenerCount));
+            bListenerMoved = true;
         }
 
         FVector ListenerPos = ListenerTransform.GetTranslation();
 
         FInteriorSettings *InteriorSettings =
             (FInteriorSettings *)alloca(sizeof(FInteriorSettings)); // FinteriorSetting::FInteriorSettings() isn't exposed (possible UE4 bug???)
-        AAudioVolume *Volume = World->GetAudioSettings(ListenerPos, NULL, InteriorSettings);
+        AAudioVolume *Volume = AudioVolumeCache.GetAudioSettings(World, ListenerPos, ListenerVolumes[ListenerIndex], InteriorSettings);
 
-        Listeners[ListenerIndex].Velocity =
-            DeltaSeconds > 0.f ? (ListenerTransform.GetTranslation() - Listeners[ListenerIndex].Transform.GetTranslation()) / DeltaSeconds :
-                                 FVector::ZeroVector;
+        Listeners[ListenerIndex].ApplyInteriorSettings(Volume, *InteriorSettings);
 
-        Listeners[ListenerIndex].Transform = ListenerTransform;
+        if (UpdateListenerAttributes(*StudioCalls, System, ListenerIndex, Listeners[ListenerIndex], ListenerTransform, DeltaSeconds))
+        {
+            bListenerMoved = true;
+        }
+    }
+}
 
-        Listeners[ListenerIndex].ApplyInteriorSettings(Volume, *InteriorSettings);
+void FFMODStudioModule::UpdateViewportListener(UWorld *World, const FTransform &ViewTransform)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FMOD_ListenerUpdate);
 
-        // We are using a direct copy of the inbuilt transforms but the directions come out wrong.
-        // Several of the audio functions use GetFront() for right, so we do the same here.
-        const FVector Up = Listeners[ListenerIndex].GetUp();
-        const FVector Right = Listeners[ListenerIndex].GetFront();
-        const FVector Forward = Right ^ Up;
-
-        FMOD_3D_ATTRIBUTES Attributes = { { 0 } };
-        Attributes.position = FMODUtils::ConvertWorldVector(ListenerPos);
-        Attributes.forward = FMODUtils::ConvertUnitVector(Forward);
-        Attributes.up = FMODUtils::ConvertUnitVector(Up);
-        Attributes.velocity = FMODUtils::ConvertWorldVector(Listeners[ListenerIndex].Velocity);
-        verifyfmod(System->setListenerAttributes(ListenerIndex, &Attributes));
-        bListenerMoved = true;
+    if (StudioSystem[EFMODSystemContext::Editor])
+    {
+        UpdateListenerAttributes(*StudioCalls, StudioSystem[EFMODSystemContext::Editor], 0, EditorListener, ViewTransform, 0.f);
+    }
+
+    // In PIE the runtime listeners follow the player controllers instead
+    if (bSimulating)
+    {
+        SetListenerPosition(0, World, ViewTransform, 0.f);
+        FinishSetListenerPosition(1);
     }
 }
 
@@ -977,7 +1295,8 @@ void FFMODStudioModule::FinishSetListenerPosition(int NumListeners)
     if (System && NumListeners < ListenerCount)
     {
         ListenerCount = NumListeners;
-        verifyfmod(System->setNumListeners(ListenerCount));
+        verifyfmod(StudioCalls->SetNumListeners(System, ListenerCount));
+        bListenerMoved = true;
     }
 
     for (int i = 0; i < ListenerCount; ++i)
@@ -1005,72 +1324,79 @@ void FFMODStudioModule::FinishSetListenerPosition(int NumListeners)
 
     if (NewSnapshot != nullptr)
     {
-        FString NewSnapshotName = FMODUtils::LookupNameFromGuid(System, NewSnapshot->AssetGuid);
-        UE_LOG(LogFMOD, Verbose, TEXT("Starting new snapshot '%s'"), *NewSnapshotName);
-
-        // Try to steal old entry
-        FFMODSnapshotEntry SnapshotEntry;
-        int SnapshotEntryIndex = -1;
-        for (int i = 0; i < ReverbSnapshots.Num(); ++i)
+        FFMODSnapshotEntry *SnapshotEntry = ReverbSnapshots.Find(NewSnapshot);
+        if (SnapshotEntry)
         {
-            if (ReverbSnapshots[i].Snapshot == NewSnapshot)
-            {
-                UE_LOG(LogFMOD, Verbose, TEXT("Re-using old entry with intensity %f"), ReverbSnapshots[i].CurrentIntensity());
-                SnapshotEntryIndex = i;
-                break;
-            }
+            UE_LOG(LogFMOD, Verbose, TEXT("Re-using old entry with intensity %f"), SnapshotEntry->CurrentIntensity());
         }
         // Create new instance
-        if (SnapshotEntryIndex == -1)
+        else
         {
-            UE_LOG(LogFMOD, Verbose, TEXT("Creating new instance"));
+            if (UE_LOG_ACTIVE(LogFMOD, Verbose))
+            {
+                FString NewSnapshotName = FMODUtils::LookupNameFromGuid(System, NewSnapshot->AssetGuid);
+                UE_LOG(LogFMOD, Verbose, TEXT("Starting new snapshot '%s'"), *NewSnapshotName);
+            }
 
             FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(NewSnapshot->AssetGuid);
             FMOD::Studio::EventInstance *NewInstance = nullptr;
             FMOD::Studio::EventDescription *EventDesc = nullptr;
-            System->getEventByID(&Guid, &EventDesc);
+            StudioCalls->GetEventByID(System, Guid, &EventDesc);
             if (EventDesc)
             {
-                EventDesc->createInstance(&NewInstance);
-                if (NewInstance)
+                StudioCalls->CreateInstance(EventDesc, &NewInstance);
+            }
+
+            SnapshotEntry = &ReverbSnapshots.Add(NewSnapshot, FFMODSnapshotEntry(NewSnapshot, NewInstance));
+            if (NewInstance)
+            {
+                FMOD_STUDIO_PARAMETER_DESCRIPTION Parameter;
+                if (StudioCalls->GetParameterDescriptionByName(EventDesc, "Intensity", &Parameter) == FMOD_OK)
                 {
-                    NewInstance->setParameterByName("Intensity", 0.0f);
-                    NewInstance->start();
+                    SnapshotEntry->IntensityID = Parameter.id;
+                    SnapshotEntry->bHasIntensityID = true;
+                    StudioCalls->SetParameterByID(NewInstance, SnapshotEntry->IntensityID, 0.0f);
+                    SnapshotEntry->AppliedIntensity = 0.0f;
                 }
+                StudioCalls->Start(NewInstance);
             }
-
-            SnapshotEntryIndex = ReverbSnapshots.Num();
-            ReverbSnapshots.Push(FFMODSnapshotEntry(NewSnapshot, NewInstance));
         }
         // Fade up
-        if (ReverbSnapshots[SnapshotEntryIndex].FadeIntensityEnd == 0.0f)
+        if (SnapshotEntry->FadeIntensityEnd == 0.0f)
         {
-            ReverbSnapshots[SnapshotEntryIndex].FadeTo(BestVolume->GetReverbSettings().Volume, BestVolume->GetReverbSettings().FadeTime);
+            SnapshotEntry->FadeTo(BestVolume->GetReverbSettings().Volume, BestVolume->GetReverbSettings().FadeTime);
         }
     }
     // Fade out all other entries
-    for (int i = 0; i < ReverbSnapshots.Num(); ++i)
+    for (auto It = ReverbSnapshots.CreateIterator(); It; ++It)
     {
-        UE_LOG(LogFMOD, Verbose, TEXT("Ramping intensity (%f,%f) -> %f"), ReverbSnapshots[i].FadeIntensityStart, ReverbSnapshots[i].FadeIntensityEnd,
-            ReverbSnapshots[i].CurrentIntensity());
-        ReverbSnapshots[i].Instance->setParameterByName("Intensity", 100.0f * ReverbSnapshots[i].CurrentIntensity());
+        FFMODSnapshotEntry &Entry = It.Value();
+        const float Intensity = 100.0f * Entry.CurrentIntensity();
+        if (Entry.bHasIntensityID && Intensity != Entry.AppliedIntensity)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Ramping intensity (%f,%f) -> %f"), Entry.FadeIntensityStart, Entry.FadeIntensityEnd, Entry.CurrentIntensity());
+            StudioCalls->SetParameterByID(Entry.Instance, Entry.IntensityID, Intensity);
+            Entry.AppliedIntensity = Intensity;
+        }
 
-        if (ReverbSnapshots[i].Snapshot != NewSnapshot)
+        if (Entry.Snapshot != NewSnapshot)
         {
             // Start fading out if needed
-            if (ReverbSnapshots[i].FadeIntensityEnd != 0.0f)
+            if (Entry.FadeIntensityEnd != 0.0f)
             {
-                ReverbSnapshots[i].FadeTo(0.0f, ReverbSnapshots[i].FadeDuration);
+                Entry.FadeTo(0.0f, Entry.FadeDuration);
             }
             // Finish fading out and remove
-            else if (ReverbSnapshots[i].CurrentIntensity() == 0.0f)
+            else if (Entry.CurrentIntensity() == 0.0f)
             {
                 UE_LOG(LogFMOD, Verbose, TEXT("Removing snapshot"));
 
-                ReverbSnapshots[i].Instance->stop(FMOD_STUDIO_STOP_ALLOWFADEOUT);
-                ReverbSnapshots[i].Instance->release();
-                ReverbSnapshots.RemoveAt(i);
-                --i; // removed entry, redo current index for next one
+                if (Entry.Instance)
+                {
+                    StudioCalls->Stop(Entry.Instance, FMOD_STUDIO_STOP_ALLOWFADEOUT);
+                    StudioCalls->Release(Entry.Instance);
+                }
+                It.RemoveCurrent();
             }
         }
     }
@@ -1082,7 +1408,7 @@ void FFMODStudioModule::RefreshSettings()
     if (GIsEditor)
     {
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
-        BankUpdateNotifier.SetFilePath(Settings.GetFullBankPath() / AssetTable.GetMasterStringsBankPath());
+        BankUpdateNotifier.SetBankDirectory(Settings.GetFullBankPath());
 
         // Initialize ActiveLocale based on settings
         FString LocaleCode = "";
@@ -1149,6 +1475,8 @@ void FFMODStudioModule::SetInPIE(bool bInPIE, bool simulating)
     else
     {
         ReverbSnapshots.Reset();
+        OcclusionQueue.Reset();
+        EventPool.Reset();
         DestroyStudioSystem(EFMODSystemContext::Runtime);
         flags = FMOD_DEBUG_LEVEL_WARNING;
     }
@@ -1223,6 +1551,7 @@ void FFMODStudioModule::ShutdownModule()
 {
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioModule shutdown"));
 
+    EventPool.Reset();
     DestroyStudioSystem(EFMODSystemContext::Auditioning);
     DestroyStudioSystem(EFMODSystemContext::Runtime);
     DestroyStudioSystem(EFMODSystemContext::Editor);
@@ -1240,6 +1569,9 @@ void FFMODStudioModule::ShutdownModule()
         BankUpdateNotifier.BanksUpdatedEvent.RemoveAll(this);
     }
 
+    FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
+    FWorldDelegates::OnWorldCleanup.RemoveAll(this);
+
     if (UObjectInitialized())
     {
         // Unregister tick function.
@@ -1302,6 +1634,8 @@ bool FFMODStudioModule::SetLocale(const FString& LocaleName)
 
 void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
 {
+    SCOPE_CYCLE_COUNTER(STAT_FMOD_LoadBanks);
+
     const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
 
     FailedBankLoads[Type].Reset();
@@ -1337,7 +1671,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
         {
             FString MasterBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterBankPath();
             UE_LOG(LogFMOD, Verbose, TEXT("Loading master bank: %s"), *MasterBankPath);
-            Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterBankPath), BankFlags, &MasterBank);
+            Result = StudioCalls->LoadBankFile(StudioSystem[Type], TCHAR_TO_UTF8(*MasterBankPath), BankFlags, &MasterBank);
             BankEntries.Add(NamedBankEntry(MasterBankPath, MasterBank, Result));
         }
 
@@ -1347,7 +1681,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
             FString MasterAssetsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterAssetsBankPath();
             if (FPaths::FileExists(MasterAssetsBankPath))
             {
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterAssetsBankPath), BankFlags, &MasterAssetsBank);
+                Result = StudioCalls->LoadBankFile(StudioSystem[Type], TCHAR_TO_UTF8(*MasterAssetsBankPath), BankFlags, &MasterAssetsBank);
                 BankEntries.Add(NamedBankEntry(MasterAssetsBankPath, MasterAssetsBank, Result));
             }
         }
@@ -1361,7 +1695,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                 FString StringsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterStringsBankPath();
                 UE_LOG(LogFMOD, Verbose, TEXT("Loading strings bank: %s"), *StringsBankPath);
                 FMOD::Studio::Bank *StringsBank = nullptr;
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*StringsBankPath), BankFlags, &StringsBank);
+                Result = StudioCalls->LoadBankFile(StudioSystem[Type], TCHAR_TO_UTF8(*StringsBankPath), BankFlags, &StringsBank);
                 BankEntries.Add(NamedBankEntry(StringsBankPath, StringsBank, Result));
             }
 
@@ -1378,10 +1712,16 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                         UE_LOG(LogFMOD, Log, TEXT("Skipping bank: %s"), *OtherFile);
                         continue;
                     }
+                    if (Type == EFMODSystemContext::Runtime && Settings.bStreamBankLoading)
+                    {
+                        // Loaded over the following frames, after any banks the first map asks for
+                        BankLoader.RequestBank(OtherFile, 0, bLoadSampleData);
+                        continue;
+                    }
                     UE_LOG(LogFMOD, Log, TEXT("Loading bank: %s"), *OtherFile);
 
                     FMOD::Studio::Bank *OtherBank;
-                    Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*OtherFile), BankFlags, &OtherBank);
+                    Result = StudioCalls->LoadBankFile(StudioSystem[Type], TCHAR_TO_UTF8(*OtherFile), BankFlags, &OtherBank);
                     BankEntries.Add(NamedBankEntry(OtherFile, OtherBank, Result));
                 }
             }
@@ -1407,60 +1747,171 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
         }
 
         // Wait for all banks to load.
-        StudioSystem[Type]->flushCommands();
+        StudioCalls->FlushCommands(StudioSystem[Type]);
+        FinishLoadingBanks(Type, BankEntries, bLoadSampleData);
+    }
+
+    bBanksLoaded = true;
+}
 
-        for (NamedBankEntry &Entry : BankEntries)
+void FFMODStudioModule::FinishLoadingBanks(EFMODSystemContext::Type Type, TArray<NamedBankEntry> &BankEntries, bool bLoadSampleData)
+{
+    for (NamedBankEntry &Entry : BankEntries)
+    {
+        if (Entry.Result == FMOD_OK)
         {
-            if (Entry.Result == FMOD_OK)
+            FMOD_STUDIO_LOADING_STATE BankLoadingState = FMOD_STUDIO_LOADING_STATE_ERROR;
+            Entry.Result = StudioCalls->GetLoadingState(Entry.Bank, &BankLoadingState);
+            if (BankLoadingState == FMOD_STUDIO_LOADING_STATE_ERROR)
             {
-                FMOD_STUDIO_LOADING_STATE BankLoadingState = FMOD_STUDIO_LOADING_STATE_ERROR;
-                Entry.Result = Entry.Bank->getLoadingState(&BankLoadingState);
-                if (BankLoadingState == FMOD_STUDIO_LOADING_STATE_ERROR)
-                {
-                    Entry.Bank->unload();
-                    Entry.Bank = nullptr;
-                }
-                else if (bLoadSampleData)
-                {
-                    verifyfmod(Entry.Bank->loadSampleData());
-                }
+                StudioCalls->Unload(Entry.Bank);
+                Entry.Bank = nullptr;
             }
-            if (Entry.Bank == nullptr || Entry.Result != FMOD_OK)
+            else
             {
-                FString ErrorMessage;
-                if (!FPaths::FileExists(Entry.Name))
-                {
-                    ErrorMessage = "File does not exist";
-                }
-                else
+                LoadedBankFiles[Type].Add(Entry.Name, Entry.Bank);
+
+                if (bLoadSampleData)
                 {
-                    ErrorMessage = UTF8_TO_TCHAR(FMOD_ErrorString(Entry.Result));
+                    verifyfmod(StudioCalls->LoadSampleData(Entry.Bank));
                 }
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank: %s (%s)"), *Entry.Name, *ErrorMessage);
-                FailedBankLoads[Type].Add(FString::Printf(TEXT("%s (%s)"), *FPaths::GetBaseFilename(Entry.Name), *ErrorMessage));
             }
         }
+        if (Entry.Bank == nullptr || Entry.Result != FMOD_OK)
+        {
+            FString ErrorMessage;
+            if (!FPaths::FileExists(Entry.Name))
+            {
+                ErrorMessage = "File does not exist";
+            }
+            else
+            {
+                ErrorMessage = UTF8_TO_TCHAR(FMOD_ErrorString(Entry.Result));
+            }
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank: %s (%s)"), *Entry.Name, *ErrorMessage);
+            FailedBankLoads[Type].Add(FString::Printf(TEXT("%s (%s)"), *FPaths::GetBaseFilename(Entry.Name), *ErrorMessage));
+        }
     }
-
-    bBanksLoaded = true;
 }
 
-void FFMODStudioModule::HandleBanksUpdated()
+void FFMODStudioModule::HandleBanksUpdated(const TSet<FString> &NotifiedFiles)
 {
+    SCOPE_CYCLE_COUNTER(STAT_FMOD_BankReload);
+
     UE_LOG(LogFMOD, Verbose, TEXT("Refreshing auditioning system"));
 
-    DestroyStudioSystem(EFMODSystemContext::Auditioning);
+    double StartTime = FPlatformTime::Seconds();
+
+    // The auditioned event may be in one of the banks being replaced
+    StopAuditioningInstance();
 
     AssetTable.Refresh();
+    TSet<FString> ChangedFiles = AssetTable.GetChangedBankFiles();
 
-    CreateStudioSystem(EFMODSystemContext::Auditioning);
-    LoadBanks(EFMODSystemContext::Auditioning);
+    // Banks rewritten without a change in size or timestamp still need reloading, the watcher reports full paths
+    TArray<FString> BankFiles;
+    AssetTable.GetAllBankPaths(BankFiles, true);
+    for (const FString &File : BankFiles)
+    {
+        if (NotifiedFiles.Contains(FPaths::ConvertRelativePathToFull(File)))
+        {
+            ChangedFiles.Add(File);
+        }
+    }
 
-    DestroyStudioSystem(EFMODSystemContext::Editor);
-    CreateStudioSystem(EFMODSystemContext::Editor);
-    LoadBanks(EFMODSystemContext::Editor);
+    double RefreshTime = FPlatformTime::Seconds();
+    ReloadChangedBanks(EFMODSystemContext::Auditioning, ChangedFiles);
+    double AuditioningTime = FPlatformTime::Seconds();
+    ReloadChangedBanks(EFMODSystemContext::Editor, ChangedFiles);
+    double EditorTime = FPlatformTime::Seconds();
 
     BanksReloadedDelegate.Broadcast();
+
+    UE_LOG(LogFMOD, Log, TEXT("Banks updated in %.1f ms: asset table %.1f ms, auditioning %.1f ms, editor %.1f ms, notify %.1f ms (%d files changed)"),
+        (FPlatformTime::Seconds() - StartTime) * 1000.0, (RefreshTime - StartTime) * 1000.0, (AuditioningTime - RefreshTime) * 1000.0,
+        (EditorTime - AuditioningTime) * 1000.0, (FPlatformTime::Seconds() - EditorTime) * 1000.0, ChangedFiles.Num());
+}
+
+void FFMODStudioModule::ReloadChangedBanks(EFMODSystemContext::Type Type, const TSet<FString> &ChangedFiles)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    // The master banks define the mixer, so changes to them still need a new system
+    bool bRecreate = (StudioSystem[Type] == nullptr);
+    for (const FString &File : ChangedFiles)
+    {
+        FString Filename = FPaths::GetCleanFilename(File);
+        if (Filename == Settings.GetMasterBankFilename() || Filename == Settings.GetMasterStringsBankFilename() ||
+            Filename == Settings.GetMasterAssetsBankFilename())
+        {
+            bRecreate = true;
+            break;
+        }
+    }
+
+    if (bRecreate)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Recreating system for context %s"), FMODSystemContextNames[Type]);
+        DestroyStudioSystem(Type);
+        CreateStudioSystem(Type);
+        LoadBanks(Type);
+        return;
+    }
+
+    if (ChangedFiles.Num() == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogFMOD, Verbose, TEXT("Reloading %d changed banks for context %s"), ChangedFiles.Num(), FMODSystemContextNames[Type]);
+
+    // Pooled instances would keep the old events alive, and their descriptions may be reused by the reloaded banks
+    EventPool.ResetInstances();
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        ProgrammerSoundCache.ReleaseAudioTableSounds();
+    }
+
+    for (const FString &File : ChangedFiles)
+    {
+        FMOD::Studio::Bank *Bank = nullptr;
+        if (LoadedBankFiles[Type].RemoveAndCopyValue(File, Bank))
+        {
+            StudioCalls->Unload(Bank);
+        }
+
+        // Forget earlier failures for this file, it gets another chance below
+        FString FailurePrefix = FPaths::GetBaseFilename(File) + TEXT(" (");
+        FailedBankLoads[Type].RemoveAll([&FailurePrefix](const FString &Failure) { return Failure.StartsWith(FailurePrefix); });
+    }
+
+    // Make sure the old banks are gone before loading their replacements
+    StudioCalls->FlushCommands(StudioSystem[Type]);
+    InvalidateEventDescriptions(Type);
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        HandleCache.Reset(StudioSystem[Type]);
+    }
+
+    TArray<FString> BankFiles;
+    AssetTable.GetAllBankPaths(BankFiles, false);
+    TArray<NamedBankEntry> BankEntries;
+
+    for (const FString &File : BankFiles)
+    {
+        if (!ChangedFiles.Contains(File) || (Settings.SkipLoadBankName.Len() && File.Contains(Settings.SkipLoadBankName)))
+        {
+            continue;
+        }
+        UE_LOG(LogFMOD, Log, TEXT("Loading bank: %s"), *File);
+
+        FMOD::Studio::Bank *Bank = nullptr;
+        FMOD_RESULT Result = StudioCalls->LoadBankFile(StudioSystem[Type], TCHAR_TO_UTF8(*File), FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &Bank);
+        BankEntries.Add(NamedBankEntry(File, Bank, Result));
+    }
+
+    StudioCalls->FlushCommands(StudioSystem[Type]);
+    FinishLoadingBanks(Type, BankEntries, false);
 }
 
 FMOD::Studio::System *FFMODStudioModule::GetStudioSystem(EFMODSystemContext::Type Context)
@@ -1473,19 +1924,65 @@ FMOD::Studio::System *FFMODStudioModule::GetStudioSystem(EFMODSystemContext::Typ
 }
 
 FMOD::Studio::EventDescription *FFMODStudioModule::GetEventDescription(const UFMODEvent *Event, EFMODSystemContext::Type Context)
+{
+    const FFMODEventDescriptionInfo *Info = GetEventDescriptionInfo(Event, Context);
+    return Info ? Info->Description : nullptr;
+}
+
+const FFMODEventDescriptionInfo *FFMODStudioModule::GetEventDescriptionInfo(const UFMODEvent *Event, EFMODSystemContext::Type Context)
 {
     if (Context == EFMODSystemContext::Max)
     {
         Context = (bIsInPIE ? EFMODSystemContext::Runtime : EFMODSystemContext::Auditioning);
     }
-    if (StudioSystem[Context] != nullptr && IsValid(Event) && Event->AssetGuid.IsValid())
+    if (StudioSystem[Context] == nullptr || !IsValid(Event) || !Event->AssetGuid.IsValid())
     {
-        FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Event->AssetGuid);
-        FMOD::Studio::EventDescription *EventDesc = nullptr;
-        StudioSystem[Context]->getEventByID(&Guid, &EventDesc);
-        return EventDesc;
+        return nullptr;
     }
-    return nullptr;
+
+    // Banks can also be unloaded without a new generation, e.g. by the bank loader, which invalidates the handle
+    FFMODEventDescriptionInfo &Info = Event->GetDescriptionInfo(Context);
+    if (Info.Generation == SystemGeneration[Context] && Info.Description && Info.Description->isValid())
+    {
+        INC_DWORD_STAT(STAT_FMOD_EventDescription_Hits);
+        return &Info;
+    }
+    INC_DWORD_STAT(STAT_FMOD_EventDescription_Misses);
+
+    FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Event->AssetGuid);
+    FMOD::Studio::EventDescription *EventDesc = nullptr;
+    if (StudioSystem[Context]->getEventByID(&Guid, &EventDesc) != FMOD_OK || EventDesc == nullptr)
+    {
+        // Not cached, the event's bank may still be loading
+        Info.Generation = 0;
+        return nullptr;
+    }
+
+    Info.Description = EventDesc;
+    Info.Generation = SystemGeneration[Context];
+    EventDesc->is3D(&Info.bIs3D);
+    EventDesc->isOneshot(&Info.bOneshot);
+    EventDesc->getMinimumDistance(&Info.MinimumDistance);
+    EventDesc->getMaximumDistance(&Info.MaximumDistance);
+    EventDesc->getLength(&Info.Length);
+
+    int ParameterCount = 0;
+    EventDesc->getParameterDescriptionCount(&ParameterCount);
+    Info.Parameters.SetNumUninitialized(ParameterCount);
+    Info.ParameterIDs.Reset();
+    for (int ParameterIndex = 0; ParameterIndex < ParameterCount; ++ParameterIndex)
+    {
+        FMOD_STUDIO_PARAMETER_DESCRIPTION &ParameterDescription = Info.Parameters[ParameterIndex];
+        EventDesc->getParameterDescriptionByIndex(ParameterIndex, &ParameterDescription);
+        Info.ParameterIDs.Add(FName(UTF8_TO_TCHAR(ParameterDescription.name)), ParameterDescription.id);
+    }
+    return &Info;
+}
+
+void FFMODStudioModule::InvalidateEventDescriptions(EFMODSystemContext::Type Type)
+{
+    // Generations are unique across systems, so a description cached from a destroyed system can never match again
+    SystemGeneration[Type] = ++NextSystemGeneration;
 }
 
 FMOD::Studio::EventInstance *FFMODStudioModule::CreateAuditioningInstance(const UFMODEvent *Event)
@@ -5,5 +5,17 @@
 #include "UObject/NoExportTypes.h"
 #include "Components/SceneComponent.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "Stats/Stats.h"
 
-DECLARE_LOG_CATEGORY_EXTERN(LogFMOD, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogFMOD, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("FMOD"), STATGROUP_FMOD, STATCAT_Advanced);
+
+// Game thread cost of the plugin's hot paths, defined in FMODStudioModule.cpp
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FMOD Play"), STAT_FMOD_Play, STATGROUP_FMOD, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FMOD Attenuation Update"), STAT_FMOD_AttenuationUpdate, STATGROUP_FMOD, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FMOD Listener Update"), STAT_FMOD_ListenerUpdate, STATGROUP_FMOD, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FMOD Load Banks"), STAT_FMOD_LoadBanks, STATGROUP_FMOD, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FMOD Bank Reload"), STAT_FMOD_BankReload, STATGROUP_FMOD, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FMOD Sequencer Control"), STAT_FMOD_SequencerControl, STATGROUP_FMOD, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("FMOD Sequencer Parameters"), STAT_FMOD_SequencerParameters, STATGROUP_FMOD, );
\ No newline at end of file
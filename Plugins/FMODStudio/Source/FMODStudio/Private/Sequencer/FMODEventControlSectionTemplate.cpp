@@ -6,6 +6,8 @@
 #include "Evaluation/MovieSceneEvaluation.h"
 #include "IMovieScenePlayer.h"
 
+#include "FMODStudioPrivatePCH.h"
+
 struct FPlayingToken : IMovieScenePreAnimatedToken
 {
     FPlayingToken(UObject &InObject)
@@ -68,6 +70,8 @@ struct FFMODEventControlExecutionToken : IMovieSceneExecutionToken
     virtual void Execute(const FMovieSceneContext &Context, const FMovieSceneEvaluationOperand &Operand, FPersistentEvaluationData &PersistentData,
         IMovieScenePlayer &Player)
     {
+        SCOPE_CYCLE_COUNTER(STAT_FMOD_SequencerControl);
+
         for (TWeakObjectPtr<> &WeakObject : Player.FindBoundObjects(Operand))
         {
             UFMODAudioComponent *AudioComponent = Cast<UFMODAudioComponent>(WeakObject.Get());
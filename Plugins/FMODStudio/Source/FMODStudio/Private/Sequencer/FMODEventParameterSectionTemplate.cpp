@@ -7,6 +7,8 @@
 #include "IMovieScenePlayer.h"
 #include "fmod_studio.hpp"
 
+#include "FMODStudioPrivatePCH.h"
+
 struct FFMODEventParameterPreAnimatedToken : IMovieScenePreAnimatedToken
 {
     FFMODEventParameterPreAnimatedToken() {}
@@ -20,14 +22,12 @@ struct FFMODEventParameterPreAnimatedToken : IMovieScenePreAnimatedToken
 
         if (IsValid(AudioComponent))
         {
-            for (FScalarParameterNameAndValue &Value : Values)
-            {
-                AudioComponent->SetParameter(Value.ParameterName, Value.Value);
-            }
+            AudioComponent->SetParameters(Names, Values);
         }
     }
 
-    TArray<FScalarParameterNameAndValue> Values;
+    TArray<FName> Names;
+    TArray<float> Values;
 };
 
 struct FFMODEventParameterPreAnimatedTokenProducer : IMovieScenePreAnimatedTokenProducer
@@ -38,15 +38,18 @@ struct FFMODEventParameterPreAnimatedTokenProducer : IMovieScenePreAnimatedToken
 
         FFMODEventParameterPreAnimatedToken Token;
 
-        if (IsValid(AudioComponent) && AudioComponent->Event)
+        const FFMODEventDescriptionInfo *EventInfo = IsValid(AudioComponent) && IFMODStudioModule::Get().AreBanksLoaded() ?
+            IFMODStudioModule::Get().GetEventDescriptionInfo(AudioComponent->Event.Get(), EFMODSystemContext::Auditioning) :
+            nullptr;
+        if (EventInfo)
         {
-            TArray<FMOD_STUDIO_PARAMETER_DESCRIPTION> ParameterDescriptions;
-            AudioComponent->Event->GetParameterDescriptions(ParameterDescriptions);
-
-            for (const FMOD_STUDIO_PARAMETER_DESCRIPTION &ParameterDescription : ParameterDescriptions)
+            Token.Names.Reserve(EventInfo->Parameters.Num());
+            Token.Values.Reserve(EventInfo->Parameters.Num());
+            for (const FMOD_STUDIO_PARAMETER_DESCRIPTION &ParameterDescription : EventInfo->Parameters)
             {
-                float Value = AudioComponent->GetParameter(ParameterDescription.name);
-                Token.Values.Add(FScalarParameterNameAndValue(ParameterDescription.name, Value));
+                FName Name(ParameterDescription.name);
+                Token.Names.Add(Name);
+                Token.Values.Add(AudioComponent->GetParameter(Name));
             }
         }
 
@@ -68,6 +71,17 @@ struct FFMODEventParameterExecutionToken : IMovieSceneExecutionToken
     virtual void Execute(const FMovieSceneContext &Context, const FMovieSceneEvaluationOperand &Operand, FPersistentEvaluationData &PersistentData,
         IMovieScenePlayer &Player)
     {
+        SCOPE_CYCLE_COUNTER(STAT_FMOD_SequencerParameters);
+
+        // Split once so every bound component can apply all the curves in one batch
+        TArray<FName, TInlineAllocator<16>> Names;
+        TArray<float, TInlineAllocator<16>> ParameterValues;
+        for (const FScalarParameterNameAndValue &NameAndValue : Values.ScalarValues)
+        {
+            Names.Add(NameAndValue.ParameterName);
+            ParameterValues.Add(NameAndValue.Value);
+        }
+
         for (TWeakObjectPtr<> &WeakObject : Player.FindBoundObjects(Operand))
         {
             UFMODAudioComponent *AudioComponent = Cast<UFMODAudioComponent>(WeakObject.Get());
@@ -83,10 +97,7 @@ struct FFMODEventParameterExecutionToken : IMovieSceneExecutionToken
                 Player.SavePreAnimatedState(
                     *AudioComponent, TMovieSceneAnimTypeID<FFMODEventParameterExecutionToken>(), FFMODEventParameterPreAnimatedTokenProducer());
 
-                for (const FScalarParameterNameAndValue &NameAndValue : Values.ScalarValues)
-                {
-                    AudioComponent->SetParameter(NameAndValue.ParameterName, NameAndValue.Value);
-                }
+                AudioComponent->SetParameters(Names, ParameterValues);
             }
         }
     }
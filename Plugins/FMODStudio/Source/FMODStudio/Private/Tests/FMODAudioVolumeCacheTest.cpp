@@ -0,0 +1,122 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODAudioVolumeCache.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** One in every twenty volumes starts disabled, starting with this one */
+static const int32 DISABLED_VOLUME_OFFSET = 1;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODAudioVolumeCacheTest, "FMOD.AudioVolumeCache",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODAudioVolumeCacheTest::RunTest(const FString &Parameters)
+{
+    const int32 NumVolumes = 200;
+    const int32 NumLargeVolumes = 4;
+    const int32 NumPoints = 5000;
+    const float WorldExtent = 40000.0f;
+
+    FFMODTestWorld TestWorld;
+    UWorld *World = TestWorld.World;
+    FRandomStream Random(0x0F30D);
+
+    // Small volumes overlap each other, the large ones cover too many grid cells and go on the list tested for every lookup
+    TArray<AAudioVolume *> Volumes;
+    for (int32 i = 0; i < NumVolumes; ++i)
+    {
+        const bool bLarge = i < NumLargeVolumes;
+        const FVector Center = bLarge ? FVector(i % 2 ? WorldExtent : -WorldExtent, i / 2 ? WorldExtent : -WorldExtent, 0.0f) :
+                                        FVector(Random.FRandRange(-WorldExtent, WorldExtent), Random.FRandRange(-WorldExtent, WorldExtent),
+                                            Random.FRandRange(-2000.0f, 2000.0f));
+        const FVector Extent = bLarge ? FVector(WorldExtent * 0.75f) :
+                                        FVector(Random.FRandRange(500.0f, 4000.0f), Random.FRandRange(500.0f, 4000.0f), Random.FRandRange(300.0f, 1000.0f));
+        AAudioVolume *Volume = TestWorld.SpawnAudioVolume(Center, Extent);
+        if (i % 20 == DISABLED_VOLUME_OFFSET)
+        {
+            Volume->SetEnabled(false);
+        }
+        Volumes.Add(Volume);
+    }
+    TestEqual(TEXT("Audio volumes in the world"), World->AudioVolumes.Num(), NumVolumes);
+
+    TArray<FVector> Points;
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        Points.Add(FVector(Random.FRandRange(-WorldExtent, WorldExtent), Random.FRandRange(-WorldExtent, WorldExtent), Random.FRandRange(-2000.0f, 2000.0f)));
+    }
+
+    FFMODAudioVolumeCache Cache;
+    TArray<FFMODAudioVolumeCacheEntry> Entries;
+    Entries.SetNum(NumPoints);
+
+    // Check every lookup against the engine's own, which walks every volume
+    auto CountMismatches = [&](double &OutCachedSeconds, double &OutUncachedSeconds) {
+        int32 Mismatches = 0;
+        int32 Inside = 0;
+        OutCachedSeconds = 0.0;
+        OutUncachedSeconds = 0.0;
+        for (int32 i = 0; i < NumPoints; ++i)
+        {
+            double StartTime = FPlatformTime::Seconds();
+            AAudioVolume *Cached = Cache.GetAudioSettings(World, Points[i], Entries[i], nullptr);
+            OutCachedSeconds += FPlatformTime::Seconds() - StartTime;
+
+            StartTime = FPlatformTime::Seconds();
+            AAudioVolume *Uncached = World->GetAudioSettings(Points[i], nullptr, nullptr);
+            OutUncachedSeconds += FPlatformTime::Seconds() - StartTime;
+
+            Mismatches += (Cached != Uncached);
+            Inside += (Uncached != nullptr);
+        }
+        AddInfo(FString::Printf(TEXT("%d of %d points inside a volume"), Inside, NumPoints));
+        return Mismatches;
+    };
+
+    double CachedSeconds = 0.0;
+    double UncachedSeconds = 0.0;
+    TestEqual(TEXT("Lookups differing from UWorld::GetAudioSettings"), CountMismatches(CachedSeconds, UncachedSeconds), 0);
+    AddInfo(FString::Printf(TEXT("First lookups: %.3f ms cached, %.3f ms uncached"), CachedSeconds * 1000.0, UncachedSeconds * 1000.0));
+
+    // Small moves reuse the cached volume, larger ones look it up again and must match exactly
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        Points[i] += Random.GetUnitVector() * ((i % 2) ? 10.0f : 500.0f);
+    }
+    ++GFrameCounter;
+    int32 Mismatches = 0;
+    int32 Reused = 0;
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        AAudioVolume *Previous = Entries[i].Volume;
+        AAudioVolume *Cached = Cache.GetAudioSettings(World, Points[i], Entries[i], nullptr);
+        if (i % 2)
+        {
+            Reused += (Cached == Previous);
+        }
+        else
+        {
+            Mismatches += (Cached != World->GetAudioSettings(Points[i], nullptr, nullptr));
+        }
+    }
+    TestEqual(TEXT("Lookups differing after moving past the cache distance"), Mismatches, 0);
+    TestEqual(TEXT("Cached volumes reused after small moves"), Reused, NumPoints / 2);
+
+    // Moving, disabling or adding volumes invalidates every entry, even for callers that haven't moved
+    const uint32 Generation = Entries[0].Generation;
+    Volumes[NumLargeVolumes]->SetActorLocation(Points[0]);
+    Volumes[NumLargeVolumes + 2]->SetEnabled(false);
+    Volumes[20 + DISABLED_VOLUME_OFFSET]->SetEnabled(true);
+    Volumes.Add(TestWorld.SpawnAudioVolume(Points[2], FVector(200.0f)));
+    ++GFrameCounter;
+    TestEqual(TEXT("Lookups differing after changing volumes"), CountMismatches(CachedSeconds, UncachedSeconds), 0);
+    TestNotEqual(TEXT("Cache generation after changing volumes"), Entries[0].Generation, Generation);
+
+    return true;
+}
+
+#endif
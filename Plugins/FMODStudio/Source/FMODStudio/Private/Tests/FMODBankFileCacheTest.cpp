@@ -0,0 +1,195 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODBankFileCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const int32 BANK_FILE_CACHE_TEST_BANKS = 400;
+
+/** Write a RIFF header like a bank's, with the GUID in a chunk of its own followed by some padding */
+static bool WriteDummyBank(const FString &Path, const FGuid &Guid, int32 PaddingSize)
+{
+    TArray<uint8> Data;
+    FMemoryWriter Writer(Data);
+    uint32 GuidSize = sizeof(FGuid);
+    uint32 Padding = PaddingSize;
+    uint32 RiffSize = 4 + (8 + GuidSize) + (8 + Padding);
+    FGuid WrittenGuid = Guid;
+    TArray<uint8> PaddingData;
+    PaddingData.SetNumZeroed(PaddingSize);
+
+    Writer.Serialize((void *)"RIFF", 4);
+    Writer << RiffSize;
+    Writer.Serialize((void *)"FEV ", 4);
+    Writer.Serialize((void *)"GUID", 4);
+    Writer << GuidSize;
+    Writer << WrittenGuid;
+    Writer.Serialize((void *)"PAD ", 4);
+    Writer << Padding;
+    Writer.Serialize(PaddingData.GetData(), PaddingData.Num());
+    return FFileHelper::SaveArrayToFile(Data, *Path);
+}
+
+/** Stands in for loading the bank into FMOD, leaving the GUID invalid for files without a GUID chunk */
+static void ReadDummyBankGuids(const TArray<FString> &Paths, TMap<FString, FFMODBankFileInfo> &FileInfos)
+{
+    for (const FString &Path : Paths)
+    {
+        TArray<uint8> Data;
+        if (!FFileHelper::LoadFileToArray(Data, *Path) || Data.Num() < 12 || FMemory::Memcmp(Data.GetData(), "RIFF", 4) != 0 ||
+            FMemory::Memcmp(Data.GetData() + 8, "FEV ", 4) != 0)
+        {
+            continue;
+        }
+
+        FMemoryReader Reader(Data);
+        Reader.Seek(12);
+        while (Reader.Tell() + 8 <= Reader.TotalSize())
+        {
+            uint8 ChunkID[4];
+            uint32 ChunkSize = 0;
+            Reader.Serialize(ChunkID, 4);
+            Reader << ChunkSize;
+            if (FMemory::Memcmp(ChunkID, "GUID", 4) == 0 && ChunkSize == sizeof(FGuid))
+            {
+                Reader << FileInfos.FindChecked(Path).Guid;
+                break;
+            }
+            Reader.Seek(Reader.Tell() + ChunkSize);
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODBankFileCacheTest, "FMOD.BankFileCache",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODBankFileCacheTest::RunTest(const FString &Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FMODBankFileCache")));
+    const FString BankDirectory = FPaths::Combine(Directory, TEXT("Banks"));
+    const FString CachePath = FPaths::Combine(Directory, TEXT("BankFileCache.bin"));
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+    TArray<FString> Paths;
+    TMap<FString, FGuid> Guids;
+    for (int32 i = 0; i < BANK_FILE_CACHE_TEST_BANKS; ++i)
+    {
+        const FString Path = FPaths::Combine(BankDirectory, FString::Printf(TEXT("Bank%d.bank"), i));
+        const FGuid Guid = FGuid::NewGuid();
+        if (!WriteDummyBank(Path, Guid, 1024 + i))
+        {
+            AddError(FString::Printf(TEXT("Failed to write %s"), *Path));
+            return false;
+        }
+        Paths.Add(Path);
+        Guids.Add(Path, Guid);
+    }
+
+    int32 NumReadCalls = 0;
+    auto ReadGuids = [&NumReadCalls](const TArray<FString> &ReadPaths, TMap<FString, FFMODBankFileInfo> &FileInfos) {
+        ++NumReadCalls;
+        ReadDummyBankGuids(ReadPaths, FileInfos);
+    };
+    auto CountWrongGuids = [&Guids](const FFMODBankFileCache &Cache) {
+        int32 Wrong = 0;
+        for (const TMap<FString, FFMODBankFileInfo>::ElementType &Entry : Cache.GetFiles())
+        {
+            const FGuid *Guid = Guids.Find(Entry.Key);
+            Wrong += (!Guid || *Guid != Entry.Value.Guid);
+        }
+        return Wrong;
+    };
+
+    // The first scan reads every file, the next only checks timestamps
+    {
+        FFMODBankFileCache Cache(CachePath);
+        double StartTime = FPlatformTime::Seconds();
+        Cache.Update(Paths, ReadGuids);
+        const double ScanSeconds = FPlatformTime::Seconds() - StartTime;
+        TestEqual(TEXT("Files read by the first scan"), Cache.GetNumRead(), BANK_FILE_CACHE_TEST_BANKS);
+        TestEqual(TEXT("Files known after the first scan"), Cache.GetFiles().Num(), BANK_FILE_CACHE_TEST_BANKS);
+        TestEqual(TEXT("Files changed by the first scan"), Cache.GetChangedFiles().Num(), BANK_FILE_CACHE_TEST_BANKS);
+        TestEqual(TEXT("Wrong GUIDs after the first scan"), CountWrongGuids(Cache), 0);
+
+        StartTime = FPlatformTime::Seconds();
+        Cache.Update(Paths, ReadGuids);
+        const double CachedSeconds = FPlatformTime::Seconds() - StartTime;
+        TestEqual(TEXT("Files read by an unchanged scan"), Cache.GetNumRead(), 0);
+        TestEqual(TEXT("Files changed by an unchanged scan"), Cache.GetChangedFiles().Num(), 0);
+        AddInfo(FString::Printf(TEXT("%d banks: %.1f ms to read, %.1f ms cached"), BANK_FILE_CACHE_TEST_BANKS, ScanSeconds * 1000.0,
+            CachedSeconds * 1000.0));
+    }
+    TestEqual(TEXT("GUID reads"), NumReadCalls, 1);
+
+    // The GUIDs are persisted, so the next session starts without reading anything
+    FFMODBankFileCache Cache(CachePath);
+    Cache.Update(Paths, ReadGuids);
+    TestEqual(TEXT("Files read after reloading the cache"), Cache.GetNumRead(), 0);
+    TestEqual(TEXT("Files changed after reloading the cache"), Cache.GetChangedFiles().Num(), 0);
+    TestEqual(TEXT("Wrong GUIDs after reloading the cache"), CountWrongGuids(Cache), 0);
+
+    // Rebuilt, removed and added banks are picked up, a file without a GUID is left out and read again next time
+    const int32 NumRebuilt = 5;
+    const int32 NumRemoved = 3;
+    const int32 NumAdded = 2;
+    for (int32 i = 0; i < NumRebuilt; ++i)
+    {
+        Guids[Paths[i]] = FGuid::NewGuid();
+        WriteDummyBank(Paths[i], Guids[Paths[i]], 4096);
+    }
+    for (int32 i = 0; i < NumRemoved; ++i)
+    {
+        IFileManager::Get().Delete(*Paths.Last());
+        Guids.Remove(Paths.Pop());
+    }
+    for (int32 i = 0; i < NumAdded; ++i)
+    {
+        const FString Path = FPaths::Combine(BankDirectory, FString::Printf(TEXT("Added%d.bank"), i));
+        Guids.Add(Path, FGuid::NewGuid());
+        WriteDummyBank(Path, Guids[Path], 512);
+        Paths.Add(Path);
+    }
+    const FString BrokenPath = FPaths::Combine(BankDirectory, TEXT("Broken.bank"));
+    FFileHelper::SaveStringToFile(TEXT("Not a bank"), *BrokenPath);
+    Paths.Add(BrokenPath);
+
+    // Logged each time the file without a GUID is read
+    AddExpectedError(TEXT("Failed to register disk file for bank"), EAutomationExpectedErrorFlags::Contains, 3);
+    Cache.Update(Paths, ReadGuids);
+    TestEqual(TEXT("Files read after changes"), Cache.GetNumRead(), NumRebuilt + NumAdded + 1);
+    TestEqual(TEXT("Files changed"), Cache.GetChangedFiles().Num(), NumRebuilt + NumRemoved + NumAdded);
+    TestEqual(TEXT("Files known after changes"), Cache.GetFiles().Num(), BANK_FILE_CACHE_TEST_BANKS - NumRemoved + NumAdded);
+    TestEqual(TEXT("Wrong GUIDs after changes"), CountWrongGuids(Cache), 0);
+    TestFalse(TEXT("File without a GUID known"), Cache.GetFiles().Contains(BrokenPath));
+
+    Cache.Update(Paths, ReadGuids);
+    TestEqual(TEXT("Files read after a failed read"), Cache.GetNumRead(), 1);
+    TestEqual(TEXT("Files changed after a failed read"), Cache.GetChangedFiles().Num(), 0);
+
+    // A cache file cut short is ignored rather than trusted
+    TArray<uint8> Damaged;
+    FMemoryWriter DamagedWriter(Damaged);
+    int32 Version = 1;
+    int32 Count = BANK_FILE_CACHE_TEST_BANKS;
+    DamagedWriter << Version;
+    DamagedWriter << Count;
+    FFileHelper::SaveArrayToFile(Damaged, *CachePath);
+    AddExpectedError(TEXT("Ignoring corrupt bank file cache"), EAutomationExpectedErrorFlags::Contains, 1);
+    FFMODBankFileCache DamagedCache(CachePath);
+    DamagedCache.Update(Paths, ReadGuids);
+    TestEqual(TEXT("Files read after damaging the cache"), DamagedCache.GetNumRead(), Paths.Num());
+    TestEqual(TEXT("Wrong GUIDs after damaging the cache"), CountWrongGuids(DamagedCache), 0);
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+#endif
@@ -0,0 +1,174 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODBankLoader.h"
+#include "FMODSettings.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const int32 BANK_LOADER_TEST_LOADS_PER_FRAME = 4;
+
+/** Fake bank loading that also records which files were loaded, in order, and fails those it is told to */
+class FFMODBankLoaderTestCalls : public FFMODRecordingStudioCalls
+{
+public:
+    virtual FMOD_RESULT LoadBankFile(
+        FMOD::Studio::System *System, const char *Filename, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **OutBank) override
+    {
+        const FString Path = UTF8_TO_TCHAR(Filename);
+        LoadedPaths.Add(Path);
+        if (FailingPaths.Contains(Path))
+        {
+            *OutBank = nullptr;
+            return FMOD_ERR_FILE_NOTFOUND;
+        }
+        return FFMODRecordingStudioCalls::LoadBankFile(System, Filename, Flags, OutBank);
+    }
+
+    TArray<FString> LoadedPaths;
+    TSet<FString> FailingPaths;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODBankLoaderTest, "FMOD.BankLoader",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODBankLoaderTest::RunTest(const FString &Parameters)
+{
+    const int32 NumBanks = 12;
+    const int32 MaxFrames = 100;
+
+    UFMODSettings &Settings = *GetMutableDefault<UFMODSettings>();
+    const int32 SavedLoadsPerFrame = Settings.BankLoadsPerFrame;
+    const TArray<FFMODMapBankManifest> SavedManifests = Settings.MapBankManifests;
+    Settings.BankLoadsPerFrame = BANK_LOADER_TEST_LOADS_PER_FRAME;
+
+    FFMODBankLoaderTestCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODBankLoader Loader;
+    Loader.Reset(Calls.GetFakeSystem());
+
+    TArray<TPair<int32, int32>> Progress;
+    Loader.OnProgress().AddLambda([&Progress](int32 Finished, int32 Requested) { Progress.Add(TPair<int32, int32>(Finished, Requested)); });
+
+    // Returns the most loads issued in one frame
+    auto LoadAll = [&]() {
+        int32 MostLoads = 0;
+        for (int32 Frame = 0; Frame < MaxFrames && Loader.NumPending() > 0; ++Frame)
+        {
+            const int32 LoadsBefore = Calls.LoadedPaths.Num();
+            Loader.Update();
+            MostLoads = FMath::Max(MostLoads, Calls.LoadedPaths.Num() - LoadsBefore);
+        }
+        TestEqual(TEXT("Banks left to load"), Loader.NumPending(), 0);
+        return MostLoads;
+    };
+
+    // Banks are loaded highest priority first, a few per frame, and raising the priority of a queued bank moves it forward
+    TMap<FString, int32> Priorities;
+    TArray<FString> Paths;
+    for (int32 i = 0; i < NumBanks; ++i)
+    {
+        const FString Path = FString::Printf(TEXT("BankLoaderTest/Bank%d.bank"), i);
+        Paths.Add(Path);
+        Priorities.Add(Path, i % 3);
+        Loader.RequestBank(Path, i % 3, i % 2 == 0);
+    }
+    Loader.RequestBank(Paths[0], 10, false);
+    Priorities[Paths[0]] = 10;
+
+    // A failed load frees its slot straight away, so fail one of the lowest priority banks which load in a frame of their own
+    Calls.FailingPaths.Add(Paths[NumBanks - 3]);
+    AddExpectedError(TEXT("Failed to load bank"), EAutomationExpectedErrorFlags::Contains, 1);
+
+    TestEqual(TEXT("Most loads issued in a frame"), LoadAll(), BANK_LOADER_TEST_LOADS_PER_FRAME);
+    TestEqual(TEXT("Bank files loaded"), Calls.LoadedPaths.Num(), NumBanks);
+    TestEqual(TEXT("Banks loaded"), Calls.NumFakeBanks(), NumBanks - 1);
+    TestEqual(TEXT("Sample data loads"), Calls.GetCount(FFMODRecordingStudioCalls::LoadSampleDataCall), NumBanks / 2);
+    TestEqual(TEXT("First bank loaded"), Calls.LoadedPaths[0], Paths[0]);
+    int32 OutOfOrder = 0;
+    for (int32 i = 1; i < Calls.LoadedPaths.Num(); ++i)
+    {
+        OutOfOrder += (Priorities[Calls.LoadedPaths[i]] > Priorities[Calls.LoadedPaths[i - 1]]);
+    }
+    TestEqual(TEXT("Banks loaded before a bank with a higher priority"), OutOfOrder, 0);
+
+    // Progress counts failed banks as finished and never goes backwards
+    int32 ProgressBackwards = 0;
+    for (int32 i = 1; i < Progress.Num(); ++i)
+    {
+        ProgressBackwards += (Progress[i].Key < Progress[i - 1].Key);
+    }
+    TestEqual(TEXT("Progress going backwards"), ProgressBackwards, 0);
+    TestTrue(TEXT("Progress reported"), Progress.Num() > 1);
+    if (Progress.Num() > 0)
+    {
+        TestEqual(TEXT("Banks finished in the last progress report"), Progress.Last().Key, NumBanks);
+        TestEqual(TEXT("Banks requested in the last progress report"), Progress.Last().Value, NumBanks);
+    }
+
+    // A failed bank is loaded again when it is next requested
+    const FString FailedPath = Paths[NumBanks - 3];
+    Calls.FailingPaths.Reset();
+    Calls.LoadedPaths.Reset();
+    Loader.RequestBank(FailedPath, 0, false);
+    LoadAll();
+    TestTrue(TEXT("Failed bank loaded again"), Calls.LoadedPaths.Num() == 1 && Calls.LoadedPaths[0] == FailedPath);
+    TestEqual(TEXT("Banks loaded after the retry"), Calls.NumFakeBanks(), NumBanks);
+
+    // Sample data can be asked for after a bank has loaded, and a bank requested twice stays loaded until both release it
+    Calls.ResetRecords();
+    Loader.RequestBank(Paths[1], 0, true);
+    TestEqual(TEXT("Sample data loads for a loaded bank"), Calls.GetCount(FFMODRecordingStudioCalls::LoadSampleDataCall), 1);
+    Loader.ReleaseBank(Paths[1]);
+    Loader.ReleaseBank(Paths[0]);
+    TestEqual(TEXT("Banks unloaded while still requested"), Calls.GetCount(FFMODRecordingStudioCalls::UnloadCall), 0);
+    Loader.ReleaseBank(Paths[0]);
+    TestEqual(TEXT("Banks unloaded once released"), Calls.GetCount(FFMODRecordingStudioCalls::UnloadCall), 1);
+    for (int32 i = 1; i < NumBanks; ++i)
+    {
+        Loader.ReleaseBank(Paths[i]);
+    }
+    Loader.ReleaseBank(FailedPath);
+    TestEqual(TEXT("Banks left after releasing all"), Calls.NumFakeBanks(), 0);
+
+    // Travelling between maps keeps the banks they share loaded and releases the rest
+    FFMODMapBankManifest ManifestA;
+    ManifestA.Map = FSoftObjectPath(TEXT("/Game/BankLoaderTest/MapA.MapA"));
+    ManifestA.Banks = { TEXT("BankLoaderTest/Shared"), TEXT("BankLoaderTest/OnlyA") };
+    FFMODMapBankManifest ManifestB;
+    ManifestB.Map = FSoftObjectPath(TEXT("/Game/BankLoaderTest/MapB.MapB"));
+    ManifestB.Banks = { TEXT("BankLoaderTest/Shared"), TEXT("BankLoaderTest/OnlyB") };
+    ManifestB.bLoadSampleData = true;
+    Settings.MapBankManifests = { ManifestA, ManifestB };
+    const FString SharedPath = Settings.GetFullBankPath() / TEXT("BankLoaderTest/Shared.bank");
+    const FString OnlyBPath = Settings.GetFullBankPath() / TEXT("BankLoaderTest/OnlyB.bank");
+
+    Calls.ResetRecords();
+    Calls.LoadedPaths.Reset();
+    Loader.SetMap(TEXT("/Game/BankLoaderTest/MapA"));
+    LoadAll();
+    TestEqual(TEXT("Banks loaded for the first map"), Calls.NumFakeBanks(), 2);
+
+    Calls.ResetRecords();
+    Calls.LoadedPaths.Reset();
+    Loader.SetMap(TEXT("/Game/BankLoaderTest/MapB"));
+    LoadAll();
+    TestEqual(TEXT("Banks loaded for the second map"), Calls.LoadedPaths.Num(), 1);
+    TestTrue(TEXT("Only the second map's own bank loaded"), Calls.LoadedPaths.Num() == 1 && Calls.LoadedPaths[0] == OnlyBPath);
+    TestFalse(TEXT("Shared bank reloaded"), Calls.LoadedPaths.Contains(SharedPath));
+    TestEqual(TEXT("Banks unloaded by travel"), Calls.GetCount(FFMODRecordingStudioCalls::UnloadCall), 1);
+    TestEqual(TEXT("Sample data loads for the second map"), Calls.GetCount(FFMODRecordingStudioCalls::LoadSampleDataCall), 2);
+    TestEqual(TEXT("Banks loaded after travel"), Calls.NumFakeBanks(), 2);
+
+    Loader.SetMap(TEXT("/Game/BankLoaderTest/NoManifest"));
+    TestEqual(TEXT("Banks left after travelling to a map without banks"), Calls.NumFakeBanks(), 0);
+
+    Settings.BankLoadsPerFrame = SavedLoadsPerFrame;
+    Settings.MapBankManifests = SavedManifests;
+    return true;
+}
+
+#endif
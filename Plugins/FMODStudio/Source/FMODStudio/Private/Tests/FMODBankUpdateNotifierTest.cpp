@@ -0,0 +1,107 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODBankUpdateNotifier.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODBankUpdateNotifierTest, "FMOD.BankUpdateNotifier",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODBankUpdateNotifierTest::RunTest(const FString &Parameters)
+{
+    const int32 NumBanks = 20;
+    const int32 NumHeldBanks = 3;
+    const float WriteInterval = 0.1f;
+    const float SettleWait = 3.0f;
+
+    IDirectoryWatcher *DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+    if (!DirectoryWatcher)
+    {
+        AddWarning(TEXT("Skipped because there is no directory watcher on this platform"));
+        return true;
+    }
+
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FMODBankUpdateNotifier")));
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    IFileManager::Get().MakeDirectory(*Directory, true);
+
+    TArray<TSet<FString>> Notifications;
+    {
+        FFMODBankUpdateNotifier Notifier;
+        Notifier.SetBankDirectory(Directory);
+        Notifier.BanksUpdatedEvent.AddLambda([&Notifications](const TSet<FString> &ChangedFiles) { Notifications.Add(ChangedFiles); });
+
+        // The editor ticks the watcher and the notifier every frame, here they are ticked until some real time has passed
+        auto Pump = [&](float Seconds) {
+            const double EndTime = FPlatformTime::Seconds() + Seconds;
+            do
+            {
+                DirectoryWatcher->Tick(0.05f);
+                Notifier.Update();
+                FPlatformProcess::Sleep(0.05f);
+            } while (FPlatformTime::Seconds() < EndTime);
+        };
+        auto WriteBanks = [&](const TCHAR *Prefix, int32 Count, TSet<FString> &OutPaths) {
+            for (int32 i = 0; i < Count; ++i)
+            {
+                const FString Path = FPaths::Combine(Directory, FString::Printf(TEXT("%s%d.bank"), Prefix, i));
+                FFileHelper::SaveStringToFile(TEXT("Not really a bank"), *Path);
+                OutPaths.Add(Path);
+                Pump(WriteInterval);
+            }
+        };
+
+        // A build writes its banks one after another, along with files that aren't banks, and that makes one notification
+        TSet<FString> BuiltPaths;
+        WriteBanks(TEXT("Built"), NumBanks, BuiltPaths);
+        FFileHelper::SaveStringToFile(TEXT("Build finished"), *FPaths::Combine(Directory, TEXT("Build.log")));
+        TestEqual(TEXT("Notifications while banks are still being written"), Notifications.Num(), 0);
+
+        Pump(SettleWait);
+        TestEqual(TEXT("Notifications for one build"), Notifications.Num(), 1);
+        if (Notifications.Num() > 0)
+        {
+            TestEqual(TEXT("Banks in the notification"), Notifications[0].Num(), NumBanks);
+            TestEqual(TEXT("Written banks missing from the notification"), BuiltPaths.Difference(Notifications[0]).Num(), 0);
+        }
+
+        // Banks written while notifications are held, e.g. during PIE, are reported once they are enabled again
+        Notifications.Reset();
+        Notifier.EnableUpdate(false);
+        TSet<FString> HeldPaths;
+        WriteBanks(TEXT("Held"), NumHeldBanks, HeldPaths);
+        Pump(SettleWait);
+        TestEqual(TEXT("Notifications while held"), Notifications.Num(), 0);
+
+        Notifier.EnableUpdate(true);
+        Pump(SettleWait);
+        TestEqual(TEXT("Notifications once enabled again"), Notifications.Num(), 1);
+        if (Notifications.Num() > 0)
+        {
+            TestTrue(TEXT("Notification holds the banks written while held"), Notifications[0].Num() == NumHeldBanks &&
+                                                                                  HeldPaths.Difference(Notifications[0]).Num() == 0);
+        }
+
+        // Nothing more arrives once everything has been reported
+        Notifications.Reset();
+        Pump(SettleWait);
+        TestEqual(TEXT("Notifications without changes"), Notifications.Num(), 0);
+    }
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODCallbackQueue.h"
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const int32 CALLBACK_QUEUE_TEST_COUNT = 100000;
+static const uint32 CALLBACK_QUEUE_TEST_SIZE = 64;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODCallbackQueueOverflowTest, "FMOD.CallbackQueue.Overflow",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODCallbackQueueOverflowTest::RunTest(const FString &Parameters)
+{
+    // Nothing is dequeued until every callback has been queued, like a component that doesn't tick for a while
+    TFMODCallbackQueue<int32> Queue(CALLBACK_QUEUE_TEST_SIZE);
+    for (int32 i = 0; i < CALLBACK_QUEUE_TEST_COUNT; ++i)
+    {
+        Queue.Enqueue(i);
+    }
+
+    int32 Expected = 0;
+    bool bInOrder = true;
+    int32 Overflowed = Queue.DequeueAll([&](int32 Value) { bInOrder &= (Value == Expected++); });
+
+    TestTrue(TEXT("Callbacks are dequeued in order"), bInOrder);
+    TestEqual(TEXT("Callbacks dequeued"), Expected, CALLBACK_QUEUE_TEST_COUNT);
+    TestEqual(TEXT("Callbacks that didn't fit in the ring"), Overflowed, CALLBACK_QUEUE_TEST_COUNT - (int32)CALLBACK_QUEUE_TEST_SIZE + 1);
+    TestEqual(TEXT("Callbacks left after draining"), Queue.DequeueAll([](int32) {}), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODCallbackQueueRefillTest, "FMOD.CallbackQueue.Refill",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODCallbackQueueRefillTest::RunTest(const FString &Parameters)
+{
+    // The producer refills the ring and spills one callback just after the consumer has found the ring empty
+    const uint32 Capacity = 4;
+    TFMODCallbackQueue<int32> Queue(Capacity);
+    Queue.Enqueue(0);
+    int32 Next = 1;
+    Queue.OnRingDrained = [&Queue, &Next, Capacity]() {
+        for (uint32 i = 0; i < Capacity; ++i)
+        {
+            Queue.Enqueue(Next++);
+        }
+        Queue.OnRingDrained = nullptr;
+    };
+
+    int32 Expected = 0;
+    bool bInOrder = true;
+    int32 Overflowed = Queue.DequeueAll([&](int32 Value) { bInOrder &= (Value == Expected++); });
+
+    TestTrue(TEXT("Callbacks are dequeued in order"), bInOrder);
+    TestEqual(TEXT("Callbacks dequeued"), Expected, Next);
+    TestEqual(TEXT("Callbacks that didn't fit in the ring"), Overflowed, 1);
+    TestEqual(TEXT("Callbacks left after draining"), Queue.DequeueAll([](int32) {}), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODCallbackQueueThreadedTest, "FMOD.CallbackQueue.Threaded",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODCallbackQueueThreadedTest::RunTest(const FString &Parameters)
+{
+    // A producer thread standing in for the FMOD thread races the consumer, so the ring keeps filling and spilling
+    TFMODCallbackQueue<int32> Queue(CALLBACK_QUEUE_TEST_SIZE);
+    TAtomic<bool> bProducerDone(false);
+    TFuture<void> Producer = Async(EAsyncExecution::Thread, [&Queue, &bProducerDone]() {
+        for (int32 i = 0; i < CALLBACK_QUEUE_TEST_COUNT; ++i)
+        {
+            Queue.Enqueue(i);
+        }
+        bProducerDone = true;
+    });
+
+    int32 Expected = 0;
+    bool bInOrder = true;
+    int32 Overflowed = 0;
+    auto Consume = [&](int32 Value) { bInOrder &= (Value == Expected++); };
+    while (!bProducerDone)
+    {
+        Overflowed += Queue.DequeueAll(Consume);
+        FPlatformProcess::Yield();
+    }
+    Producer.Wait();
+    Overflowed += Queue.DequeueAll(Consume);
+
+    TestTrue(TEXT("Callbacks are dequeued in order"), bInOrder);
+    TestEqual(TEXT("Callbacks dequeued"), Expected, CALLBACK_QUEUE_TEST_COUNT);
+    AddInfo(FString::Printf(TEXT("%d of %d callbacks went through the overflow list"), Overflowed, CALLBACK_QUEUE_TEST_COUNT));
+    return true;
+}
+
+#endif
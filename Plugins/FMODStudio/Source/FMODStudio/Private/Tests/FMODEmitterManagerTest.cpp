@@ -0,0 +1,111 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODListener.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODEmitterManagerTest, "FMOD.EmitterManager",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODEmitterManagerTest::RunTest(const FString &Parameters)
+{
+    const int32 EmitterCounts[] = { 100, 1000, 5000 };
+    const int32 NumFrames = 30;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODEmitterManager &Manager = Module.GetEmitterManager();
+    if (Manager.Num() > 0)
+    {
+        AddWarning(TEXT("Skipped because other emitters are playing"));
+        return true;
+    }
+
+    const FVector ListenerLocation = Module.GetNearestListener(FVector::ZeroVector).Transform.GetTranslation();
+
+    for (int32 NumEmitters : EmitterCounts)
+    {
+        FFMODRecordingStudioCalls Calls;
+        FFMODScopedStudioCalls ScopedCalls(Calls);
+        FFMODTestWorld TestWorld;
+
+        TArray<UFMODAudioComponent *> Components;
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            const FVector Location = ListenerLocation + FVector(100.0f * (i % 100), 100.0f * (i / 100), 0.0f);
+            UFMODAudioComponent *Component = TestWorld.SpawnEmitter(Calls, Location, 0.0f);
+            Component->AttenuationDetails.bOverrideAttenuation = true;
+            Components.Add(Component);
+        }
+
+        // Every emitter is updated when the listener moves, only the playback state is checked otherwise
+        Calls.ResetRecords();
+        double Seconds = FMODTimeFrames(NumFrames, [&](int32 Frame) { Manager.Update(true); });
+        Calls.Report(*this, FString::Printf(TEXT("%d emitters, listener moving"), NumEmitters), Seconds, NumFrames);
+        TestEqual(TEXT("Attenuation properties set"), Calls.GetCount(FFMODRecordingStudioCalls::SetPropertyCall), NumEmitters * NumFrames * 2);
+
+        Calls.ResetRecords();
+        Seconds = FMODTimeFrames(NumFrames, [&](int32 Frame) { Manager.Update(false); });
+        Calls.Report(*this, FString::Printf(TEXT("%d emitters, listener still"), NumEmitters), Seconds, NumFrames);
+        TestEqual(TEXT("Studio calls with the listener still"), Calls.GetTotalCount(), NumEmitters * NumFrames);
+
+        // Emitters in a paused world are left alone, as they were when components updated themselves in their tick
+        AWorldSettings *WorldSettings = TestWorld.World->GetWorldSettings();
+        WorldSettings->SetPauserPlayerState(TestWorld.World->SpawnActor<APlayerState>());
+        Calls.ResetRecords();
+        Manager.Update(true);
+        TestTrue(TEXT("World paused"), TestWorld.World->IsPaused());
+        TestEqual(TEXT("Studio calls while paused"), Calls.GetTotalCount(), 0);
+        WorldSettings->SetPauserPlayerState(nullptr);
+
+        // Releasing every third component swaps others into the freed slots, which must keep their indices in step
+        for (int32 i = 0; i < NumEmitters; i += 3)
+        {
+            Components[i]->Release();
+            Components[i]->SetActiveFlag(false);
+        }
+        TArray<bool> UsedIndices;
+        UsedIndices.SetNumZeroed(Manager.Num());
+        int32 BadIndices = 0;
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            const int32 Index = Components[i]->EmitterIndex;
+            if (i % 3 == 0)
+            {
+                BadIndices += (Index != INDEX_NONE);
+            }
+            else if (!UsedIndices.IsValidIndex(Index) || UsedIndices[Index])
+            {
+                ++BadIndices;
+            }
+            else
+            {
+                UsedIndices[Index] = true;
+            }
+        }
+        TestEqual(TEXT("Emitters registered after releasing some"), Manager.Num(), NumEmitters - FMath::DivideAndRoundUp(NumEmitters, 3));
+        TestEqual(TEXT("Components with a wrong emitter index"), BadIndices, 0);
+
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            if (i % 3 != 0)
+            {
+                Calls.SetFakePlaybackState(Components[i]->StudioInstance, FMOD_STUDIO_PLAYBACK_STOPPED);
+            }
+        }
+        Manager.Update(false);
+        TestEqual(TEXT("Emitters registered after completion"), Manager.Num(), 0);
+        TestEqual(TEXT("Components ticking"), Components.FilterByPredicate([](UFMODAudioComponent *Component) {
+            return Component->IsComponentTickEnabled();
+        }).Num(), 0);
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,219 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODFileCallbacks.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const int32 FILE_SYSTEM_TEST_STREAMS = 64;
+static const int32 FILE_SYSTEM_TEST_FILE_SIZE = 1024 * 1024;
+static const unsigned int FILE_SYSTEM_TEST_CHUNK_SIZE = 16 * 1024;
+static const double FILE_SYSTEM_TEST_TIMEOUT = 60.0;
+
+static uint8 FileSystemTestByte(int32 Stream, int64 Offset)
+{
+    return (uint8)(Offset * 7 + Stream);
+}
+
+/** A stream with one read in flight at a time, the way FMOD keeps its stream buffer topped up */
+struct FFMODTestStream
+{
+    FFMODTestStream()
+        : Index(0)
+        , Handle(nullptr)
+        , Size(0)
+        , Offset(0)
+        , IssueCycles(0)
+        , CompleteCycles(0)
+        , Result(FMOD_OK)
+        , bPending(false)
+        , bDone(false)
+        , bFinished(false)
+    {
+        FMemory::Memzero(Info);
+    }
+
+    int32 Index;
+    void *Handle;
+    unsigned int Size;
+    unsigned int Offset;
+    TArray<uint8> Buffer;
+    FMOD_ASYNCREADINFO Info;
+    uint64 IssueCycles;
+    uint64 CompleteCycles;
+    FMOD_RESULT Result;
+    bool bPending;
+    TAtomic<bool> bDone;
+    bool bFinished;
+};
+
+/** Called by the file system, on whichever thread finished the read */
+static void F_CALLBACK FileSystemTestReadDone(FMOD_ASYNCREADINFO *info, FMOD_RESULT result)
+{
+    FFMODTestStream *Stream = (FFMODTestStream *)info->userdata;
+    Stream->CompleteCycles = FPlatformTime::Cycles64();
+    Stream->Result = result;
+    Stream->bDone = true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODFileSystemTest, "FMOD.FileSystem",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODFileSystemTest::RunTest(const FString &Parameters)
+{
+    const FFMODFileSystemCallbacks Callbacks = GetFMODFileSystemCallbacks();
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FMODFileSystem")));
+
+    // Sizes aren't a multiple of the chunk size, so every stream ends with a short read
+    TArray<FFMODTestStream> Streams;
+    Streams.SetNum(FILE_SYSTEM_TEST_STREAMS);
+    for (int32 i = 0; i < FILE_SYSTEM_TEST_STREAMS; ++i)
+    {
+        TArray<uint8> Contents;
+        Contents.SetNumUninitialized(FILE_SYSTEM_TEST_FILE_SIZE + i * 1000 + 1);
+        for (int32 Offset = 0; Offset < Contents.Num(); ++Offset)
+        {
+            Contents[Offset] = FileSystemTestByte(i, Offset);
+        }
+        const FString Path = FPaths::Combine(Directory, FString::Printf(TEXT("Stream%d.bin"), i));
+        if (!FFileHelper::SaveArrayToFile(Contents, *Path))
+        {
+            AddError(FString::Printf(TEXT("Failed to write %s"), *Path));
+            return false;
+        }
+
+        FFMODTestStream &Stream = Streams[i];
+        Stream.Index = i;
+        Stream.Buffer.SetNumUninitialized(FILE_SYSTEM_TEST_CHUNK_SIZE);
+        TestTrue(TEXT("Opening a stream"), Callbacks.Open(TCHAR_TO_UTF8(*Path), &Stream.Size, &Stream.Handle, nullptr) == FMOD_OK);
+        TestEqual(TEXT("Stream size"), (int32)Stream.Size, Contents.Num());
+        Stream.bFinished = (Stream.Handle == nullptr);
+    }
+
+    unsigned int MissingSize = 0;
+    void *MissingHandle = nullptr;
+    TestTrue(TEXT("Opening a missing file fails"),
+        Callbacks.Open(TCHAR_TO_UTF8(*FPaths::Combine(Directory, TEXT("Missing.bin"))), &MissingSize, &MissingHandle, nullptr) ==
+            FMOD_ERR_FILE_NOTFOUND);
+
+    auto IssueRead = [&](FFMODTestStream &Stream) {
+        FMOD_ASYNCREADINFO &Info = Stream.Info;
+        Info.handle = Stream.Handle;
+        Info.offset = Stream.Offset;
+        Info.sizebytes = FILE_SYSTEM_TEST_CHUNK_SIZE;
+        Info.priority = (Stream.Index % 4 == 0) ? 100 : 0;
+        Info.userdata = &Stream;
+        Info.buffer = Stream.Buffer.GetData();
+        Info.bytesread = 0;
+        Info.done = FileSystemTestReadDone;
+        Stream.bDone = false;
+        Stream.bPending = true;
+        Stream.IssueCycles = FPlatformTime::Cycles64();
+        return Callbacks.AsyncRead(&Info, nullptr);
+    };
+
+    // Every stream reads to the end at once, with a new read issued as soon as the last one finishes
+    TArray<double> Latencies;
+    int32 FailedReads = 0;
+    int32 BadBytes = 0;
+    int32 Active = 0;
+    for (const FFMODTestStream &Stream : Streams)
+    {
+        Active += !Stream.bFinished;
+    }
+    const double StartTime = FPlatformTime::Seconds();
+    while (Active > 0)
+    {
+        for (FFMODTestStream &Stream : Streams)
+        {
+            if (Stream.bFinished)
+            {
+                continue;
+            }
+            if (!Stream.bPending)
+            {
+                FailedReads += (IssueRead(Stream) != FMOD_OK);
+                continue;
+            }
+            if (!Stream.bDone)
+            {
+                continue;
+            }
+
+            Latencies.Add(FPlatformTime::ToMilliseconds64(Stream.CompleteCycles - Stream.IssueCycles));
+            const unsigned int Expected = FMath::Min(FILE_SYSTEM_TEST_CHUNK_SIZE, Stream.Size - Stream.Offset);
+            const bool bLast = (Stream.Offset + Expected == Stream.Size);
+            FailedReads += (Stream.Info.bytesread != Expected) || (Stream.Result != (bLast ? FMOD_ERR_FILE_EOF : FMOD_OK));
+            for (unsigned int i = 0; i < FMath::Min(Expected, Stream.Info.bytesread); ++i)
+            {
+                BadBytes += (Stream.Buffer[i] != FileSystemTestByte(Stream.Index, Stream.Offset + i));
+            }
+
+            Stream.Offset += Expected;
+            Stream.bPending = false;
+            if (bLast)
+            {
+                Stream.bFinished = true;
+                --Active;
+            }
+            else
+            {
+                FailedReads += (IssueRead(Stream) != FMOD_OK);
+            }
+        }
+
+        if (FPlatformTime::Seconds() - StartTime > FILE_SYSTEM_TEST_TIMEOUT)
+        {
+            AddError(FString::Printf(TEXT("%d streams still reading after %.0f seconds"), Active, FILE_SYSTEM_TEST_TIMEOUT));
+            break;
+        }
+        FPlatformProcess::Yield();
+    }
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+    TestEqual(TEXT("Failed or short reads"), FailedReads, 0);
+    TestEqual(TEXT("Bytes read differing from the files"), BadBytes, 0);
+    if (Latencies.Num() > 0)
+    {
+        Latencies.Sort();
+        auto Percentile = [&Latencies](double Fraction) { return Latencies[FMath::Min(Latencies.Num() - 1, (int32)(Fraction * Latencies.Num()))]; };
+        AddInfo(FString::Printf(TEXT("%d streams, %d reads of %u bytes in %.1f ms"), FILE_SYSTEM_TEST_STREAMS, Latencies.Num(),
+            FILE_SYSTEM_TEST_CHUNK_SIZE, Seconds * 1000.0));
+        AddInfo(FString::Printf(TEXT("Read latency: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms"), Percentile(0.5), Percentile(0.9),
+            Percentile(0.99), Latencies.Last()));
+    }
+
+    // Reading from the end reports EOF straight away, and a cancel returns only once the read's completion has run
+    for (FFMODTestStream &Stream : Streams)
+    {
+        if (!Stream.Handle || (Stream.bPending && !Stream.bDone))
+        {
+            continue;
+        }
+        TestTrue(TEXT("Reading past the end"), IssueRead(Stream) == FMOD_OK);
+        TestTrue(TEXT("Read past the end finished"), Stream.bDone && Stream.Result == FMOD_ERR_FILE_EOF && Stream.Info.bytesread == 0);
+
+        Stream.Offset = 0;
+        TestTrue(TEXT("Reading before a cancel"), IssueRead(Stream) == FMOD_OK);
+        TestTrue(TEXT("Cancelling a read"), Callbacks.AsyncCancel(&Stream.Info, nullptr) == FMOD_OK);
+        TestTrue(TEXT("Cancelled read finished"), (bool)Stream.bDone);
+    }
+
+    for (FFMODTestStream &Stream : Streams)
+    {
+        if (Stream.Handle)
+        {
+            TestTrue(TEXT("Closing a stream"), Callbacks.Close(Stream.Handle, nullptr) == FMOD_OK);
+        }
+    }
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+    return true;
+}
+
+#endif
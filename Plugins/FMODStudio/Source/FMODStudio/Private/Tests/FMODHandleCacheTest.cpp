@@ -0,0 +1,201 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODBlueprintStatics.h"
+#include "FMODBus.h"
+#include "FMODHandleCache.h"
+#include "FMODUtils.h"
+#include "FMODVCA.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static float MixerTestVolume(int32 Bus, int32 Frame)
+{
+    return 0.5f + 0.5f * FMath::Sin(Frame * 0.05f + Bus);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODHandleCacheTest, "FMOD.HandleCache",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODHandleCacheTest::RunTest(const FString &Parameters)
+{
+    const int32 NumBuses = 32;
+    const int32 NumFrames = 600;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+
+    // A mixer blueprint driving every bus of the fake system each frame, through the module's cache like a game would
+    TArray<UFMODBus *> Buses;
+    for (int32 i = 0; i < NumBuses; ++i)
+    {
+        UFMODBus *Bus = NewObject<UFMODBus>();
+        Bus->AssetGuid = FGuid::NewGuid();
+        Calls.AddFakeBus(Bus->AssetGuid);
+        Buses.Add(Bus);
+    }
+    FFMODHandleCache &HandleCache = Module.GetHandleCache();
+    HandleCache.Reset(Calls.GetFakeSystem());
+
+    auto RunMixer = [&](int32 Frame) {
+        for (int32 i = 0; i < NumBuses; ++i)
+        {
+            UFMODBlueprintStatics::BusSetVolume(Buses[i], MixerTestVolume(i, Frame));
+        }
+    };
+
+    // Each bus is looked up once, after that its handle is only checked
+    Calls.ResetRecords();
+    const double CachedSeconds = FMODTimeFrames(NumFrames, RunMixer);
+    Calls.Report(*this, FString::Printf(TEXT("%d bus volumes a frame, cached handles"), NumBuses), CachedSeconds, NumFrames);
+    TestEqual(TEXT("Bus lookups"), Calls.GetCount(FFMODRecordingStudioCalls::GetBusByIDCall), NumBuses);
+    TestEqual(TEXT("Cached handles checked"), Calls.GetCount(FFMODRecordingStudioCalls::IsBusValidCall), NumBuses * (NumFrames - 1));
+    TestEqual(TEXT("Volumes set"), Calls.GetCount(FFMODRecordingStudioCalls::SetBusVolumeCall), NumBuses * NumFrames);
+
+    int32 WrongVolumes = 0;
+    for (int32 i = 0; i < NumBuses; ++i)
+    {
+        float Volume = 0.0f;
+        WrongVolumes += (!Calls.GetFakeBusVolume(Buses[i]->AssetGuid, Volume) || Volume != MixerTestVolume(i, NumFrames - 1));
+    }
+    TestEqual(TEXT("Buses not at their last volume"), WrongVolumes, 0);
+
+    // The statics used to look every bus up by GUID on each call
+    Calls.ResetRecords();
+    const double UncachedSeconds = FMODTimeFrames(NumFrames, [&](int32 Frame) {
+        for (int32 i = 0; i < NumBuses; ++i)
+        {
+            FMOD::Studio::Bus *Bus = nullptr;
+            if (Calls.GetBusByID(Calls.GetFakeSystem(), FMODUtils::ConvertGuid(Buses[i]->AssetGuid), &Bus) == FMOD_OK)
+            {
+                Calls.SetVolume(Bus, MixerTestVolume(i, Frame));
+            }
+        }
+    });
+    Calls.Report(*this, FString::Printf(TEXT("%d bus volumes a frame, looked up on every call"), NumBuses), UncachedSeconds, NumFrames);
+    TestEqual(TEXT("Bus lookups without the cache"), Calls.GetCount(FFMODRecordingStudioCalls::GetBusByIDCall), NumBuses * NumFrames);
+    AddInfo(FString::Printf(TEXT("%.3f ms per frame with cached handles, %.3f ms per frame looking buses up"),
+        CachedSeconds * 1000.0 / NumFrames, UncachedSeconds * 1000.0 / NumFrames));
+
+    // Reloading banks resets the cache, so every bus is looked up once more
+    HandleCache.Reset(Calls.GetFakeSystem());
+    Calls.ResetRecords();
+    FMODTimeFrames(10, RunMixer);
+    TestEqual(TEXT("Bus lookups after a reset"), Calls.GetCount(FFMODRecordingStudioCalls::GetBusByIDCall), NumBuses);
+
+    // A bus whose bank is unloaded fails its check and is looked up each frame until it is back, the others stay cached
+    const FGuid &UnloadedGuid = Buses[0]->AssetGuid;
+    Calls.RemoveFakeBus(UnloadedGuid);
+    Calls.ResetRecords();
+    FMODTimeFrames(3, RunMixer);
+    TestEqual(TEXT("Lookups of an unloaded bus"), Calls.GetCount(FFMODRecordingStudioCalls::GetBusByIDCall), 3);
+    TestEqual(TEXT("Volumes set with a bus unloaded"), Calls.GetCount(FFMODRecordingStudioCalls::SetBusVolumeCall), (NumBuses - 1) * 3);
+
+    Calls.AddFakeBus(UnloadedGuid);
+    Calls.ResetRecords();
+    FMODTimeFrames(3, RunMixer);
+    TestEqual(TEXT("Lookups of a reloaded bus"), Calls.GetCount(FFMODRecordingStudioCalls::GetBusByIDCall), 1);
+    TestEqual(TEXT("Volumes set once the bus is reloaded"), Calls.GetCount(FFMODRecordingStudioCalls::SetBusVolumeCall), NumBuses * 3);
+
+    // VCAs and global parameters driven from the same blueprint go through the cache as well
+    const int32 NumVCAs = 8;
+    const int32 NumGlobalParameters = 8;
+    TArray<UFMODVCA *> VCAs;
+    for (int32 i = 0; i < NumVCAs; ++i)
+    {
+        UFMODVCA *VCA = NewObject<UFMODVCA>();
+        VCA->AssetGuid = FGuid::NewGuid();
+        Calls.AddFakeVCA(VCA->AssetGuid);
+        VCAs.Add(VCA);
+    }
+    TArray<FName> GlobalParameters;
+    for (int32 i = 0; i < NumGlobalParameters; ++i)
+    {
+        GlobalParameters.Add(FName(*FString::Printf(TEXT("Global %d"), i)));
+        Calls.AddFakeGlobalParameter(GlobalParameters.Last());
+    }
+    HandleCache.Reset(Calls.GetFakeSystem());
+
+    auto RunGlobalMixer = [&](int32 Frame) {
+        for (int32 i = 0; i < NumVCAs; ++i)
+        {
+            UFMODBlueprintStatics::VCASetVolume(VCAs[i], MixerTestVolume(i, Frame));
+        }
+        for (int32 i = 0; i < NumGlobalParameters; ++i)
+        {
+            UFMODBlueprintStatics::SetGlobalParameterByName(GlobalParameters[i], MixerTestVolume(i, Frame));
+        }
+    };
+
+    Calls.ResetRecords();
+    const double CachedGlobalSeconds = FMODTimeFrames(NumFrames, RunGlobalMixer);
+    Calls.Report(*this, FString::Printf(TEXT("%d VCA volumes and %d global parameters a frame, cached"), NumVCAs, NumGlobalParameters),
+        CachedGlobalSeconds, NumFrames);
+    TestEqual(TEXT("VCA lookups"), Calls.GetCount(FFMODRecordingStudioCalls::GetVCAByIDCall), NumVCAs);
+    TestEqual(TEXT("Cached VCA handles checked"), Calls.GetCount(FFMODRecordingStudioCalls::IsVCAValidCall), NumVCAs * (NumFrames - 1));
+    TestEqual(TEXT("VCA volumes set"), Calls.GetCount(FFMODRecordingStudioCalls::SetVCAVolumeCall), NumVCAs * NumFrames);
+    TestEqual(TEXT("Global parameter lookups"), Calls.GetCount(FFMODRecordingStudioCalls::GetGlobalParameterDescriptionCall),
+        NumGlobalParameters);
+    TestEqual(TEXT("Global parameters set by ID"), Calls.GetCount(FFMODRecordingStudioCalls::SetGlobalParameterByIDCall),
+        NumGlobalParameters * NumFrames);
+    TestEqual(TEXT("Global parameters set by name"), Calls.GetCount(FFMODRecordingStudioCalls::SetGlobalParameterByNameCall), 0);
+
+    int32 WrongValues = 0;
+    for (int32 i = 0; i < NumVCAs; ++i)
+    {
+        float Volume = 0.0f;
+        WrongValues += (!Calls.GetFakeVCAVolume(VCAs[i]->AssetGuid, Volume) || Volume != MixerTestVolume(i, NumFrames - 1));
+    }
+    for (int32 i = 0; i < NumGlobalParameters; ++i)
+    {
+        WrongValues += (UFMODBlueprintStatics::GetGlobalParameterByName(GlobalParameters[i]) != MixerTestVolume(i, NumFrames - 1));
+    }
+    TestEqual(TEXT("VCAs and global parameters not at their last value"), WrongValues, 0);
+    TestEqual(TEXT("Global parameters read by ID"), Calls.GetCount(FFMODRecordingStudioCalls::GetGlobalParameterByIDCall),
+        NumGlobalParameters);
+
+    // Without the cache every VCA was looked up by GUID and every global parameter set by name
+    Calls.ResetRecords();
+    const double UncachedGlobalSeconds = FMODTimeFrames(NumFrames, [&](int32 Frame) {
+        for (int32 i = 0; i < NumVCAs; ++i)
+        {
+            FMOD::Studio::VCA *VCA = nullptr;
+            if (Calls.GetVCAByID(Calls.GetFakeSystem(), FMODUtils::ConvertGuid(VCAs[i]->AssetGuid), &VCA) == FMOD_OK)
+            {
+                Calls.SetVolume(VCA, MixerTestVolume(i, Frame));
+            }
+        }
+        for (int32 i = 0; i < NumGlobalParameters; ++i)
+        {
+            Calls.SetParameterByName(Calls.GetFakeSystem(), TCHAR_TO_UTF8(*GlobalParameters[i].ToString()), MixerTestVolume(i, Frame));
+        }
+    });
+    Calls.Report(*this, FString::Printf(TEXT("%d VCA volumes and %d global parameters a frame, looked up on every call"), NumVCAs,
+        NumGlobalParameters), UncachedGlobalSeconds, NumFrames);
+    AddInfo(FString::Printf(TEXT("%.3f ms per frame with cached VCAs and parameter IDs, %.3f ms per frame looking them up"),
+        CachedGlobalSeconds * 1000.0 / NumFrames, UncachedGlobalSeconds * 1000.0 / NumFrames));
+
+    // An unloaded VCA is looked up each frame until it is back, like a bus
+    const FGuid &UnloadedVCAGuid = VCAs[0]->AssetGuid;
+    Calls.RemoveFakeVCA(UnloadedVCAGuid);
+    Calls.ResetRecords();
+    FMODTimeFrames(3, RunGlobalMixer);
+    TestEqual(TEXT("Lookups of an unloaded VCA"), Calls.GetCount(FFMODRecordingStudioCalls::GetVCAByIDCall), 3);
+    TestEqual(TEXT("Volumes set with a VCA unloaded"), Calls.GetCount(FFMODRecordingStudioCalls::SetVCAVolumeCall), (NumVCAs - 1) * 3);
+
+    Calls.AddFakeVCA(UnloadedVCAGuid);
+    Calls.ResetRecords();
+    FMODTimeFrames(3, RunGlobalMixer);
+    TestEqual(TEXT("Lookups of a reloaded VCA"), Calls.GetCount(FFMODRecordingStudioCalls::GetVCAByIDCall), 1);
+    TestEqual(TEXT("Volumes set once the VCA is reloaded"), Calls.GetCount(FFMODRecordingStudioCalls::SetVCAVolumeCall), NumVCAs * 3);
+
+    // Hand the cache back to the runtime system, as the module left it
+    HandleCache.Reset(Module.GetStudioSystem(EFMODSystemContext::Runtime));
+    return true;
+}
+
+#endif
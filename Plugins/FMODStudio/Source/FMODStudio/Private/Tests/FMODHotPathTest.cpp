@@ -0,0 +1,294 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODBankLoader.h"
+#include "FMODListener.h"
+#include "FMODSettings.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODHotPathEmittersTest, "FMOD.HotPaths.Emitters",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODHotPathEmittersTest::RunTest(const FString &Parameters)
+{
+    const int32 NumEmitters = 2000;
+    const int32 NumInRange = NumEmitters / 2;
+    const int32 NumFrames = 60;
+    const float VirtualDistance = 5000.0f;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODEmitterManager &Manager = Module.GetEmitterManager();
+    if (Manager.Num() > 0)
+    {
+        AddWarning(TEXT("Skipped because other emitters are playing, which would make the call counts meaningless"));
+        return true;
+    }
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+
+    // Even emitters are in range of the listener, odd ones are out of range and get virtualized by the first update
+    const FVector ListenerLocation = Module.GetNearestListener(FVector::ZeroVector).Transform.GetTranslation();
+    TArray<UFMODAudioComponent *> Components;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        const float Distance = (i % 2 == 0) ? VirtualDistance * 0.5f : VirtualDistance * 4.0f;
+        const FVector Direction = FRotator(0.0f, 360.0f * i / NumEmitters, 0.0f).Vector();
+        UFMODAudioComponent *Component = TestWorld.SpawnEmitter(Calls, ListenerLocation + Direction * Distance, VirtualDistance);
+        Component->AttenuationDetails.bOverrideAttenuation = true;
+        Component->AttenuationDetails.MinimumDistance = 1.0f;
+        Component->AttenuationDetails.MaximumDistance = 50.0f;
+        Components.Add(Component);
+    }
+
+    Calls.ResetRecords();
+    double Seconds = FMODTimeFrames(1, [&](int32 Frame) { Manager.Update(true); });
+    Calls.Report(*this, TEXT("Listener moved"), Seconds, 1);
+    TestEqual(TEXT("Virtual emitters"), Manager.NumVirtual(), NumEmitters - NumInRange);
+    TestEqual(TEXT("Instances released by virtualization"), Calls.GetCount(FFMODRecordingStudioCalls::ReleaseCall), NumEmitters - NumInRange);
+    TestEqual(TEXT("Attenuation properties set"), Calls.GetCount(FFMODRecordingStudioCalls::SetPropertyCall), NumInRange * 2);
+    TestEqual(TEXT("Playback states checked"), Calls.GetCount(FFMODRecordingStudioCalls::GetPlaybackStateCall), NumInRange);
+
+    // Emitters in range move every frame, as if attached to moving actors
+    Calls.ResetRecords();
+    Seconds = FMODTimeFrames(NumFrames, [&](int32 Frame) {
+        for (int32 i = 0; i < NumEmitters; i += 2)
+        {
+            AActor *Owner = Components[i]->GetOwner();
+            Owner->SetActorLocation(Owner->GetActorLocation() + FVector(0.0f, 0.0f, 10.0f));
+        }
+        Manager.Update(false);
+    });
+    Calls.Report(*this, TEXT("Emitters moving"), Seconds, NumFrames);
+    TestEqual(TEXT("Positions set while moving"), Calls.GetCount(FFMODRecordingStudioCalls::Set3DAttributesCall), NumInRange * NumFrames);
+    TestEqual(TEXT("Attenuation properties set while moving"), Calls.GetCount(FFMODRecordingStudioCalls::SetPropertyCall), NumInRange * NumFrames * 2);
+    TestEqual(TEXT("Instances released while moving"), Calls.GetCount(FFMODRecordingStudioCalls::ReleaseCall), 0);
+
+    // Nothing moves, so the only call left per emitter is the playback state check
+    Calls.ResetRecords();
+    Seconds = FMODTimeFrames(NumFrames, [&](int32 Frame) { Manager.Update(false); });
+    Calls.Report(*this, TEXT("Emitters idle"), Seconds, NumFrames);
+    TestEqual(TEXT("Studio calls while idle"), Calls.GetTotalCount(), NumInRange * NumFrames);
+
+    // Real events finish in FMOD, virtual ones are stopped by the game
+    Calls.ResetRecords();
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        if (Components[i]->IsVirtual())
+        {
+            Components[i]->Stop();
+        }
+        else
+        {
+            Calls.SetFakePlaybackState(Components[i]->StudioInstance, FMOD_STUDIO_PLAYBACK_STOPPED);
+        }
+    }
+    Seconds = FMODTimeFrames(1, [&](int32 Frame) { Manager.Update(false); });
+    Calls.Report(*this, TEXT("Emitters completed"), Seconds, 1);
+    TestEqual(TEXT("Emitters left registered"), Manager.Num(), 0);
+    TestEqual(TEXT("Instances released on completion"), Calls.GetCount(FFMODRecordingStudioCalls::ReleaseCall), NumInRange);
+    TestEqual(TEXT("Fake instances left"), Calls.NumFakeInstances(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODHotPathSequencerTest, "FMOD.HotPaths.Sequencer",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODHotPathSequencerTest::RunTest(const FString &Parameters)
+{
+    const int32 NumEmitters = 200;
+    const int32 NumParameters = 8;
+    const int32 NumAnimated = 4;
+    const int32 NumFrames = 120;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODEmitterManager &Manager = Module.GetEmitterManager();
+    if (Manager.Num() > 0)
+    {
+        AddWarning(TEXT("Skipped because other emitters are playing, which would make the call counts meaningless"));
+        return true;
+    }
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+
+    const FVector ListenerLocation = Module.GetNearestListener(FVector::ZeroVector).Transform.GetTranslation();
+    TArray<UFMODAudioComponent *> Components;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        Components.Add(TestWorld.SpawnEmitter(Calls, ListenerLocation + FVector(100.0f * i, 0.0f, 0.0f), 0.0f));
+    }
+
+    TArray<FName> Names;
+    for (int32 i = 0; i < NumParameters; ++i)
+    {
+        Names.Add(FName(*FString::Printf(TEXT("Parameter%d"), i)));
+    }
+
+    // What the parameter track's execution tokens do each frame for every bound component: the first curves change every frame,
+    // the rest hold their value. The events have no parameter IDs, so values are set by name.
+    Calls.ResetRecords();
+    TArray<float> Values;
+    Values.SetNumZeroed(NumParameters);
+    double Seconds = FMODTimeFrames(NumFrames, [&](int32 Frame) {
+        for (int32 i = 0; i < NumAnimated; ++i)
+        {
+            Values[i] = Frame / float(NumFrames);
+        }
+        for (UFMODAudioComponent *Component : Components)
+        {
+            Component->SetParameters(Names, Values);
+        }
+    });
+    Calls.Report(*this, TEXT("Sequencer parameters"), Seconds, NumFrames);
+    TestEqual(TEXT("Parameters set"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall),
+        NumEmitters * (NumParameters + NumAnimated * (NumFrames - 1)));
+
+    // A stop key, then restoring the state from before the sequence. Stopped events don't have their parameters set.
+    Calls.ResetRecords();
+    TArray<float> Restored;
+    Restored.SetNumZeroed(NumParameters);
+    Seconds = FMODTimeFrames(1, [&](int32 Frame) {
+        for (UFMODAudioComponent *Component : Components)
+        {
+            Component->Stop();
+            Calls.SetFakePlaybackState(Component->StudioInstance, FMOD_STUDIO_PLAYBACK_STOPPED);
+        }
+        Manager.Update(false);
+        for (UFMODAudioComponent *Component : Components)
+        {
+            Component->SetParameters(Names, Restored);
+        }
+    });
+    Calls.Report(*this, TEXT("Sequencer stop and restore"), Seconds, 1);
+    TestEqual(TEXT("Events stopped"), Calls.GetCount(FFMODRecordingStudioCalls::StopCall), NumEmitters * 2);
+    TestEqual(TEXT("Parameters set on stopped events"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall), 0);
+    TestEqual(TEXT("Emitters left registered"), Manager.Num(), 0);
+    TestEqual(TEXT("Fake instances left"), Calls.NumFakeInstances(), 0);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODHotPathListenersTest, "FMOD.HotPaths.Listeners",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODHotPathListenersTest::RunTest(const FString &Parameters)
+{
+    const int32 NumFrames = 120;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    if (Module.GetStudioSystem(EFMODSystemContext::Runtime) == nullptr)
+    {
+        AddInfo(TEXT("Skipped because there is no runtime system to update listeners for"));
+        return true;
+    }
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+
+    const FTransform StartTransform = Module.GetNearestListener(FVector::ZeroVector).Transform;
+    FTransform Transform = StartTransform;
+    Transform.AddToTranslation(FVector(1000.0f, 0.0f, 0.0f));
+
+    // The listener moves for the first half, then stands still, which is passed on once to zero its velocity
+    const float DeltaSeconds = 1.0f / 60.0f;
+    double Seconds = FMODTimeFrames(NumFrames, [&](int32 Frame) {
+        if (Frame < NumFrames / 2)
+        {
+            Transform.AddToTranslation(FVector(10.0f, 0.0f, 0.0f));
+        }
+        Module.SetListenerPosition(0, TestWorld.World, Transform, DeltaSeconds);
+        Module.FinishSetListenerPosition(1);
+    });
+    Calls.Report(*this, TEXT("Listener"), Seconds, NumFrames);
+    TestEqual(TEXT("Listener attributes set"), Calls.GetCount(FFMODRecordingStudioCalls::SetListenerAttributesCall), NumFrames / 2 + 1);
+
+    Module.SetListenerPosition(0, TestWorld.World, StartTransform, DeltaSeconds);
+    Module.FinishSetListenerPosition(1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODHotPathBankLoadingTest, "FMOD.HotPaths.BankLoading",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODHotPathBankLoadingTest::RunTest(const FString &Parameters)
+{
+    const int32 NumBanks = 64;
+    const int32 MaxFrames = NumBanks * 3;
+
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (Settings.BankLoadsPerFrame <= 0)
+    {
+        AddInfo(TEXT("Skipped because the settings don't allow any bank loads per frame"));
+        return true;
+    }
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODBankLoader Loader;
+    Loader.Reset(Calls.GetFakeSystem());
+
+    TArray<FString> Paths;
+    for (int32 i = 0; i < NumBanks; ++i)
+    {
+        Paths.Add(FString::Printf(TEXT("HotPathTest/Bank%d.bank"), i));
+    }
+
+    auto RequestAll = [&]() {
+        for (int32 i = 0; i < NumBanks; ++i)
+        {
+            Loader.RequestBank(Paths[i], i % 4, i % 2 == 0);
+        }
+    };
+    auto LoadAll = [&]() {
+        int32 Frames = 0;
+        const double StartTime = FPlatformTime::Seconds();
+        while (Loader.NumPending() > 0 && Frames < MaxFrames)
+        {
+            Loader.Update();
+            ++Frames;
+        }
+        return TPair<int32, double>(Frames, FPlatformTime::Seconds() - StartTime);
+    };
+
+    RequestAll();
+    TPair<int32, double> Result = LoadAll();
+    Calls.Report(*this, TEXT("Bank loading"), Result.Value, Result.Key);
+    TestEqual(TEXT("Banks left to load"), Loader.NumPending(), 0);
+    TestEqual(TEXT("Bank files loaded"), Calls.GetCount(FFMODRecordingStudioCalls::LoadBankFileCall), NumBanks);
+    TestEqual(TEXT("Sample data loads"), Calls.GetCount(FFMODRecordingStudioCalls::LoadSampleDataCall), NumBanks / 2);
+    TestEqual(TEXT("Banks loaded"), Calls.NumFakeBanks(), NumBanks);
+
+    // Reloading releases every bank before requesting it again, like a map change with no banks in common
+    Calls.ResetRecords();
+    const double StartTime = FPlatformTime::Seconds();
+    for (const FString &Path : Paths)
+    {
+        Loader.ReleaseBank(Path);
+    }
+    const double ReleaseSeconds = FPlatformTime::Seconds() - StartTime;
+    TestEqual(TEXT("Banks unloaded"), Calls.GetCount(FFMODRecordingStudioCalls::UnloadCall), NumBanks);
+    TestEqual(TEXT("Banks left after release"), Calls.NumFakeBanks(), 0);
+
+    RequestAll();
+    Result = LoadAll();
+    Calls.Report(*this, TEXT("Bank reload"), ReleaseSeconds + Result.Value, Result.Key);
+    TestEqual(TEXT("Bank files reloaded"), Calls.GetCount(FFMODRecordingStudioCalls::LoadBankFileCall), NumBanks);
+    TestEqual(TEXT("Banks loaded after reload"), Calls.NumFakeBanks(), NumBanks);
+
+    for (const FString &Path : Paths)
+    {
+        Loader.ReleaseBank(Path);
+    }
+    return true;
+}
+
+#endif
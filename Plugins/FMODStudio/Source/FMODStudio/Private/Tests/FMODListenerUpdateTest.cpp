@@ -0,0 +1,120 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODListener.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODListenerUpdateTest, "FMOD.ListenerUpdate",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODListenerUpdateTest::RunTest(const FString &Parameters)
+{
+    const int32 NumEmitters = 200;
+    const int32 NumIdleFrames = 300;
+    const int32 NumMovingFrames = 60;
+    const float FrameSeconds = 1.0f / 60.0f;
+    const float FlySpeed = 600.0f;
+    const float CreepSpeed = 3.0f;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODEmitterManager &Manager = Module.GetEmitterManager();
+    if (!Module.UseSound() || !Module.GetStudioSystem(EFMODSystemContext::Runtime) || Manager.Num() > 0)
+    {
+        AddWarning(TEXT("Skipped because there is no runtime Studio system or other emitters are playing"));
+        return true;
+    }
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+    TArray<UFMODAudioComponent *> Components;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        Components.Add(TestWorld.SpawnEmitter(Calls, FVector(i * 100.0f, 1000.0f, 0.0f), 0.0f));
+    }
+
+    // A fake viewport: the camera transform for each frame goes through the same stage the level viewport and player controllers use.
+    // The module clears the moved flag after updating the emitters, here a frame that passed attributes to FMOD stands in for it.
+    const FTransform SavedTransform = Module.GetNearestListener(FVector::ZeroVector).Transform;
+    FTransform Camera = SavedTransform;
+    const FFMODListener &Listener = Module.GetNearestListener(Camera.GetTranslation());
+    int32 ListenerUpdates = 0;
+    int32 EmitterUpdates = 0;
+    float MaxSpeed = 0.0f;
+    auto RunFrames = [&](int32 NumFrames, const FVector &Step, TFunctionRef<FVector(int32)> Jitter) {
+        const FVector Start = Camera.GetTranslation();
+        return FMODTimeFrames(NumFrames, [&](int32 Frame) {
+            Camera.SetTranslation(Start + Step * (Frame + 1) + Jitter(Frame));
+            const int32 CallsBefore = Calls.GetCount(FFMODRecordingStudioCalls::SetListenerAttributesCall);
+            Module.SetListenerPosition(0, TestWorld.World, Camera, FrameSeconds);
+            Module.FinishSetListenerPosition(1);
+            const bool bMoved = Calls.GetCount(FFMODRecordingStudioCalls::SetListenerAttributesCall) > CallsBefore;
+            Manager.Update(bMoved);
+            ListenerUpdates += bMoved;
+            EmitterUpdates += Manager.NumListenerUpdates();
+            MaxSpeed = FMath::Max(MaxSpeed, Listener.Velocity.Size());
+        });
+    };
+    auto NoJitter = [](int32) { return FVector::ZeroVector; };
+    auto ResetCounts = [&]() {
+        Calls.ResetRecords();
+        ListenerUpdates = 0;
+        EmitterUpdates = 0;
+        MaxSpeed = 0.0f;
+    };
+
+    // Let the listener settle where the test starts
+    RunFrames(3, FVector::ZeroVector, NoJitter);
+
+    // An idle editor camera, with the float noise of a viewport that isn't being moved
+    ResetCounts();
+    FRandomStream Random(0x0F30D);
+    double Seconds = RunFrames(NumIdleFrames, FVector::ZeroVector, [&Random](int32) { return Random.GetUnitVector() * 0.01f; });
+    Calls.Report(*this, TEXT("Idle camera"), Seconds, NumIdleFrames);
+    AddInfo(FString::Printf(TEXT("Idle camera: %.2f emitter listener updates per frame, %d before the listener stage skipped still frames"),
+        (float)EmitterUpdates / NumIdleFrames, NumEmitters));
+    TestEqual(TEXT("Listener updates for an idle camera"), ListenerUpdates, 0);
+    TestEqual(TEXT("Emitter listener updates for an idle camera"), EmitterUpdates, 0);
+
+    // A flying camera updates every frame, with its velocity measured over the frame
+    ResetCounts();
+    Seconds = RunFrames(NumMovingFrames, FVector(FlySpeed * FrameSeconds, 0.0f, 0.0f), NoJitter);
+    Calls.Report(*this, TEXT("Flying camera"), Seconds, NumMovingFrames);
+    TestEqual(TEXT("Listener updates for a flying camera"), ListenerUpdates, NumMovingFrames);
+    TestEqual(TEXT("Emitter listener updates for a flying camera"), EmitterUpdates, NumMovingFrames * NumEmitters);
+    TestTrue(FString::Printf(TEXT("Flying camera velocity (%s)"), *Listener.Velocity.ToString()),
+        Listener.Velocity.Equals(FVector(FlySpeed, 0.0f, 0.0f), 1.0f));
+
+    // Stopping passes the zero velocity on once, and then nothing more
+    ResetCounts();
+    RunFrames(10, FVector::ZeroVector, NoJitter);
+    TestEqual(TEXT("Listener updates after stopping"), ListenerUpdates, 1);
+    TestTrue(TEXT("Velocity after stopping"), Listener.Velocity.IsZero());
+
+    // A camera creeping slower than the epsilon per frame is only passed on every few frames, with the velocity of the whole movement
+    ResetCounts();
+    RunFrames(NumMovingFrames, FVector(CreepSpeed * FrameSeconds, 0.0f, 0.0f), NoJitter);
+    TestTrue(FString::Printf(TEXT("Listener updates for a creeping camera (%d)"), ListenerUpdates),
+        ListenerUpdates > 0 && ListenerUpdates < NumMovingFrames);
+    TestTrue(FString::Printf(TEXT("Creeping camera velocity (%f)"), MaxSpeed), FMath::IsNearlyEqual(MaxSpeed, CreepSpeed, 0.1f));
+    TestTrue(TEXT("Listener within the epsilon of a creeping camera"),
+        FVector::Dist(Listener.Transform.GetTranslation(), Camera.GetTranslation()) <= 0.1f);
+
+    // Put the listener back where it was, at rest
+    Camera = SavedTransform;
+    RunFrames(2, FVector::ZeroVector, NoJitter);
+
+    for (UFMODAudioComponent *Component : Components)
+    {
+        Component->Release();
+        Component->SetActiveFlag(false);
+    }
+    TestEqual(TEXT("Fake instances left"), Calls.NumFakeInstances(), 0);
+    return true;
+}
+
+#endif
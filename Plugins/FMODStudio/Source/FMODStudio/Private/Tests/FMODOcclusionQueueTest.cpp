@@ -0,0 +1,176 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODOcclusionQueue.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODOcclusionQueueTest, "FMOD.OcclusionQueue",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODOcclusionQueueTest::RunTest(const FString &Parameters)
+{
+    const int32 NumEmitters = 1000;
+    const int32 TracesPerFrame = 64;
+
+    // Every tenth emitter has nothing to trace from, like a component without an owner
+    auto CanTrace = [](int32 Index) { return Index % 10 != 0; };
+
+    FFMODOcclusionQueue Queue;
+    TArray<UFMODAudioComponent *> Components;
+    TMap<UFMODAudioComponent *, int32> Indices;
+    int32 NumTraceable = 0;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        UFMODAudioComponent *Component = NewObject<UFMODAudioComponent>();
+        Component->AddToRoot();
+        Component->bOcclusionTracePending = true;
+        Components.Add(Component);
+        Indices.Add(Component, i);
+        Queue.Add(Component);
+        NumTraceable += CanTrace(i);
+    }
+
+    TArray<int32> TraceCounts;
+    TraceCounts.SetNumZeroed(NumEmitters);
+    TMap<uint32, int32> TraceIds;
+    int32 LastTraced = INDEX_NONE;
+    bool bInOrder = true;
+    bool bWithinBudget = true;
+    int32 Frames = 0;
+    while (Queue.NumQueued() > 0 && Frames < NumEmitters)
+    {
+        int32 Started = Queue.Update(TracesPerFrame, [&](UFMODAudioComponent &Component, uint32 TraceId) {
+            int32 Index = Indices.FindChecked(&Component);
+            if (!CanTrace(Index))
+            {
+                return false;
+            }
+            bInOrder &= Index > LastTraced;
+            LastTraced = Index;
+            ++TraceCounts[Index];
+            TraceIds.Add(TraceId, Index);
+            return true;
+        });
+        bWithinBudget &= Started <= TracesPerFrame;
+        ++Frames;
+    }
+
+    TestTrue(TEXT("No more than the per-frame budget is traced each frame"), bWithinBudget);
+    TestTrue(TEXT("Emitters are traced in the order they were queued"), bInOrder);
+    TestEqual(TEXT("Frames to drain the queue"), Frames, FMath::DivideAndRoundUp(NumTraceable, TracesPerFrame));
+    TestEqual(TEXT("Traces in flight"), Queue.NumInFlight(), NumTraceable);
+
+    int32 WrongCounts = 0;
+    int32 WrongPending = 0;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        WrongCounts += TraceCounts[i] != (CanTrace(i) ? 1 : 0);
+        WrongPending += Components[i]->bOcclusionTracePending != CanTrace(i);
+    }
+    TestEqual(TEXT("Emitters not traced exactly once"), WrongCounts, 0);
+    TestEqual(TEXT("Emitters with the wrong pending state after queueing"), WrongPending, 0);
+
+    // Complete every other trace, then drop the rest
+    int32 Completed = 0;
+    for (const TPair<uint32, int32> &Trace : TraceIds)
+    {
+        if (Trace.Value % 2 == 0)
+        {
+            Queue.Complete(Trace.Key, true);
+            ++Completed;
+        }
+    }
+    TestEqual(TEXT("Traces in flight after completion"), Queue.NumInFlight(), NumTraceable - Completed);
+
+    Queue.Reset();
+    TestEqual(TEXT("Traces in flight after reset"), Queue.NumInFlight(), 0);
+
+    for (UFMODAudioComponent *Component : Components)
+    {
+        Component->RemoveFromRoot();
+        Component->MarkPendingKill();
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODOcclusionQueueWorldCleanupTest, "FMOD.OcclusionQueue.WorldCleanup",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODOcclusionQueueWorldCleanupTest::RunTest(const FString &Parameters)
+{
+    const int32 NumPerWorld = 100;
+
+    FFMODOcclusionQueue Queue;
+    FFMODTestWorld RemovedWorld;
+    FFMODTestWorld OtherWorld;
+    TArray<UFMODAudioComponent *> RemovedComponents;
+    TArray<UFMODAudioComponent *> OtherComponents;
+    for (int32 i = 0; i < NumPerWorld; ++i)
+    {
+        const FVector Location(i * 100.0f, 0.0f, 0.0f);
+        for (FFMODTestWorld *TestWorld : { &RemovedWorld, &OtherWorld })
+        {
+            UFMODAudioComponent *Component =
+                TestWorld->World->SpawnActor<AFMODAmbientSound>(Location, FRotator::ZeroRotator)->AudioComponent;
+            Component->bOcclusionTracePending = true;
+            Queue.Add(Component);
+            (TestWorld == &RemovedWorld ? RemovedComponents : OtherComponents).Add(Component);
+        }
+    }
+
+    // Start traces for the first half of the queue, so each world has emitters both queued and waiting for a trace result
+    TMap<uint32, UFMODAudioComponent *> Traces;
+    auto StartTrace = [&Traces](UFMODAudioComponent &Component, uint32 TraceId) {
+        Traces.Add(TraceId, &Component);
+        return true;
+    };
+    Queue.Update(NumPerWorld, StartTrace);
+    TestEqual(TEXT("Traces in flight before world cleanup"), Queue.NumInFlight(), NumPerWorld);
+    TestEqual(TEXT("Emitters queued before world cleanup"), Queue.NumQueued(), NumPerWorld);
+
+    Queue.RemoveWorld(RemovedWorld.World);
+    TestEqual(TEXT("Traces in flight after world cleanup"), Queue.NumInFlight(), NumPerWorld / 2);
+    TestEqual(TEXT("Emitters queued after world cleanup"), Queue.NumQueued(), NumPerWorld / 2);
+
+    int32 RemovedPending = 0;
+    for (UFMODAudioComponent *Component : RemovedComponents)
+    {
+        RemovedPending += Component->bOcclusionTracePending;
+    }
+    int32 OtherPending = 0;
+    for (UFMODAudioComponent *Component : OtherComponents)
+    {
+        OtherPending += Component->bOcclusionTracePending;
+    }
+    TestEqual(TEXT("Removed world's emitters still pending"), RemovedPending, 0);
+    TestEqual(TEXT("Other world's emitters still pending"), OtherPending, NumPerWorld);
+
+    // Results for the removed world's traces arrive after cleanup and must not be applied
+    for (const TPair<uint32, UFMODAudioComponent *> &Trace : Traces)
+    {
+        if (Trace.Value->GetWorld() == RemovedWorld.World)
+        {
+            Queue.Complete(Trace.Key, true);
+        }
+    }
+    TestEqual(TEXT("Traces in flight after late results"), Queue.NumInFlight(), NumPerWorld / 2);
+
+    // Only the other world's emitters are left to trace
+    int32 RemovedTraced = 0;
+    Queue.Update(NumPerWorld * 2, [&](UFMODAudioComponent &Component, uint32 TraceId) {
+        RemovedTraced += Component.GetWorld() == RemovedWorld.World;
+        return StartTrace(Component, TraceId);
+    });
+    TestEqual(TEXT("Removed world's emitters traced after cleanup"), RemovedTraced, 0);
+    TestEqual(TEXT("Traces in flight for the other world"), Queue.NumInFlight(), NumPerWorld);
+    TestEqual(TEXT("Emitters queued after draining"), Queue.NumQueued(), 0);
+
+    return true;
+}
+
+#endif
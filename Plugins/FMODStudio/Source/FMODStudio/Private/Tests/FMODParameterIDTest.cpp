@@ -0,0 +1,95 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODEvent.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODParameterIDTest, "FMOD.ParameterIDs",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODParameterIDTest::RunTest(const FString &Parameters)
+{
+    const int32 NumCalls = 1000000;
+    const int32 NumParameters = 8;
+
+    FFMODRecordingStudioCalls Calls;
+    FMOD::Studio::EventInstance *Instance = Calls.CreateFakeInstance();
+
+    // The same FName-keyed table UFMODEvent resolves from the event description, with as many curves as a busy Sequencer track
+    TArray<FName> Names;
+    TMap<FName, FMOD_STUDIO_PARAMETER_ID> ParameterIDs;
+    for (int32 i = 0; i < NumParameters; ++i)
+    {
+        const FName Name(*FString::Printf(TEXT("Parameter %d"), i));
+        FMOD_STUDIO_PARAMETER_ID ID;
+        ID.data1 = i;
+        ID.data2 = ~i;
+        Names.Add(Name);
+        ParameterIDs.Add(Name, ID);
+    }
+
+    // The name path converts every name to UTF-8 before FMOD looks it up, the ID path only finds the name in the table
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        Calls.SetParameterByName(Instance, TCHAR_TO_UTF8(*Names[i % NumParameters].ToString()), (float)i);
+    }
+    const double NameSeconds = FPlatformTime::Seconds() - StartTime;
+
+    StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        const FMOD_STUDIO_PARAMETER_ID *ID = ParameterIDs.Find(Names[i % NumParameters]);
+        Calls.SetParameterByID(Instance, *ID, (float)i);
+    }
+    const double IDSeconds = FPlatformTime::Seconds() - StartTime;
+
+    AddInfo(FString::Printf(TEXT("%d calls: %.1f ms by name, %.1f ms by ID (%.2fx)"), NumCalls, NameSeconds * 1000.0, IDSeconds * 1000.0,
+        IDSeconds > 0.0 ? NameSeconds / IDSeconds : 0.0));
+    TestEqual(TEXT("Calls by name"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall), NumCalls);
+    TestEqual(TEXT("Calls by ID"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByIDCall), NumCalls);
+
+    // Without a loaded description the event has no IDs, so the component keeps using names
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+    UFMODEvent *Event = NewObject<UFMODEvent>();
+    FMOD_STUDIO_PARAMETER_ID ID;
+    TestFalse(TEXT("Parameter found without an event description"), Event->FindParameterID(Names[0], ID));
+
+    UFMODAudioComponent *Component = TestWorld.SpawnEmitter(Calls, FVector::ZeroVector, 0.0f);
+    Component->Event = Event;
+    Calls.ResetRecords();
+    for (const FName &Name : Names)
+    {
+        Component->SetParameter(Name, 1.0f);
+    }
+    TestEqual(TEXT("Component calls by name without IDs"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall), NumParameters);
+    TestEqual(TEXT("Component calls by ID without IDs"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByIDCall), 0);
+
+    // Once the description is cached its info carries the IDs, so the component switches to setting them by ID
+    Calls.AddFakeEvent(Event, true, false, 1000.0f, 0, Names);
+    FMOD_STUDIO_PARAMETER_DESCRIPTION Description;
+    Calls.GetParameterDescriptionByName(
+        Calls.GetEventDescriptionInfo(Event, EFMODSystemContext::Max)->Description, TCHAR_TO_UTF8(*Names[0].ToString()), &Description);
+    TestTrue(TEXT("Parameter found in the event description"), Event->FindParameterID(Names[0], ID));
+    TestTrue(TEXT("Parameter ID matches the description"), ID.data1 == Description.id.data1 && ID.data2 == Description.id.data2);
+    TestFalse(TEXT("Unknown parameter found"), Event->FindParameterID(FName(TEXT("Unknown")), ID));
+
+    Calls.ResetRecords();
+    for (const FName &Name : Names)
+    {
+        Component->SetParameter(Name, 2.0f);
+    }
+    TestEqual(TEXT("Component calls by name with IDs"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall), 0);
+    TestEqual(TEXT("Component calls by ID with IDs"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByIDCall), NumParameters);
+
+    Component->Release();
+    Component->SetActiveFlag(false);
+    return true;
+}
+
+#endif
@@ -0,0 +1,157 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODProgrammerSoundCache.h"
+#include "FMODSettings.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODProgrammerSoundCacheTest, "FMOD.ProgrammerSoundCache",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODProgrammerSoundCacheTest::RunTest(const FString &Parameters)
+{
+    const int32 NumLines = 6;
+    const int32 NumPreloadedLines = 4;
+    const int32 NumPlays = 50;
+    const uint32 LineSize = 1024 * 1024;
+    const float CreateDelay = 0.005f;
+    const int32 Budget = 3;
+
+    UFMODSettings &Settings = *GetMutableDefault<UFMODSettings>();
+    const int32 SavedBudget = Settings.ProgrammerSoundMemoryBudget;
+    Settings.ProgrammerSoundMemoryBudget = Budget;
+
+    // Dialogue lines in the fake system's audio table, each taking a while to open as if read from a slow disk
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    Calls.SetFakeSoundCreateDelay(CreateDelay);
+    TArray<FString> Lines;
+    for (int32 i = 0; i < NumLines; ++i)
+    {
+        Lines.Add(FString::Printf(TEXT("Line%d"), i));
+        Calls.AddFakeAudioTableEntry(Lines[i], LineSize);
+    }
+    Calls.AddFakeAudioTableEntry(TEXT("Music"), LineSize, true);
+
+    FMOD::Studio::System *System = Calls.GetFakeSystem();
+    FFMODProgrammerSoundCache Cache;
+    Cache.Reset(System);
+
+    // What the create programmer sound callback does for an instance, returning the time it took
+    int32 FailedAcquires = 0;
+    auto Acquire = [&](const FString &Name, FMOD::Sound *&OutSound) {
+        int32 SubsoundIndex = -1;
+        const double StartTime = FPlatformTime::Seconds();
+        FailedAcquires += !Cache.Acquire(System, Name, OutSound, SubsoundIndex);
+        return FPlatformTime::Seconds() - StartTime;
+    };
+
+    // A line played over and over is opened once, only the first callback waits for it
+    const FFMODProgrammerSoundStats StartStats = Cache.GetStats();
+    double FirstSeconds = 0.0;
+    double WarmSeconds = 0.0;
+    for (int32 i = 0; i < NumPlays; ++i)
+    {
+        FMOD::Sound *Sound = nullptr;
+        const double Seconds = Acquire(Lines[0], Sound);
+        (i == 0 ? FirstSeconds : WarmSeconds) += Seconds;
+        Cache.Release(Sound);
+    }
+    Calls.Report(*this, FString::Printf(TEXT("One line played %d times"), NumPlays), FirstSeconds + WarmSeconds, NumPlays);
+    AddInfo(FString::Printf(TEXT("First callback %.3f ms, later callbacks %.4f ms on average"), FirstSeconds * 1000.0,
+        WarmSeconds * 1000.0 / (NumPlays - 1)));
+    TestEqual(TEXT("Sounds created for a repeated line"), Calls.GetCount(FFMODRecordingStudioCalls::CreateSoundCall), 1);
+    TestEqual(TEXT("Audio table lookups for a repeated line"), Calls.GetCount(FFMODRecordingStudioCalls::GetSoundInfoCall), 1);
+    TestEqual(TEXT("Sounds reused"), (int32)(Cache.GetStats().SoundsReused - StartStats.SoundsReused), NumPlays - 1);
+    TestEqual(TEXT("Sounds released while cached"), Calls.GetCount(FFMODRecordingStudioCalls::ReleaseSoundCall), 0);
+    TestTrue(TEXT("Later callbacks don't wait on the disk"), WarmSeconds / (NumPlays - 1) < CreateDelay / 10.0f);
+
+    // Preloading upcoming dialogue moves the wait off the callbacks
+    for (int32 i = 1; i <= NumPreloadedLines; ++i)
+    {
+        TestTrue(TEXT("Line preloaded"), Cache.LoadSound(Lines[i]));
+    }
+    Calls.ResetRecords();
+    double PreloadedSeconds = 0.0;
+    TArray<FMOD::Sound *> Sounds;
+    for (int32 i = 1; i <= NumPreloadedLines; ++i)
+    {
+        PreloadedSeconds += Acquire(Lines[i], Sounds.AddDefaulted_GetRef());
+    }
+    TestEqual(TEXT("Sounds created for preloaded lines"), Calls.GetCount(FFMODRecordingStudioCalls::CreateSoundCall), 0);
+    TestTrue(FString::Printf(TEXT("Callbacks for preloaded lines (%.3f ms)"), PreloadedSeconds * 1000.0), PreloadedSeconds < CreateDelay);
+    for (FMOD::Sound *Sound : Sounds)
+    {
+        Cache.Release(Sound);
+    }
+
+    // Instances playing the same line at once share its sound
+    FMOD::Sound *SoundA = nullptr;
+    FMOD::Sound *SoundB = nullptr;
+    Calls.ResetRecords();
+    Acquire(Lines[5], SoundA);
+    Acquire(Lines[5], SoundB);
+    TestTrue(TEXT("Instances share a line's sound"), SoundA != nullptr && SoundA == SoundB);
+    TestEqual(TEXT("Sounds created for two instances of a line"), Calls.GetCount(FFMODRecordingStudioCalls::CreateSoundCall), 1);
+    Cache.Release(SoundA);
+    Cache.Release(SoundB);
+    TestEqual(TEXT("Cached sounds"), Calls.NumFakeSounds(), NumLines);
+
+    // Streams can't be shared, each instance gets its own and it goes with the instance
+    Calls.ResetRecords();
+    Acquire(TEXT("Music"), SoundA);
+    Acquire(TEXT("Music"), SoundB);
+    TestTrue(TEXT("Instances get a stream each"), SoundA != nullptr && SoundB != nullptr && SoundA != SoundB);
+    TestFalse(TEXT("Streams preloaded"), Cache.LoadSound(TEXT("Music")));
+    Cache.Release(SoundA);
+    Cache.Release(SoundB);
+    TestEqual(TEXT("Sounds left after the streams are released"), Calls.NumFakeSounds(), NumLines);
+
+    // Unused lines over the budget are evicted oldest first, once they have opened and their size is known
+    for (int32 i = 1; i <= NumPreloadedLines; ++i)
+    {
+        Cache.UnloadSound(Lines[i]);
+    }
+    FPlatformProcess::Sleep(0.01f);
+    Acquire(Lines[0], SoundA);
+    Cache.Release(SoundA);
+
+    const uint32 EvictedBefore = Cache.GetStats().SoundsEvicted;
+    Cache.Update();
+    TestEqual(TEXT("Sounds evicted while still opening"), Calls.NumFakeSounds(), NumLines);
+    Cache.Update();
+    TestEqual(TEXT("Sounds left within the budget"), Calls.NumFakeSounds(), Budget);
+    TestEqual(TEXT("Sounds evicted"), (int32)(Cache.GetStats().SoundsEvicted - EvictedBefore), NumLines - Budget);
+
+    Calls.ResetRecords();
+    Acquire(Lines[0], SoundA);
+    TestEqual(TEXT("Sounds created for the most recently played line"), Calls.GetCount(FFMODRecordingStudioCalls::CreateSoundCall), 0);
+
+    // Unloading the bank with the audio table drops its sounds, the one still playing goes when its instance is done
+    Cache.ReleaseAudioTableSounds();
+    TestEqual(TEXT("Sounds left after unloading the audio table"), Calls.NumFakeSounds(), 1);
+    Cache.Release(SoundA);
+    TestEqual(TEXT("Fake sounds left"), Calls.NumFakeSounds(), 0);
+
+    // Destroying the system releases the cached sounds first, the one still playing goes when its instance is done
+    Acquire(Lines[1], SoundA);
+    Acquire(Lines[2], SoundB);
+    Cache.Release(SoundB);
+    TestTrue(TEXT("Line preloaded before the reset"), Cache.LoadSound(Lines[3]));
+    TestEqual(TEXT("Sounds before the reset"), Calls.NumFakeSounds(), 3);
+    Cache.Reset(nullptr);
+    TestEqual(TEXT("Sounds left after the reset"), Calls.NumFakeSounds(), 1);
+    Cache.Release(SoundA);
+    TestEqual(TEXT("Sounds left after the last instance"), Calls.NumFakeSounds(), 0);
+    TestEqual(TEXT("Failed acquires"), FailedAcquires, 0);
+
+    Settings.ProgrammerSoundMemoryBudget = SavedBudget;
+    return true;
+}
+
+#endif
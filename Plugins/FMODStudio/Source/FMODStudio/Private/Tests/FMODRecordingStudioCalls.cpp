@@ -0,0 +1,818 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODRecordingStudioCalls.h"
+#include "FMODUtils.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const TCHAR *CALL_NAMES[FFMODRecordingStudioCalls::NumCalls] = {
+    TEXT("IFMODStudioModule::GetEventDescriptionInfo"),
+    TEXT("System::getEventByID"),
+    TEXT("EventDescription::getParameterDescriptionByName"),
+    TEXT("EventDescription::createInstance"),
+    TEXT("EventInstance::isValid"),
+    TEXT("EventInstance::start"),
+    TEXT("EventInstance::stop"),
+    TEXT("EventInstance::release"),
+    TEXT("EventInstance::getPlaybackState"),
+    TEXT("EventInstance::set3DAttributes"),
+    TEXT("EventInstance::setParameterByID"),
+    TEXT("EventInstance::setParametersByIDs"),
+    TEXT("EventInstance::setParameterByName"),
+    TEXT("EventInstance::setProperty"),
+    TEXT("EventInstance::setCallback"),
+    TEXT("EventInstance::setUserData"),
+    TEXT("EventInstance::setTimelinePosition"),
+    TEXT("EventInstance::getTimelinePosition"),
+    TEXT("System::setNumListeners"),
+    TEXT("System::setListenerAttributes"),
+    TEXT("System::getBusByID"),
+    TEXT("Bus::isValid"),
+    TEXT("Bus::setVolume"),
+    TEXT("System::getVCAByID"),
+    TEXT("VCA::isValid"),
+    TEXT("VCA::setVolume"),
+    TEXT("System::getParameterDescriptionByName"),
+    TEXT("System::setParameterByID"),
+    TEXT("System::setParameterByName"),
+    TEXT("System::getParameterByID"),
+    TEXT("System::getParameterByName"),
+    TEXT("System::getSoundInfo"),
+    TEXT("System::createSound"),
+    TEXT("Sound::getOpenState"),
+    TEXT("Sound::getLength"),
+    TEXT("Sound::release"),
+    TEXT("System::loadBankFile"),
+    TEXT("System::flushCommands"),
+    TEXT("Bank::getLoadingState"),
+    TEXT("Bank::loadSampleData"),
+    TEXT("Bank::unload"),
+};
+
+/** Fake parameters are identified by a hash of their UTF-8 name, so they can be set by name or ID alike */
+static FMOD_STUDIO_PARAMETER_ID MakeFakeParameterID(const char *Name)
+{
+    FMOD_STUDIO_PARAMETER_ID ID;
+    ID.data1 = FCrc::MemCrc32(Name, FCStringAnsi::Strlen(Name));
+    ID.data2 = 0;
+    return ID;
+}
+
+FFMODRecordingStudioCalls::FFMODRecordingStudioCalls()
+    : FakeSoundCreateDelay(0.0f)
+    , FakeSystem(0)
+{
+    ResetRecords();
+}
+
+FMOD::Studio::EventInstance *FFMODRecordingStudioCalls::CreateFakeInstance()
+{
+    TUniquePtr<FFakeInstance> Fake = MakeUnique<FFakeInstance>();
+    Fake->State = FMOD_STUDIO_PLAYBACK_PLAYING;
+    FMOD::Studio::EventInstance *Instance = reinterpret_cast<FMOD::Studio::EventInstance *>(Fake.Get());
+    FakeInstances.Add(Instance, MoveTemp(Fake));
+    return Instance;
+}
+
+void FFMODRecordingStudioCalls::AddFakeEvent(
+    const UFMODEvent *Event, bool bIs3D, bool bOneshot, float MaximumDistance, int Length, const TArray<FName> &ParameterNames)
+{
+    TUniquePtr<FFMODEventDescriptionInfo> Info = MakeUnique<FFMODEventDescriptionInfo>();
+    Info->Description = reinterpret_cast<FMOD::Studio::EventDescription *>(Info.Get());
+    Info->bIs3D = bIs3D;
+    Info->bOneshot = bOneshot;
+    Info->MaximumDistance = MaximumDistance;
+    Info->Length = Length;
+    for (const FName &Name : ParameterNames)
+    {
+        // The description only points at the name, so keep a copy that lives as long as this object
+        FTCHARToUTF8 Utf8Name(*Name.ToString());
+        TArray<ANSICHAR> &StoredName = FakeParameterNames.AddDefaulted_GetRef();
+        StoredName.Append(Utf8Name.Get(), Utf8Name.Length() + 1);
+
+        FMOD_STUDIO_PARAMETER_DESCRIPTION Parameter;
+        FMemory::Memzero(Parameter);
+        Parameter.name = StoredName.GetData();
+        Parameter.id = MakeFakeParameterID(StoredName.GetData());
+        Info->Parameters.Add(Parameter);
+        Info->ParameterIDs.Add(Name, Parameter.id);
+    }
+    FakeDescriptions.Add(Info->Description);
+    FakeEventIDs.Add(Event->AssetGuid, Info->Description);
+    FakeEvents.Add(Event, MoveTemp(Info));
+}
+
+bool FFMODRecordingStudioCalls::GetFakeParameter(FMOD::Studio::EventInstance *Instance, const FName &Name, float &OutValue) const
+{
+    FFakeInstance *Fake = FindInstance(Instance);
+    const float *Value = Fake ? Fake->Parameters.Find(MakeFakeParameterID(TCHAR_TO_UTF8(*Name.ToString())).data1) : nullptr;
+    if (Value)
+    {
+        OutValue = *Value;
+        return true;
+    }
+    return false;
+}
+
+FMOD::Studio::Bus *FFMODRecordingStudioCalls::AddFakeBus(const FGuid &Guid)
+{
+    TUniquePtr<FFakeBus> Fake = MakeUnique<FFakeBus>();
+    FMOD::Studio::Bus *Bus = reinterpret_cast<FMOD::Studio::Bus *>(Fake.Get());
+    FakeBuses.Add(Bus, MoveTemp(Fake));
+    FakeBusIDs.Add(Guid, Bus);
+    return Bus;
+}
+
+void FFMODRecordingStudioCalls::RemoveFakeBus(const FGuid &Guid)
+{
+    FMOD::Studio::Bus *Bus = nullptr;
+    if (FakeBusIDs.RemoveAndCopyValue(Guid, Bus))
+    {
+        FindBus(Bus)->bLoaded = false;
+    }
+}
+
+bool FFMODRecordingStudioCalls::GetFakeBusVolume(const FGuid &Guid, float &OutVolume) const
+{
+    FMOD::Studio::Bus *const *Bus = FakeBusIDs.Find(Guid);
+    if (Bus)
+    {
+        OutVolume = FindBus(*Bus)->Volume;
+        return true;
+    }
+    return false;
+}
+
+FMOD::Studio::VCA *FFMODRecordingStudioCalls::AddFakeVCA(const FGuid &Guid)
+{
+    TUniquePtr<FFakeBus> Fake = MakeUnique<FFakeBus>();
+    FMOD::Studio::VCA *VCA = reinterpret_cast<FMOD::Studio::VCA *>(Fake.Get());
+    FakeVCAs.Add(VCA, MoveTemp(Fake));
+    FakeVCAIDs.Add(Guid, VCA);
+    return VCA;
+}
+
+void FFMODRecordingStudioCalls::RemoveFakeVCA(const FGuid &Guid)
+{
+    FMOD::Studio::VCA *VCA = nullptr;
+    if (FakeVCAIDs.RemoveAndCopyValue(Guid, VCA))
+    {
+        FindVCA(VCA)->bLoaded = false;
+    }
+}
+
+bool FFMODRecordingStudioCalls::GetFakeVCAVolume(const FGuid &Guid, float &OutVolume) const
+{
+    FMOD::Studio::VCA *const *VCA = FakeVCAIDs.Find(Guid);
+    if (VCA)
+    {
+        OutVolume = FindVCA(*VCA)->Volume;
+        return true;
+    }
+    return false;
+}
+
+void FFMODRecordingStudioCalls::AddFakeGlobalParameter(const FName &Name)
+{
+    FakeGlobalParameters.Add(MakeFakeParameterID(TCHAR_TO_UTF8(*Name.ToString())).data1, 0.0f);
+}
+
+void FFMODRecordingStudioCalls::RemoveFakeGlobalParameter(const FName &Name)
+{
+    FakeGlobalParameters.Remove(MakeFakeParameterID(TCHAR_TO_UTF8(*Name.ToString())).data1);
+}
+
+bool FFMODRecordingStudioCalls::GetFakeGlobalParameter(const FName &Name, float &OutValue) const
+{
+    const float *Value = FakeGlobalParameters.Find(MakeFakeParameterID(TCHAR_TO_UTF8(*Name.ToString())).data1);
+    if (Value)
+    {
+        OutValue = *Value;
+        return true;
+    }
+    return false;
+}
+
+void FFMODRecordingStudioCalls::AddFakeAudioTableEntry(const FString &Key, uint32 Size, bool bStreamed)
+{
+    FFakeAudioTableEntry &Entry = FakeAudioTable.Add(Key);
+    FTCHARToUTF8 Utf8Key(*Key);
+    Entry.Key.Append(Utf8Key.Get(), Utf8Key.Length() + 1);
+    Entry.Size = Size;
+    Entry.bStreamed = bStreamed;
+}
+
+void FFMODRecordingStudioCalls::SetFakePlaybackState(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PLAYBACK_STATE State)
+{
+    FFakeInstance *Fake = FindInstance(Instance);
+    if (Fake)
+    {
+        Fake->State = State;
+    }
+}
+
+int32 FFMODRecordingStudioCalls::GetTotalCount() const
+{
+    int32 Total = 0;
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        Total += Counts[i];
+    }
+    return Total;
+}
+
+double FFMODRecordingStudioCalls::GetTotalSeconds() const
+{
+    uint64 Total = 0;
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        Total += Cycles[i];
+    }
+    return FPlatformTime::ToSeconds64(Total);
+}
+
+void FFMODRecordingStudioCalls::ResetRecords()
+{
+    FMemory::Memzero(Counts);
+    FMemory::Memzero(Cycles);
+    NumParameterValues = 0;
+}
+
+void FFMODRecordingStudioCalls::Report(FAutomationTestBase &Test, const FString &Scenario, double Seconds, int32 Frames) const
+{
+    Test.AddInfo(FString::Printf(TEXT("%s: %.3f ms game thread per frame over %d frames, %d Studio calls taking %.3f ms"), *Scenario,
+        Seconds * 1000.0 / FMath::Max(Frames, 1), Frames, GetTotalCount(), GetTotalSeconds() * 1000.0));
+
+    for (int32 i = 0; i < NumCalls; ++i)
+    {
+        if (Counts[i] > 0)
+        {
+            Test.AddInfo(FString::Printf(TEXT("    %s: %d calls, %.3f ms"), CALL_NAMES[i], Counts[i], FPlatformTime::ToMilliseconds64(Cycles[i])));
+        }
+    }
+}
+
+FFMODRecordingStudioCalls::FFakeInstance *FFMODRecordingStudioCalls::FindInstance(FMOD::Studio::EventInstance *Instance) const
+{
+    const TUniquePtr<FFakeInstance> *Fake = FakeInstances.Find(Instance);
+    return Fake ? Fake->Get() : nullptr;
+}
+
+FFMODRecordingStudioCalls::FFakeBank *FFMODRecordingStudioCalls::FindBank(FMOD::Studio::Bank *Bank) const
+{
+    const TUniquePtr<FFakeBank> *Fake = FakeBanks.Find(Bank);
+    return Fake ? Fake->Get() : nullptr;
+}
+
+FFMODRecordingStudioCalls::FFakeBus *FFMODRecordingStudioCalls::FindBus(FMOD::Studio::Bus *Bus) const
+{
+    const TUniquePtr<FFakeBus> *Fake = FakeBuses.Find(Bus);
+    return Fake ? Fake->Get() : nullptr;
+}
+
+FFMODRecordingStudioCalls::FFakeBus *FFMODRecordingStudioCalls::FindVCA(FMOD::Studio::VCA *VCA) const
+{
+    const TUniquePtr<FFakeBus> *Fake = FakeVCAs.Find(VCA);
+    return Fake ? Fake->Get() : nullptr;
+}
+
+FFMODRecordingStudioCalls::FFakeSound *FFMODRecordingStudioCalls::FindSound(FMOD::Sound *Sound) const
+{
+    const TUniquePtr<FFakeSound> *Fake = FakeSounds.Find(Sound);
+    return Fake ? Fake->Get() : nullptr;
+}
+
+const FFMODEventDescriptionInfo *FFMODRecordingStudioCalls::GetEventDescriptionInfo(const UFMODEvent *Event, EFMODSystemContext::Type Context)
+{
+    FScopedRecord Record(*this, GetEventDescriptionInfoCall);
+    if (const TUniquePtr<FFMODEventDescriptionInfo> *Fake = FakeEvents.Find(Event))
+    {
+        return Fake->Get();
+    }
+    return FFMODStudioCalls::GetEventDescriptionInfo(Event, Context);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetEventByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::EventDescription **OutEventDesc)
+{
+    FScopedRecord Record(*this, GetEventByIDCall);
+    if (FMOD::Studio::EventDescription **Fake = FakeEventIDs.Find(FMODUtils::ConvertGuid(ID)))
+    {
+        *OutEventDesc = *Fake;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetEventByID(System, ID, OutEventDesc);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetParameterDescriptionByName(
+    FMOD::Studio::EventDescription *EventDesc, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter)
+{
+    FScopedRecord Record(*this, GetParameterDescriptionByNameCall);
+    if (FakeDescriptions.Contains(EventDesc))
+    {
+        // Each name gets its own ID, the rest of the description is left empty
+        FMemory::Memzero(*OutParameter);
+        OutParameter->name = Name;
+        OutParameter->id = MakeFakeParameterID(Name);
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetParameterDescriptionByName(EventDesc, Name, OutParameter);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::CreateInstance(FMOD::Studio::EventDescription *EventDesc, FMOD::Studio::EventInstance **OutInstance)
+{
+    FScopedRecord Record(*this, CreateInstanceCall);
+    if (FakeDescriptions.Contains(EventDesc))
+    {
+        // Like a real instance, it doesn't play until it is started
+        *OutInstance = CreateFakeInstance();
+        SetFakePlaybackState(*OutInstance, FMOD_STUDIO_PLAYBACK_STOPPED);
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::CreateInstance(EventDesc, OutInstance);
+}
+
+bool FFMODRecordingStudioCalls::IsValid(FMOD::Studio::EventInstance *Instance)
+{
+    FScopedRecord Record(*this, IsValidCall);
+    if (FakeInstances.Contains(Instance))
+    {
+        return true;
+    }
+    return FFMODStudioCalls::IsValid(Instance);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::Start(FMOD::Studio::EventInstance *Instance)
+{
+    FScopedRecord Record(*this, StartCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        Fake->State = FMOD_STUDIO_PLAYBACK_PLAYING;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::Start(Instance);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::Stop(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_STOP_MODE Mode)
+{
+    FScopedRecord Record(*this, StopCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        Fake->State = (Mode == FMOD_STUDIO_STOP_IMMEDIATE) ? FMOD_STUDIO_PLAYBACK_STOPPED : FMOD_STUDIO_PLAYBACK_STOPPING;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::Stop(Instance, Mode);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::Release(FMOD::Studio::EventInstance *Instance)
+{
+    FScopedRecord Record(*this, ReleaseCall);
+    if (FakeInstances.Remove(Instance) > 0)
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::Release(Instance);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetPlaybackState(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PLAYBACK_STATE *OutState)
+{
+    FScopedRecord Record(*this, GetPlaybackStateCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        *OutState = Fake->State;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetPlaybackState(Instance, OutState);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::Set3DAttributes(FMOD::Studio::EventInstance *Instance, const FMOD_3D_ATTRIBUTES &Attributes)
+{
+    FScopedRecord Record(*this, Set3DAttributesCall);
+    if (FindInstance(Instance))
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::Set3DAttributes(Instance, Attributes);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetParameterByID(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PARAMETER_ID ID, float Value)
+{
+    FScopedRecord Record(*this, SetParameterByIDCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        Fake->Parameters.Add(ID.data1, Value);
+        ++NumParameterValues;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetParameterByID(Instance, ID, Value);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetParametersByIDs(
+    FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID *IDs, float *Values, int Count)
+{
+    FScopedRecord Record(*this, SetParametersByIDsCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        for (int i = 0; i < Count; ++i)
+        {
+            Fake->Parameters.Add(IDs[i].data1, Values[i]);
+        }
+        NumParameterValues += Count;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetParametersByIDs(Instance, IDs, Values, Count);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetParameterByName(FMOD::Studio::EventInstance *Instance, const char *Name, float Value)
+{
+    FScopedRecord Record(*this, SetParameterByNameCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        Fake->Parameters.Add(MakeFakeParameterID(Name).data1, Value);
+        ++NumParameterValues;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetParameterByName(Instance, Name, Value);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetProperty(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_PROPERTY Property, float Value)
+{
+    FScopedRecord Record(*this, SetPropertyCall);
+    if (FindInstance(Instance))
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetProperty(Instance, Property, Value);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetCallback(
+    FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_CALLBACK Callback, FMOD_STUDIO_EVENT_CALLBACK_TYPE CallbackMask)
+{
+    FScopedRecord Record(*this, SetCallbackCall);
+    if (FindInstance(Instance))
+    {
+        // Fake instances never call back
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetCallback(Instance, Callback, CallbackMask);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetUserData(FMOD::Studio::EventInstance *Instance, void *UserData)
+{
+    FScopedRecord Record(*this, SetUserDataCall);
+    if (FindInstance(Instance))
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetUserData(Instance, UserData);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetTimelinePosition(FMOD::Studio::EventInstance *Instance, int Position)
+{
+    FScopedRecord Record(*this, SetTimelinePositionCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        Fake->TimelinePosition = Position;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetTimelinePosition(Instance, Position);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetTimelinePosition(FMOD::Studio::EventInstance *Instance, int *OutPosition)
+{
+    FScopedRecord Record(*this, GetTimelinePositionCall);
+    if (FFakeInstance *Fake = FindInstance(Instance))
+    {
+        *OutPosition = Fake->TimelinePosition;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetTimelinePosition(Instance, OutPosition);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetNumListeners(FMOD::Studio::System *System, int NumListeners)
+{
+    FScopedRecord Record(*this, SetNumListenersCall);
+    if (IsFakeSystem(System))
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetNumListeners(System, NumListeners);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetListenerAttributes(FMOD::Studio::System *System, int Listener, const FMOD_3D_ATTRIBUTES &Attributes)
+{
+    FScopedRecord Record(*this, SetListenerAttributesCall);
+    if (IsFakeSystem(System))
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetListenerAttributes(System, Listener, Attributes);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetBusByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::Bus **OutBus)
+{
+    FScopedRecord Record(*this, GetBusByIDCall);
+    if (IsFakeSystem(System))
+    {
+        FMOD::Studio::Bus **Fake = FakeBusIDs.Find(FMODUtils::ConvertGuid(ID));
+        *OutBus = Fake ? *Fake : nullptr;
+        return Fake ? FMOD_OK : FMOD_ERR_EVENT_NOTFOUND;
+    }
+    return FFMODStudioCalls::GetBusByID(System, ID, OutBus);
+}
+
+bool FFMODRecordingStudioCalls::IsValid(FMOD::Studio::Bus *Bus)
+{
+    FScopedRecord Record(*this, IsBusValidCall);
+    if (FFakeBus *Fake = FindBus(Bus))
+    {
+        return Fake->bLoaded;
+    }
+    return FFMODStudioCalls::IsValid(Bus);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetVolume(FMOD::Studio::Bus *Bus, float Volume)
+{
+    FScopedRecord Record(*this, SetBusVolumeCall);
+    if (FFakeBus *Fake = FindBus(Bus))
+    {
+        if (!Fake->bLoaded)
+        {
+            return FMOD_ERR_INVALID_HANDLE;
+        }
+        Fake->Volume = Volume;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetVolume(Bus, Volume);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetVCAByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::VCA **OutVCA)
+{
+    FScopedRecord Record(*this, GetVCAByIDCall);
+    if (IsFakeSystem(System))
+    {
+        FMOD::Studio::VCA **Fake = FakeVCAIDs.Find(FMODUtils::ConvertGuid(ID));
+        *OutVCA = Fake ? *Fake : nullptr;
+        return Fake ? FMOD_OK : FMOD_ERR_EVENT_NOTFOUND;
+    }
+    return FFMODStudioCalls::GetVCAByID(System, ID, OutVCA);
+}
+
+bool FFMODRecordingStudioCalls::IsValid(FMOD::Studio::VCA *VCA)
+{
+    FScopedRecord Record(*this, IsVCAValidCall);
+    if (FFakeBus *Fake = FindVCA(VCA))
+    {
+        return Fake->bLoaded;
+    }
+    return FFMODStudioCalls::IsValid(VCA);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetVolume(FMOD::Studio::VCA *VCA, float Volume)
+{
+    FScopedRecord Record(*this, SetVCAVolumeCall);
+    if (FFakeBus *Fake = FindVCA(VCA))
+    {
+        if (!Fake->bLoaded)
+        {
+            return FMOD_ERR_INVALID_HANDLE;
+        }
+        Fake->Volume = Volume;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetVolume(VCA, Volume);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetParameterDescriptionByName(
+    FMOD::Studio::System *System, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter)
+{
+    FScopedRecord Record(*this, GetGlobalParameterDescriptionCall);
+    if (IsFakeSystem(System))
+    {
+        const FMOD_STUDIO_PARAMETER_ID ID = MakeFakeParameterID(Name);
+        if (!FakeGlobalParameters.Contains(ID.data1))
+        {
+            return FMOD_ERR_EVENT_NOTFOUND;
+        }
+        FMemory::Memzero(*OutParameter);
+        OutParameter->name = Name;
+        OutParameter->id = ID;
+        OutParameter->flags = FMOD_STUDIO_PARAMETER_GLOBAL;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetParameterDescriptionByName(System, Name, OutParameter);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetParameterByID(FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float Value)
+{
+    FScopedRecord Record(*this, SetGlobalParameterByIDCall);
+    if (IsFakeSystem(System))
+    {
+        float *Fake = FakeGlobalParameters.Find(ID.data1);
+        if (Fake == nullptr)
+        {
+            return FMOD_ERR_INVALID_PARAM;
+        }
+        *Fake = Value;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetParameterByID(System, ID, Value);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::SetParameterByName(FMOD::Studio::System *System, const char *Name, float Value)
+{
+    FScopedRecord Record(*this, SetGlobalParameterByNameCall);
+    if (IsFakeSystem(System))
+    {
+        float *Fake = FakeGlobalParameters.Find(MakeFakeParameterID(Name).data1);
+        if (Fake == nullptr)
+        {
+            return FMOD_ERR_EVENT_NOTFOUND;
+        }
+        *Fake = Value;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::SetParameterByName(System, Name, Value);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetParameterByID(
+    FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float *OutValue, float *OutFinalValue)
+{
+    FScopedRecord Record(*this, GetGlobalParameterByIDCall);
+    if (IsFakeSystem(System))
+    {
+        const float *Fake = FakeGlobalParameters.Find(ID.data1);
+        if (Fake == nullptr)
+        {
+            return FMOD_ERR_INVALID_PARAM;
+        }
+        *OutValue = *OutFinalValue = *Fake;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetParameterByID(System, ID, OutValue, OutFinalValue);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetParameterByName(
+    FMOD::Studio::System *System, const char *Name, float *OutValue, float *OutFinalValue)
+{
+    FScopedRecord Record(*this, GetGlobalParameterByNameCall);
+    if (IsFakeSystem(System))
+    {
+        const float *Fake = FakeGlobalParameters.Find(MakeFakeParameterID(Name).data1);
+        if (Fake == nullptr)
+        {
+            return FMOD_ERR_EVENT_NOTFOUND;
+        }
+        *OutValue = *OutFinalValue = *Fake;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetParameterByName(System, Name, OutValue, OutFinalValue);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetSoundInfo(FMOD::Studio::System *System, const char *Key, FMOD_STUDIO_SOUND_INFO *OutInfo)
+{
+    FScopedRecord Record(*this, GetSoundInfoCall);
+    if (IsFakeSystem(System))
+    {
+        const FFakeAudioTableEntry *Entry = FakeAudioTable.Find(UTF8_TO_TCHAR(Key));
+        if (!Entry)
+        {
+            return FMOD_ERR_EVENT_NOTFOUND;
+        }
+        FMemory::Memzero(*OutInfo);
+        OutInfo->name_or_data = Entry->Key.GetData();
+        OutInfo->mode = Entry->bStreamed ? FMOD_CREATESTREAM : 0;
+        OutInfo->exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetSoundInfo(System, Key, OutInfo);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::CreateSound(
+    FMOD::Studio::System *System, const char *NameOrData, FMOD_MODE Mode, FMOD_CREATESOUNDEXINFO *ExInfo, FMOD::Sound **OutSound)
+{
+    FScopedRecord Record(*this, CreateSoundCall);
+    if (IsFakeSystem(System))
+    {
+        FPlatformProcess::Sleep(FakeSoundCreateDelay);
+        const FFakeAudioTableEntry *Entry = FakeAudioTable.Find(UTF8_TO_TCHAR(NameOrData));
+        if (!Entry)
+        {
+            return FMOD_ERR_FILE_NOTFOUND;
+        }
+        TUniquePtr<FFakeSound> Fake = MakeUnique<FFakeSound>();
+        Fake->Size = Entry->Size;
+        if (!(Mode & FMOD_NONBLOCKING))
+        {
+            Fake->State = FMOD_OPENSTATE_READY;
+        }
+        *OutSound = reinterpret_cast<FMOD::Sound *>(Fake.Get());
+        FakeSounds.Add(*OutSound, MoveTemp(Fake));
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::CreateSound(System, NameOrData, Mode, ExInfo, OutSound);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetOpenState(FMOD::Sound *Sound, FMOD_OPENSTATE *OutState)
+{
+    FScopedRecord Record(*this, GetOpenStateCall);
+    if (FFakeSound *Fake = FindSound(Sound))
+    {
+        // Reported as still opening once, like a non-blocking sound waiting on the disk
+        *OutState = Fake->State;
+        Fake->State = FMOD_OPENSTATE_READY;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetOpenState(Sound, OutState);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetLength(FMOD::Sound *Sound, unsigned int *OutLength, FMOD_TIMEUNIT Unit)
+{
+    FScopedRecord Record(*this, GetLengthCall);
+    if (FFakeSound *Fake = FindSound(Sound))
+    {
+        *OutLength = Fake->Size;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetLength(Sound, OutLength, Unit);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::Release(FMOD::Sound *Sound)
+{
+    FScopedRecord Record(*this, ReleaseSoundCall);
+    if (FakeSounds.Remove(Sound) > 0)
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::Release(Sound);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::LoadBankFile(
+    FMOD::Studio::System *System, const char *Filename, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **OutBank)
+{
+    FScopedRecord Record(*this, LoadBankFileCall);
+    if (IsFakeSystem(System))
+    {
+        TUniquePtr<FFakeBank> Fake = MakeUnique<FFakeBank>();
+        if (!(Flags & FMOD_STUDIO_LOAD_BANK_NONBLOCKING))
+        {
+            Fake->State = FMOD_STUDIO_LOADING_STATE_LOADED;
+        }
+        *OutBank = reinterpret_cast<FMOD::Studio::Bank *>(Fake.Get());
+        FakeBanks.Add(*OutBank, MoveTemp(Fake));
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::LoadBankFile(System, Filename, Flags, OutBank);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::FlushCommands(FMOD::Studio::System *System)
+{
+    FScopedRecord Record(*this, FlushCommandsCall);
+    if (IsFakeSystem(System))
+    {
+        for (TPair<const void *, TUniquePtr<FFakeBank>> &Bank : FakeBanks)
+        {
+            Bank.Value->State = FMOD_STUDIO_LOADING_STATE_LOADED;
+        }
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::FlushCommands(System);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::GetLoadingState(FMOD::Studio::Bank *Bank, FMOD_STUDIO_LOADING_STATE *OutState)
+{
+    FScopedRecord Record(*this, GetLoadingStateCall);
+    if (FFakeBank *Fake = FindBank(Bank))
+    {
+        // Reported as still loading once, so loads span a frame like they do in FMOD
+        *OutState = Fake->State;
+        Fake->State = FMOD_STUDIO_LOADING_STATE_LOADED;
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::GetLoadingState(Bank, OutState);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::LoadSampleData(FMOD::Studio::Bank *Bank)
+{
+    FScopedRecord Record(*this, LoadSampleDataCall);
+    if (FindBank(Bank))
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::LoadSampleData(Bank);
+}
+
+FMOD_RESULT FFMODRecordingStudioCalls::Unload(FMOD::Studio::Bank *Bank)
+{
+    FScopedRecord Record(*this, UnloadCall);
+    if (FakeBanks.Remove(Bank) > 0)
+    {
+        return FMOD_OK;
+    }
+    return FFMODStudioCalls::Unload(Bank);
+}
+
+#endif
@@ -0,0 +1,316 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FMODStudioCalls.h"
+#include "FMODEvent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class FAutomationTestBase;
+
+/**
+ * Studio calls for tests, counting every call and the time spent in it. Events added by AddFakeEvent, instances made by
+ * CreateFakeInstance or from a fake event, buses, VCAs and global parameters added to the fake system, sounds for audio table
+ * entries added by AddFakeAudioTableEntry and banks loaded into the fake system are simulated without FMOD, so the hot paths can run
+ * without a Studio system. Calls on any other handle are passed on to FMOD. Only for use on the game thread.
+ */
+class FFMODRecordingStudioCalls : public FFMODStudioCalls
+{
+public:
+    enum ECall
+    {
+        GetEventDescriptionInfoCall,
+        GetEventByIDCall,
+        GetParameterDescriptionByNameCall,
+        CreateInstanceCall,
+        IsValidCall,
+        StartCall,
+        StopCall,
+        ReleaseCall,
+        GetPlaybackStateCall,
+        Set3DAttributesCall,
+        SetParameterByIDCall,
+        SetParametersByIDsCall,
+        SetParameterByNameCall,
+        SetPropertyCall,
+        SetCallbackCall,
+        SetUserDataCall,
+        SetTimelinePositionCall,
+        GetTimelinePositionCall,
+        SetNumListenersCall,
+        SetListenerAttributesCall,
+        GetBusByIDCall,
+        IsBusValidCall,
+        SetBusVolumeCall,
+        GetVCAByIDCall,
+        IsVCAValidCall,
+        SetVCAVolumeCall,
+        GetGlobalParameterDescriptionCall,
+        SetGlobalParameterByIDCall,
+        SetGlobalParameterByNameCall,
+        GetGlobalParameterByIDCall,
+        GetGlobalParameterByNameCall,
+        GetSoundInfoCall,
+        CreateSoundCall,
+        GetOpenStateCall,
+        GetLengthCall,
+        ReleaseSoundCall,
+        LoadBankFileCall,
+        FlushCommandsCall,
+        GetLoadingStateCall,
+        LoadSampleDataCall,
+        UnloadCall,
+        NumCalls
+    };
+
+    FFMODRecordingStudioCalls();
+
+    /** Make a playing instance that only exists in this object */
+    FMOD::Studio::EventInstance *CreateFakeInstance();
+
+    /**
+     * Give an event a description that only exists in this object, also found by its GUID, with fake instances. The description
+     * lists the given parameters, but a parameter of any name can be looked up.
+     */
+    void AddFakeEvent(const UFMODEvent *Event, bool bIs3D, bool bOneshot, float MaximumDistance, int Length,
+        const TArray<FName> &ParameterNames = TArray<FName>());
+
+    /** Give the fake system a bus with this GUID, returning its fake handle */
+    FMOD::Studio::Bus *AddFakeBus(const FGuid &Guid);
+
+    /** Unload a fake bus, as unloading its bank would, so its handle is no longer valid and its GUID isn't found */
+    void RemoveFakeBus(const FGuid &Guid);
+
+    /** Volume a fake bus was last set to */
+    bool GetFakeBusVolume(const FGuid &Guid, float &OutVolume) const;
+
+    /** Give the fake system a VCA with this GUID, returning its fake handle */
+    FMOD::Studio::VCA *AddFakeVCA(const FGuid &Guid);
+
+    /** Unload a fake VCA, so its handle is no longer valid and its GUID isn't found */
+    void RemoveFakeVCA(const FGuid &Guid);
+
+    /** Volume a fake VCA was last set to */
+    bool GetFakeVCAVolume(const FGuid &Guid, float &OutVolume) const;
+
+    /** Give the fake system a global parameter, which can be set and read by name or ID */
+    void AddFakeGlobalParameter(const FName &Name);
+
+    /** Unload a fake global parameter, so neither its name nor its ID is found */
+    void RemoveFakeGlobalParameter(const FName &Name);
+
+    /** Last value a fake global parameter was set to */
+    bool GetFakeGlobalParameter(const FName &Name, float &OutValue) const;
+
+    /** Give the fake system an audio table entry, whose sounds open on the first open state check after they are created */
+    void AddFakeAudioTableEntry(const FString &Key, uint32 Size, bool bStreamed = false);
+
+    /** Time each fake sound creation blocks for, standing in for slow I/O */
+    void SetFakeSoundCreateDelay(float Seconds) { FakeSoundCreateDelay = Seconds; }
+
+    /** Number of fake sounds that haven't been released */
+    int32 NumFakeSounds() const { return FakeSounds.Num(); }
+
+    /** Change the playback state of a fake instance, e.g. to have the emitter manager see it finish */
+    void SetFakePlaybackState(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PLAYBACK_STATE State);
+
+    /** System handle whose bank loads are simulated, they finish on the first loading state check after the load */
+    FMOD::Studio::System *GetFakeSystem() { return reinterpret_cast<FMOD::Studio::System *>(&FakeSystem); }
+
+    /** Last value a parameter of a fake instance was set to, by name or by ID */
+    bool GetFakeParameter(FMOD::Studio::EventInstance *Instance, const FName &Name, float &OutValue) const;
+
+    /** Number of parameter values set on fake instances, counting each value of a batch */
+    int32 GetNumParameterValues() const { return NumParameterValues; }
+
+    /** Number of fake instances that haven't been released */
+    int32 NumFakeInstances() const { return FakeInstances.Num(); }
+
+    /** Number of fake banks that haven't been unloaded */
+    int32 NumFakeBanks() const { return FakeBanks.Num(); }
+
+    int32 GetCount(ECall Call) const { return Counts[Call]; }
+    int32 GetTotalCount() const;
+    double GetTotalSeconds() const;
+
+    /** Clear the recorded calls, e.g. between the phases of a scenario */
+    void ResetRecords();
+
+    /** Log the game thread cost of a scenario and the calls it made */
+    void Report(FAutomationTestBase &Test, const FString &Scenario, double Seconds, int32 Frames) const;
+
+    virtual const FFMODEventDescriptionInfo *GetEventDescriptionInfo(const UFMODEvent *Event, EFMODSystemContext::Type Context) override;
+    virtual FMOD_RESULT GetEventByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::EventDescription **OutEventDesc) override;
+    virtual FMOD_RESULT GetParameterDescriptionByName(
+        FMOD::Studio::EventDescription *EventDesc, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter) override;
+    virtual FMOD_RESULT CreateInstance(FMOD::Studio::EventDescription *EventDesc, FMOD::Studio::EventInstance **OutInstance) override;
+    virtual bool IsValid(FMOD::Studio::EventInstance *Instance) override;
+    virtual FMOD_RESULT Start(FMOD::Studio::EventInstance *Instance) override;
+    virtual FMOD_RESULT Stop(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_STOP_MODE Mode) override;
+    virtual FMOD_RESULT Release(FMOD::Studio::EventInstance *Instance) override;
+    virtual FMOD_RESULT GetPlaybackState(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PLAYBACK_STATE *OutState) override;
+    virtual FMOD_RESULT Set3DAttributes(FMOD::Studio::EventInstance *Instance, const FMOD_3D_ATTRIBUTES &Attributes) override;
+    virtual FMOD_RESULT SetParameterByID(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_PARAMETER_ID ID, float Value) override;
+    virtual FMOD_RESULT SetParametersByIDs(
+        FMOD::Studio::EventInstance *Instance, const FMOD_STUDIO_PARAMETER_ID *IDs, float *Values, int Count) override;
+    virtual FMOD_RESULT SetParameterByName(FMOD::Studio::EventInstance *Instance, const char *Name, float Value) override;
+    virtual FMOD_RESULT SetProperty(FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_PROPERTY Property, float Value) override;
+    virtual FMOD_RESULT SetCallback(
+        FMOD::Studio::EventInstance *Instance, FMOD_STUDIO_EVENT_CALLBACK Callback, FMOD_STUDIO_EVENT_CALLBACK_TYPE CallbackMask) override;
+    virtual FMOD_RESULT SetUserData(FMOD::Studio::EventInstance *Instance, void *UserData) override;
+    virtual FMOD_RESULT SetTimelinePosition(FMOD::Studio::EventInstance *Instance, int Position) override;
+    virtual FMOD_RESULT GetTimelinePosition(FMOD::Studio::EventInstance *Instance, int *OutPosition) override;
+    virtual FMOD_RESULT SetNumListeners(FMOD::Studio::System *System, int NumListeners) override;
+    virtual FMOD_RESULT SetListenerAttributes(FMOD::Studio::System *System, int Listener, const FMOD_3D_ATTRIBUTES &Attributes) override;
+    virtual FMOD_RESULT GetBusByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::Bus **OutBus) override;
+    virtual bool IsValid(FMOD::Studio::Bus *Bus) override;
+    virtual FMOD_RESULT SetVolume(FMOD::Studio::Bus *Bus, float Volume) override;
+    virtual FMOD_RESULT GetVCAByID(FMOD::Studio::System *System, const FMOD_GUID &ID, FMOD::Studio::VCA **OutVCA) override;
+    virtual bool IsValid(FMOD::Studio::VCA *VCA) override;
+    virtual FMOD_RESULT SetVolume(FMOD::Studio::VCA *VCA, float Volume) override;
+    virtual FMOD_RESULT GetParameterDescriptionByName(
+        FMOD::Studio::System *System, const char *Name, FMOD_STUDIO_PARAMETER_DESCRIPTION *OutParameter) override;
+    virtual FMOD_RESULT SetParameterByID(FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float Value) override;
+    virtual FMOD_RESULT SetParameterByName(FMOD::Studio::System *System, const char *Name, float Value) override;
+    virtual FMOD_RESULT GetParameterByID(
+        FMOD::Studio::System *System, FMOD_STUDIO_PARAMETER_ID ID, float *OutValue, float *OutFinalValue) override;
+    virtual FMOD_RESULT GetParameterByName(FMOD::Studio::System *System, const char *Name, float *OutValue, float *OutFinalValue) override;
+    virtual FMOD_RESULT GetSoundInfo(FMOD::Studio::System *System, const char *Key, FMOD_STUDIO_SOUND_INFO *OutInfo) override;
+    virtual FMOD_RESULT CreateSound(FMOD::Studio::System *System, const char *NameOrData, FMOD_MODE Mode, FMOD_CREATESOUNDEXINFO *ExInfo,
+        FMOD::Sound **OutSound) override;
+    virtual FMOD_RESULT GetOpenState(FMOD::Sound *Sound, FMOD_OPENSTATE *OutState) override;
+    virtual FMOD_RESULT GetLength(FMOD::Sound *Sound, unsigned int *OutLength, FMOD_TIMEUNIT Unit) override;
+    virtual FMOD_RESULT Release(FMOD::Sound *Sound) override;
+    virtual FMOD_RESULT LoadBankFile(
+        FMOD::Studio::System *System, const char *Filename, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **OutBank) override;
+    virtual FMOD_RESULT FlushCommands(FMOD::Studio::System *System) override;
+    virtual FMOD_RESULT GetLoadingState(FMOD::Studio::Bank *Bank, FMOD_STUDIO_LOADING_STATE *OutState) override;
+    virtual FMOD_RESULT LoadSampleData(FMOD::Studio::Bank *Bank) override;
+    virtual FMOD_RESULT Unload(FMOD::Studio::Bank *Bank) override;
+
+private:
+    /** Adds the time between construction and destruction to a call's record */
+    struct FScopedRecord
+    {
+        FScopedRecord(FFMODRecordingStudioCalls &InOwner, ECall InCall)
+            : Owner(InOwner)
+            , Call(InCall)
+            , StartCycles(FPlatformTime::Cycles64())
+        {
+        }
+
+        ~FScopedRecord()
+        {
+            ++Owner.Counts[Call];
+            Owner.Cycles[Call] += FPlatformTime::Cycles64() - StartCycles;
+        }
+
+        FFMODRecordingStudioCalls &Owner;
+        ECall Call;
+        uint64 StartCycles;
+    };
+
+    struct FFakeInstance
+    {
+        FFakeInstance()
+            : State(FMOD_STUDIO_PLAYBACK_STOPPED)
+            , TimelinePosition(0)
+        {
+        }
+
+        FMOD_STUDIO_PLAYBACK_STATE State;
+        int TimelinePosition;
+
+        /** Keyed by the first word of the parameter ID */
+        TMap<uint32, float> Parameters;
+    };
+
+    struct FFakeBank
+    {
+        FFakeBank()
+            : State(FMOD_STUDIO_LOADING_STATE_LOADING)
+        {
+        }
+
+        FMOD_STUDIO_LOADING_STATE State;
+    };
+
+    struct FFakeBus
+    {
+        FFakeBus()
+            : Volume(1.0f)
+            , bLoaded(true)
+        {
+        }
+
+        float Volume;
+        bool bLoaded;
+    };
+
+    struct FFakeAudioTableEntry
+    {
+        FFakeAudioTableEntry()
+            : Size(0)
+            , bStreamed(false)
+        {
+        }
+
+        /** The sound info points at the key, as it would point at the bank's data */
+        TArray<ANSICHAR> Key;
+        uint32 Size;
+        bool bStreamed;
+    };
+
+    struct FFakeSound
+    {
+        FFakeSound()
+            : State(FMOD_OPENSTATE_LOADING)
+            , Size(0)
+        {
+        }
+
+        FMOD_OPENSTATE State;
+        uint32 Size;
+    };
+
+    FFakeInstance *FindInstance(FMOD::Studio::EventInstance *Instance) const;
+    FFakeBank *FindBank(FMOD::Studio::Bank *Bank) const;
+    FFakeBus *FindBus(FMOD::Studio::Bus *Bus) const;
+    FFakeBus *FindVCA(FMOD::Studio::VCA *VCA) const;
+    FFakeSound *FindSound(FMOD::Sound *Sound) const;
+    bool IsFakeSystem(FMOD::Studio::System *System) const { return System == reinterpret_cast<const FMOD::Studio::System *>(&FakeSystem); }
+
+    int32 Counts[NumCalls];
+    uint64 Cycles[NumCalls];
+    int32 NumParameterValues;
+
+    /** Fake handles are the addresses of their state, which is never dereferenced as an FMOD object */
+    TMap<const UFMODEvent *, TUniquePtr<FFMODEventDescriptionInfo>> FakeEvents;
+    TSet<const void *> FakeDescriptions;
+    TMap<FGuid, FMOD::Studio::EventDescription *> FakeEventIDs;
+    TArray<TArray<ANSICHAR>> FakeParameterNames;
+    TMap<const void *, TUniquePtr<FFakeInstance>> FakeInstances;
+    TMap<const void *, TUniquePtr<FFakeBank>> FakeBanks;
+
+    /** Unloaded buses are kept, so their stale handles are still recognised */
+    TMap<const void *, TUniquePtr<FFakeBus>> FakeBuses;
+    TMap<FGuid, FMOD::Studio::Bus *> FakeBusIDs;
+
+    /** VCAs have the same state as buses */
+    TMap<const void *, TUniquePtr<FFakeBus>> FakeVCAs;
+    TMap<FGuid, FMOD::Studio::VCA *> FakeVCAIDs;
+
+    /** Values of the loaded global parameters, by the first word of their ID */
+    TMap<uint32, float> FakeGlobalParameters;
+
+    TMap<FString, FFakeAudioTableEntry> FakeAudioTable;
+    TMap<const void *, TUniquePtr<FFakeSound>> FakeSounds;
+    float FakeSoundCreateDelay;
+
+    /** Only its address is used, as the fake system handle */
+    uint8 FakeSystem;
+};
+
+#endif
@@ -0,0 +1,112 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODSnapshot.h"
+#include "FMODSnapshotReverb.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Give an audio volume a snapshot reverb, backed by a fake snapshot event */
+static void SetFakeSnapshotReverb(FFMODRecordingStudioCalls &Calls, AAudioVolume *Volume, float Intensity, float FadeTime)
+{
+    UFMODSnapshotReverb *Reverb = NewObject<UFMODSnapshotReverb>();
+    Reverb->AssetGuid = FGuid::NewGuid();
+    UFMODSnapshot *Snapshot = NewObject<UFMODSnapshot>();
+    Snapshot->AssetGuid = Reverb->AssetGuid;
+    Calls.AddFakeEvent(Snapshot, false, false, 0.0f, 0);
+
+    FReverbSettings Settings;
+    Settings.bApplyReverb = true;
+    Settings.ReverbEffect = Reverb;
+    Settings.Volume = Intensity;
+    Settings.FadeTime = FadeTime;
+    Volume->SetReverbSettings(Settings);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODReverbSnapshotTest, "FMOD.ReverbSnapshots",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODReverbSnapshotTest::RunTest(const FString &Parameters)
+{
+    const float FadeTime = 0.5f;
+    const double FrameSeconds = 1.0 / 60.0;
+    const int32 FadeFrames = FMath::CeilToInt(FadeTime / FrameSeconds) + 10;
+    const int32 SteadyFrames = 300;
+    const FVector VolumeExtent(1000.0f);
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    if (!Module.UseSound() || !Module.GetStudioSystem(EFMODSystemContext::Runtime))
+    {
+        AddWarning(TEXT("Skipped because there is no runtime Studio system"));
+        return true;
+    }
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+
+    // Two volumes well away from the listener, each applying a snapshot of its own
+    const FTransform SavedTransform = Module.GetNearestListener(FVector::ZeroVector).Transform;
+    const FVector CenterA = SavedTransform.GetTranslation() + FVector(10000.0f, 0.0f, 0.0f);
+    const FVector CenterB = SavedTransform.GetTranslation() + FVector(20000.0f, 0.0f, 0.0f);
+    SetFakeSnapshotReverb(Calls, TestWorld.SpawnAudioVolume(CenterA, VolumeExtent), 0.5f, FadeTime);
+    SetFakeSnapshotReverb(Calls, TestWorld.SpawnAudioVolume(CenterB, VolumeExtent), 0.8f, FadeTime);
+
+    const double SavedTime = FApp::GetCurrentTime();
+    double Now = SavedTime;
+    auto RunFrames = [&](const FVector &Location, int32 NumFrames) {
+        FTransform ListenerTransform = SavedTransform;
+        ListenerTransform.SetTranslation(Location);
+        return FMODTimeFrames(NumFrames, [&](int32) {
+            Now += FrameSeconds;
+            FApp::SetCurrentTime(Now);
+            Module.SetListenerPosition(0, TestWorld.World, ListenerTransform, FrameSeconds);
+            Module.FinishSetListenerPosition(1);
+        });
+    };
+
+    // Entering a volume creates its snapshot once and fades it up through the cached parameter ID
+    RunFrames(CenterA, FadeFrames);
+    TestEqual(TEXT("Snapshot lookups on entering a volume"), Calls.GetCount(FFMODRecordingStudioCalls::GetEventByIDCall), 1);
+    TestEqual(TEXT("Snapshot instances created on entering a volume"), Calls.GetCount(FFMODRecordingStudioCalls::CreateInstanceCall), 1);
+    TestEqual(TEXT("Intensity lookups on entering a volume"),
+        Calls.GetCount(FFMODRecordingStudioCalls::GetParameterDescriptionByNameCall), 1);
+    TestEqual(TEXT("Snapshot instances started on entering a volume"), Calls.GetCount(FFMODRecordingStudioCalls::StartCall), 1);
+    TestTrue(TEXT("Intensity set while fading up"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByIDCall) > 1);
+    TestEqual(TEXT("Parameters set by name"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall), 0);
+
+    // Once faded up, standing still in the volume costs nothing
+    Calls.ResetRecords();
+    double Seconds = RunFrames(CenterA, SteadyFrames);
+    Calls.Report(*this, TEXT("Standing in a reverb volume"), Seconds, SteadyFrames);
+    TestEqual(TEXT("Studio calls while standing in a volume"), Calls.GetTotalCount(), 0);
+
+    // Crossing into the other volume fades one snapshot down and the other up, setting each intensity at most once a frame
+    Calls.ResetRecords();
+    Seconds = RunFrames(CenterB, FadeFrames * 2);
+    Calls.Report(*this, TEXT("Crossfading between reverb volumes"), Seconds, FadeFrames * 2);
+    TestEqual(TEXT("Snapshot instances created by the crossfade"), Calls.GetCount(FFMODRecordingStudioCalls::CreateInstanceCall), 1);
+    TestEqual(TEXT("Snapshot instances stopped by the crossfade"), Calls.GetCount(FFMODRecordingStudioCalls::StopCall), 1);
+    TestEqual(TEXT("Snapshot instances released by the crossfade"), Calls.GetCount(FFMODRecordingStudioCalls::ReleaseCall), 1);
+    const int32 IntensityCalls = Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByIDCall);
+    TestTrue(FString::Printf(TEXT("Intensity set %d times during the crossfade"), IntensityCalls),
+        IntensityCalls > 2 && IntensityCalls <= 2 * FadeFrames);
+    TestEqual(TEXT("Parameters set by name during the crossfade"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall), 0);
+
+    Calls.ResetRecords();
+    RunFrames(CenterB, SteadyFrames);
+    TestEqual(TEXT("Studio calls after the crossfade"), Calls.GetTotalCount(), 0);
+
+    // Leaving every volume fades the last snapshot out and releases it
+    RunFrames(SavedTransform.GetTranslation(), FadeFrames * 2);
+    TestEqual(TEXT("Snapshot instances left after leaving the volumes"), Calls.NumFakeInstances(), 0);
+
+    FApp::SetCurrentTime(SavedTime);
+    return true;
+}
+
+#endif
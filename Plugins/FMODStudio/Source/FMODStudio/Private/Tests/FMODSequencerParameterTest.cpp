@@ -0,0 +1,123 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODEvent.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const int32 SEQUENCER_TEST_CURVES = 8;
+
+/** The last two curves of each emitter are flat, like the curves a cinematic keys once and leaves */
+static const int32 SEQUENCER_TEST_FLAT_CURVES = 2;
+
+static float EvaluateTestCurve(int32 Curve, int32 Emitter, int32 Frame)
+{
+    if (Curve >= SEQUENCER_TEST_CURVES - SEQUENCER_TEST_FLAT_CURVES)
+    {
+        return (float)Curve;
+    }
+    return FMath::Sin(Frame * 0.05f + Curve + Emitter * 0.1f);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODSequencerParameterTest, "FMOD.SequencerParameters",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODSequencerParameterTest::RunTest(const FString &Parameters)
+{
+    const int32 NumEmitters = 50;
+    const int32 NumFrames = 600;
+    const int32 NumAnimatedCurves = SEQUENCER_TEST_CURVES - SEQUENCER_TEST_FLAT_CURVES;
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+
+    TArray<FName> Names;
+    for (int32 i = 0; i < SEQUENCER_TEST_CURVES; ++i)
+    {
+        Names.Add(FName(*FString::Printf(TEXT("Curve %d"), i)));
+    }
+    UFMODEvent *Event = NewObject<UFMODEvent>();
+    Event->AssetGuid = FGuid::NewGuid();
+    Calls.AddFakeEvent(Event, false, false, 0.0f, 0, Names);
+
+    // Each emitter is bound to a track of its own, as in a cinematic with a crowd of animated sounds
+    TArray<UFMODAudioComponent *> Components;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        UFMODAudioComponent *Component = TestWorld.SpawnEmitter(Calls, FVector(i * 100.0f, 0.0f, 0.0f), 0.0f);
+        Component->Event = Event;
+        Components.Add(Component);
+    }
+
+    // What an execution token does for its bound component: every curve of the section in one batch
+    TArray<float> Values;
+    Values.SetNum(SEQUENCER_TEST_CURVES);
+    auto EvaluateBatched = [&](int32 Frame) {
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            for (int32 Curve = 0; Curve < SEQUENCER_TEST_CURVES; ++Curve)
+            {
+                Values[Curve] = EvaluateTestCurve(Curve, i, Frame);
+            }
+            Components[i]->SetParameters(Names, Values);
+        }
+    };
+
+    Calls.ResetRecords();
+    const double BatchedSeconds = FMODTimeFrames(NumFrames, EvaluateBatched);
+    Calls.Report(*this, FString::Printf(TEXT("%d emitters with %d curves, batched"), NumEmitters, SEQUENCER_TEST_CURVES), BatchedSeconds, NumFrames);
+    TestEqual(TEXT("Batches applied"), Calls.GetCount(FFMODRecordingStudioCalls::SetParametersByIDsCall), NumEmitters * NumFrames);
+    TestEqual(TEXT("Parameters set one at a time"),
+        Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByIDCall) + Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByNameCall), 0);
+    TestEqual(TEXT("Values applied, flat curves only once"), Calls.GetNumParameterValues(),
+        NumEmitters * (SEQUENCER_TEST_CURVES + NumAnimatedCurves * (NumFrames - 1)));
+
+    int32 WrongValues = 0;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        for (int32 Curve = 0; Curve < SEQUENCER_TEST_CURVES; ++Curve)
+        {
+            float Value = 0.0f;
+            WrongValues += (!Calls.GetFakeParameter(Components[i]->StudioInstance, Names[Curve], Value) ||
+                            Value != EvaluateTestCurve(Curve, i, NumFrames - 1));
+        }
+    }
+    TestEqual(TEXT("Parameters not at their last evaluated value"), WrongValues, 0);
+
+    // Evaluating the same frame again, e.g. while paused, doesn't reach FMOD at all
+    Calls.ResetRecords();
+    EvaluateBatched(NumFrames - 1);
+    TestEqual(TEXT("Studio calls for an unchanged frame"), Calls.GetTotalCount(), 0);
+
+    // The previous evaluation set every curve of every emitter separately
+    Calls.ResetRecords();
+    const double SeparateSeconds = FMODTimeFrames(NumFrames, [&](int32 Frame) {
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            for (int32 Curve = 0; Curve < SEQUENCER_TEST_CURVES; ++Curve)
+            {
+                Components[i]->SetParameter(Names[Curve], EvaluateTestCurve(Curve, i, NumFrames + Frame));
+            }
+        }
+    });
+    Calls.Report(*this, FString::Printf(TEXT("%d emitters with %d curves, one call per curve"), NumEmitters, SEQUENCER_TEST_CURVES),
+        SeparateSeconds, NumFrames);
+    TestEqual(TEXT("Calls setting one curve at a time"), Calls.GetCount(FFMODRecordingStudioCalls::SetParameterByIDCall),
+        NumEmitters * SEQUENCER_TEST_CURVES * NumFrames);
+    AddInfo(FString::Printf(TEXT("%.3f ms per frame batched, %.3f ms per frame one call per curve"), BatchedSeconds * 1000.0 / NumFrames,
+        SeparateSeconds * 1000.0 / NumFrames));
+
+    for (UFMODAudioComponent *Component : Components)
+    {
+        Component->Release();
+        Component->SetActiveFlag(false);
+    }
+    TestEqual(TEXT("Fake instances left"), Calls.NumFakeInstances(), 0);
+    return true;
+}
+
+#endif
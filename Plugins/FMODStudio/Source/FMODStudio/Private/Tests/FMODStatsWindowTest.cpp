@@ -0,0 +1,65 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODStatsCollector.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Samples are told apart by their time, which counts up from 1 */
+static void AddStatsTestSamples(FFMODStatsWindow &Window, int32 First, int32 Count)
+{
+    for (int32 i = First; i < First + Count; ++i)
+    {
+        FFMODStatsSample Sample = {};
+        Sample.Time = (double)i;
+        Window.Add(Sample);
+    }
+}
+
+static TArray<int32> GetStatsTestSamples(const FFMODStatsWindow &Window)
+{
+    TArray<int32> Times;
+    Window.ForEach([&Times](const FFMODStatsSample &Sample) { Times.Add((int32)Sample.Time); });
+    return Times;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODStatsWindowTest, "FMOD.StatsWindow",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODStatsWindowTest::RunTest(const FString &Parameters)
+{
+    // Wrap the ring so the oldest sample isn't at the start of the array
+    FFMODStatsWindow Window;
+    Window.SetCapacity(4);
+    AddStatsTestSamples(Window, 1, 6);
+    TestTrue(TEXT("Samples after wrapping"), GetStatsTestSamples(Window) == TArray<int32>({ 3, 4, 5, 6 }));
+
+    // Growing keeps every sample, and new ones go after the newest
+    Window.SetCapacity(6);
+    TestTrue(TEXT("Samples after growing"), GetStatsTestSamples(Window) == TArray<int32>({ 3, 4, 5, 6 }));
+    AddStatsTestSamples(Window, 7, 3);
+    TestTrue(TEXT("Samples added after growing"), GetStatsTestSamples(Window) == TArray<int32>({ 4, 5, 6, 7, 8, 9 }));
+    TestEqual(TEXT("Latest sample after growing"), (int32)Window.GetLatest().Time, 9);
+
+    // Shrinking keeps the newest samples instead of starting over
+    Window.SetCapacity(3);
+    TestTrue(TEXT("Samples after shrinking"), GetStatsTestSamples(Window) == TArray<int32>({ 7, 8, 9 }));
+    AddStatsTestSamples(Window, 10, 1);
+    TestTrue(TEXT("Samples added after shrinking"), GetStatsTestSamples(Window) == TArray<int32>({ 8, 9, 10 }));
+    TestEqual(TEXT("Latest sample after shrinking"), (int32)Window.GetLatest().Time, 10);
+
+    // Shrinking a window that hasn't filled yet
+    Window.Reset();
+    Window.SetCapacity(8);
+    AddStatsTestSamples(Window, 1, 5);
+    Window.SetCapacity(2);
+    TestTrue(TEXT("Samples after shrinking a partial window"), GetStatsTestSamples(Window) == TArray<int32>({ 4, 5 }));
+    Window.SetCapacity(0);
+    TestEqual(TEXT("Capacity is at least one"), Window.GetCapacity(), 1);
+    TestTrue(TEXT("Samples in the smallest window"), GetStatsTestSamples(Window) == TArray<int32>({ 5 }));
+    return true;
+}
+
+#endif
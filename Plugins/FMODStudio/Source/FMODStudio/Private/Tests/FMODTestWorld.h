@@ -0,0 +1,81 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FMODRecordingStudioCalls.h"
+#include "FMODAmbientSound.h"
+#include "FMODAudioComponent.h"
+#include "FMODEmitterManager.h"
+#include "FMODStudioModule.h"
+#include "Components/BrushComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Sound/AudioVolume.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Routes the module's Studio calls through a recording implementation for the lifetime of a scenario */
+class FFMODScopedStudioCalls
+{
+public:
+    FFMODScopedStudioCalls(FFMODStudioCalls &Calls) { IFMODStudioModule::Get().SetStudioCalls(&Calls); }
+    ~FFMODScopedStudioCalls() { IFMODStudioModule::Get().SetStudioCalls(nullptr); }
+};
+
+/** Game world holding the emitters of a scenario */
+class FFMODTestWorld
+{
+public:
+    FFMODTestWorld()
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false);
+        FWorldContext &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+    }
+
+    ~FFMODTestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    /** Spawn an ambient sound playing a fake instance, registered with the module's emitter manager */
+    UFMODAudioComponent *SpawnEmitter(FFMODRecordingStudioCalls &Calls, const FVector &Location, float VirtualDistance)
+    {
+        AFMODAmbientSound *Actor = World->SpawnActor<AFMODAmbientSound>(Location, FRotator::ZeroRotator);
+        UFMODAudioComponent *Component = Actor->AudioComponent;
+        Component->StudioInstance = Calls.CreateFakeInstance();
+        Component->SetActiveFlag(true);
+        IFMODStudioModule::Get().GetEmitterManager().Register(Component, Component->StudioInstance, VirtualDistance);
+        return Component;
+    }
+
+    /** Spawn an audio volume with box collision standing in for the brush an artist would build */
+    AAudioVolume *SpawnAudioVolume(const FVector &Center, const FVector &Extent)
+    {
+        AAudioVolume *Volume = World->SpawnActor<AAudioVolume>(Center, FRotator::ZeroRotator);
+        UBrushComponent *Brush = Volume->GetBrushComponent();
+        Brush->UnregisterComponent();
+        Brush->BrushBodySetup = NewObject<UBodySetup>(Brush);
+        Brush->BrushBodySetup->AggGeom.BoxElems.Add(FKBoxElem(Extent.X * 2.0f, Extent.Y * 2.0f, Extent.Z * 2.0f));
+        Brush->RegisterComponent();
+        return Volume;
+    }
+
+    UWorld *World;
+};
+
+/** Run a frame function and return the seconds it took */
+template <typename FrameFunc> double FMODTimeFrames(int32 NumFrames, FrameFunc Frame)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < NumFrames; ++i)
+    {
+        Frame(i);
+    }
+    return FPlatformTime::Seconds() - StartTime;
+}
+
+#endif
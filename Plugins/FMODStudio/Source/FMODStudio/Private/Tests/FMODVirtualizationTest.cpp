@@ -0,0 +1,188 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#include "FMODTestWorld.h"
+#include "FMODEvent.h"
+#include "FMODSettings.h"
+#include "FMODUtils.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+
+#include "FMODStudioPrivatePCH.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFMODVirtualizationTest, "FMOD.Virtualization",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFMODVirtualizationTest::RunTest(const FString &Parameters)
+{
+    const int32 NumColumns = 100;
+    const int32 NumRows = 20;
+    const int32 NumEmitters = NumColumns * NumRows;
+    const float Spacing = 400.0f;
+    const float MaximumDistance = 20.0f;
+    const int EventLength = 4000;
+    const float Hysteresis = 500.0f;
+    const int32 NumFrames = 250;
+    const double FrameSeconds = 1.0 / 30.0;
+
+    IFMODStudioModule &Module = IFMODStudioModule::Get();
+    FFMODEmitterManager &Manager = Module.GetEmitterManager();
+    if (!Module.UseSound() || Manager.Num() > 0)
+    {
+        AddWarning(TEXT("Skipped because sound is disabled or other emitters are playing"));
+        return true;
+    }
+
+    UFMODSettings &Settings = *GetMutableDefault<UFMODSettings>();
+    const bool bSavedVirtualize = Settings.bVirtualizeOutOfRangeEvents;
+    const float SavedHysteresis = Settings.VirtualizationHysteresis;
+    const int32 SavedBudget = Settings.TotalMemoryBudgetForSampleData;
+    Settings.bVirtualizeOutOfRangeEvents = true;
+    Settings.VirtualizationHysteresis = Hysteresis;
+    Settings.TotalMemoryBudgetForSampleData = 0;
+    const double SavedTime = FApp::GetCurrentTime();
+
+    FFMODRecordingStudioCalls Calls;
+    FFMODScopedStudioCalls ScopedCalls(Calls);
+    FFMODTestWorld TestWorld;
+    UFMODEvent *Event = NewObject<UFMODEvent>();
+    Calls.AddFakeEvent(Event, true, false, MaximumDistance, EventLength);
+
+    // The listener stays put and the grid of looping emitters slides past it, which the emitter manager sees the same way
+    const float VirtualDistance = FMODUtils::DistanceToUEScale(MaximumDistance);
+    const FVector ListenerLocation = Module.GetNearestListener(FVector::ZeroVector).Transform.GetTranslation();
+    const float StartX = -(VirtualDistance + Hysteresis * 2.0f);
+    const float Step = (NumColumns * Spacing - 2.0f * StartX) / NumFrames;
+    TArray<FVector> GridLocations;
+    TArray<UFMODAudioComponent *> Components;
+    auto GetOffset = [&](int32 Frame) { return FVector(StartX + Step * Frame, 0.0f, 0.0f); };
+
+    const double PlayTime = SavedTime;
+    FApp::SetCurrentTime(PlayTime);
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        const FVector GridLocation((i % NumColumns) * Spacing, ((i / NumColumns) - NumRows / 2) * Spacing, 0.0f);
+        AFMODAmbientSound *Actor = TestWorld.World->SpawnActor<AFMODAmbientSound>(ListenerLocation + GridLocation - GetOffset(0), FRotator::ZeroRotator);
+        UFMODAudioComponent *Component = Actor->AudioComponent;
+        Component->Event = Event;
+        Component->Play();
+        GridLocations.Add(GridLocation);
+        Components.Add(Component);
+    }
+    TestEqual(TEXT("Emitters registered"), Manager.Num(), NumEmitters);
+    TestEqual(TEXT("Emitters virtual before the listener reaches them"), Manager.NumVirtual(), NumEmitters);
+    Calls.ResetRecords();
+
+    // Within range an emitter must have an instance, beyond the hysteresis margin it must not, and in between either is fine
+    TArray<bool> WasLive;
+    TArray<bool> EverInRange;
+    WasLive.SetNumZeroed(NumEmitters);
+    EverInRange.SetNumZeroed(NumEmitters);
+    int32 MissingInstances = 0;
+    int32 LingeringInstances = 0;
+    int32 WrongTimelinePositions = 0;
+    int32 MaxLive = 0;
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        WasLive[i] = !Components[i]->IsVirtual();
+        EverInRange[i] = FVector::Dist(GridLocations[i], GetOffset(0)) <= VirtualDistance;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    double UpdateSeconds = 0.0;
+    for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+    {
+        const FVector Offset = GetOffset(Frame);
+        const double Now = PlayTime + Frame * FrameSeconds;
+        FApp::SetCurrentTime(Now);
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            Components[i]->GetOwner()->SetActorLocation(ListenerLocation + GridLocations[i] - Offset);
+        }
+
+        const double UpdateStart = FPlatformTime::Seconds();
+        Manager.Update(false);
+        UpdateSeconds += FPlatformTime::Seconds() - UpdateStart;
+
+        int32 Live = 0;
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            const float Distance = FVector::Dist(GridLocations[i], Offset);
+            const bool bLive = !Components[i]->IsVirtual();
+            MissingInstances += (Distance <= VirtualDistance && !bLive);
+            LingeringInstances += (Distance > VirtualDistance + Hysteresis && bLive);
+            EverInRange[i] |= (Distance <= VirtualDistance);
+            Live += bLive;
+
+            // A new instance starts where the looping event would have been had it played all along
+            if (bLive && !WasLive[i])
+            {
+                const int32 Expected = (int32)((Now - PlayTime) * 1000.0) % EventLength;
+                WrongTimelinePositions += (FMath::Abs(Components[i]->GetTimelinePosition() - Expected) > 1);
+            }
+            WasLive[i] = bLive;
+        }
+        MaxLive = FMath::Max(MaxLive, Live);
+    }
+    Calls.Report(*this, FString::Printf(TEXT("%d emitters, listener moving through them"), NumEmitters), UpdateSeconds, NumFrames);
+    AddInfo(FString::Printf(TEXT("At most %d live instances, %.1f ms per frame including moving the emitters"), MaxLive,
+        (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumFrames));
+
+    int32 NumEverInRange = 0;
+    for (bool bInRange : EverInRange)
+    {
+        NumEverInRange += bInRange;
+    }
+    const int32 MaxInRange = FMath::CeilToInt(PI * FMath::Square((VirtualDistance + Hysteresis) / Spacing + 1.0f));
+    TestEqual(TEXT("Emitters in range without an instance"), MissingInstances, 0);
+    TestEqual(TEXT("Emitters beyond the hysteresis margin with an instance"), LingeringInstances, 0);
+    TestEqual(TEXT("Instances started at the wrong timeline position"), WrongTimelinePositions, 0);
+    TestTrue(FString::Printf(TEXT("Live instances (%d) within the area the listener can hear (%d)"), MaxLive, MaxInRange), MaxLive <= MaxInRange);
+
+    // Crossing the path once means one instance per emitter, anything more is flapping at the boundary
+    TestEqual(TEXT("Instances created"), Calls.GetCount(FFMODRecordingStudioCalls::CreateInstanceCall), NumEverInRange);
+    TestEqual(TEXT("Instances released"), Calls.GetCount(FFMODRecordingStudioCalls::ReleaseCall), NumEverInRange);
+    TestEqual(TEXT("Virtual emitters once the listener has passed"), Manager.NumVirtual(), NumEmitters);
+    TestEqual(TEXT("Looping emitters still playing"), Manager.Num(), NumEmitters);
+
+    // Wandering back and forth by less than the margin can't take an emitter both into range and beyond the margin
+    const int32 JitterFrame = NumFrames / 2;
+    TArray<int32> Changes;
+    Changes.SetNumZeroed(NumEmitters);
+    for (int32 i = 0; i < NumEmitters; ++i)
+    {
+        WasLive[i] = !Components[i]->IsVirtual();
+    }
+    for (int32 Frame = 0; Frame < 60; ++Frame)
+    {
+        const FVector Offset = GetOffset(JitterFrame) + FVector(FMath::Sin(Frame * 0.7f), FMath::Cos(Frame * 1.3f), 0.0f) * Hysteresis * 0.45f;
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            Components[i]->GetOwner()->SetActorLocation(ListenerLocation + GridLocations[i] - Offset);
+        }
+        Manager.Update(false);
+        for (int32 i = 0; i < NumEmitters; ++i)
+        {
+            const bool bLive = !Components[i]->IsVirtual();
+            Changes[i] += (bLive != WasLive[i]);
+            WasLive[i] = bLive;
+        }
+    }
+    TestEqual(TEXT("Emitters flapping while the listener wanders"), Changes.FilterByPredicate([](int32 Count) { return Count > 1; }).Num(), 0);
+
+    for (UFMODAudioComponent *Component : Components)
+    {
+        Component->Release();
+        Component->SetActiveFlag(false);
+    }
+    TestEqual(TEXT("Fake instances left"), Calls.NumFakeInstances(), 0);
+
+    FApp::SetCurrentTime(SavedTime);
+    Settings.bVirtualizeOutOfRangeEvents = bSavedVirtualize;
+    Settings.VirtualizationHysteresis = SavedHysteresis;
+    Settings.TotalMemoryBudgetForSampleData = SavedBudget;
+    return true;
+}
+
+#endif
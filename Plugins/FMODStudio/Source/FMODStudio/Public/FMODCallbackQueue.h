@@ -0,0 +1,103 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2020.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/Function.h"
+#include "Templates/Atomic.h"
+
+/**
+ * Passes callbacks from one producer thread to one consumer thread without losing any. Callbacks go through a lock-free ring
+ * buffer, and spill into a locked overflow list while the ring is full. Once callbacks have spilled, later ones also go to the
+ * overflow list until the consumer has drained it, so they are always dequeued in the order they were enqueued.
+ */
+template <typename T>
+class TFMODCallbackQueue
+{
+public:
+    /** Capacity must be a power of two, the ring holds one less than that */
+    explicit TFMODCallbackQueue(uint32 Capacity)
+        : Ring(Capacity)
+        , bOverflowing(false)
+    {
+    }
+
+    /** Called on the producer thread */
+    void Enqueue(T &&Item)
+    {
+        if (!bOverflowing.Load(EMemoryOrder::Relaxed) && Ring.Enqueue(Item))
+        {
+            return;
+        }
+
+        FScopeLock Lock(&OverflowLock);
+        Overflow.Add(MoveTemp(Item));
+        bOverflowing = true;
+    }
+
+    void Enqueue(const T &Item)
+    {
+        Enqueue(T(Item));
+    }
+
+    /**
+     * Called on the consumer thread, passes every queued item to Func in the order they were enqueued. Returns the number of
+     * items that didn't fit in the ring.
+     */
+    template <typename FuncType>
+    int32 DequeueAll(FuncType &&Func)
+    {
+        T Item;
+        while (Ring.Dequeue(Item))
+        {
+            Func(Item);
+        }
+
+#if WITH_DEV_AUTOMATION_TESTS
+        if (OnRingDrained)
+        {
+            OnRingDrained();
+        }
+#endif
+
+        if (!bOverflowing)
+        {
+            return 0;
+        }
+
+        // The producer may have refilled the ring after the loop above found it empty, before it spilled. Those items are
+        // older than anything in the overflow list. Nothing goes into the ring again until the flag is cleared below.
+        while (Ring.Dequeue(Item))
+        {
+            Func(Item);
+        }
+
+        TArray<T> Items;
+        {
+            FScopeLock Lock(&OverflowLock);
+            Items = MoveTemp(Overflow);
+            Overflow.Reset();
+            bOverflowing = false;
+        }
+        for (T &OverflowItem : Items)
+        {
+            Func(OverflowItem);
+        }
+        return Items.Num();
+    }
+
+#if WITH_DEV_AUTOMATION_TESTS
+    /** Called by DequeueAll between draining the ring and checking for overflow, so tests can run the producer there */
+    TFunction<void()> OnRingDrained;
+#endif
+
+private:
+    TCircularQueue<T> Ring;
+
+    FCriticalSection OverflowLock;
+    TArray<T> Overflow;
+    TAtomic<bool> bOverflowing;
+};
@@ -17,10 +17,21 @@ class EventInstance;
 class UFMODAsset;
 class UFMODBank;
 class UFMODEvent;
+class UFMODAudioComponent;
 class UWorld;
 class AAudioVolume;
 struct FInteriorSettings;
+struct FFMODEventDescriptionInfo;
 struct FFMODListener; // Currently only for private use, we don't export this type
+class FFMODEmitterManager; // Currently only for private use, we don't export this type
+class FFMODEventPool; // Currently only for private use, we don't export this type
+class FFMODBankLoader; // Currently only for private use, we don't export this type
+class FFMODHandleCache; // Currently only for private use, we don't export this type
+class FFMODProgrammerSoundCache; // Currently only for private use, we don't export this type
+class FFMODStudioCalls; // Currently only for private use, we don't export this type
+
+/** Reports streamed bank loading progress: number of banks finished (loaded or failed) and number requested */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FFMODBankLoadProgress, int32, int32);
 
 // Which FMOD Studio system to use
 namespace EFMODSystemContext
@@ -109,6 +120,13 @@ public:
     virtual FMOD::Studio::EventDescription *GetEventDescription(
         const UFMODEvent *Event, EFMODSystemContext::Type Context = EFMODSystemContext::Max) = 0;
 
+    /**
+	 * Get an event description along with its commonly used properties, cached on the event until the system's banks change.
+	 * The system type can control which Studio system to use, or leave it as System_Max for it to choose automatically.
+	 */
+    virtual const FFMODEventDescriptionInfo *GetEventDescriptionInfo(
+        const UFMODEvent *Event, EFMODSystemContext::Type Context = EFMODSystemContext::Max) = 0;
+
     /**
 	 * Create a single auditioning instance using the auditioning system
 	 */
@@ -120,7 +138,7 @@ public:
     virtual void StopAuditioningInstance() = 0;
 
     /**
-	 * Return whether the listener(s) have moved
+	 * Return whether the listener(s) have moved since the emitters were last updated
 	 */
     virtual bool HasListenerMoved() = 0;
 
@@ -134,6 +152,12 @@ public:
 	 */
     virtual void FinishSetListenerPosition(int NumListeners) = 0;
 
+    /**
+	 * Called by the editor every tick with the level viewport camera. Moves the editor system's listener, and the runtime
+	 * listener while simulating.
+	 */
+    virtual void UpdateViewportListener(UWorld *World, const FTransform &ViewTransform) = 0;
+
     /**
 	 * Return the audio settings for the listener nearest the given location
 	 */
@@ -165,4 +189,48 @@ public:
 
     /** Set active locale. Locale must be the locale name of one of the configured project locales */
     virtual bool SetLocale(const FString& Locale) = 0;
+
+    /**
+     * Queue an asynchronous occlusion trace for a component.
+     * Traces are issued within the per-frame budget and the result is applied to the component when the trace completes.
+     */
+    virtual void RequestOcclusionTrace(UFMODAudioComponent *Component) = 0;
+
+    /**
+     * Return the manager that updates all playing audio components once per frame
+     */
+    virtual FFMODEmitterManager &GetEmitterManager() = 0;
+
+    /**
+     * Return the pool of recycled event instances and audio components used for one-shots
+     */
+    virtual FFMODEventPool &GetEventPool() = 0;
+
+    /**
+     * Return the scheduler that loads runtime banks over several frames
+     */
+    virtual FFMODBankLoader &GetBankLoader() = 0;
+
+    /** This event is fired as streamed banks finish loading */
+    virtual FFMODBankLoadProgress &BankLoadProgressEvent() = 0;
+
+    /**
+     * Return the cache of the runtime system's bus, VCA and global parameter handles
+     */
+    virtual FFMODHandleCache &GetHandleCache() = 0;
+
+    /**
+     * Return the cache of programmer sounds shared between the runtime system's event instances
+     */
+    virtual FFMODProgrammerSoundCache &GetProgrammerSoundCache() = 0;
+
+    /**
+     * Return the interface the hot paths make their Studio API calls through
+     */
+    virtual FFMODStudioCalls &GetStudioCalls() = 0;
+
+    /**
+     * Replace the Studio API calls made by the hot paths, e.g. with a recording implementation for tests. Null restores the default.
+     */
+    virtual void SetStudioCalls(FFMODStudioCalls *Calls) = 0;
 };
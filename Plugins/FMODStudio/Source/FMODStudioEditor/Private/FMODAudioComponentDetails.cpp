@@ -95,7 +95,15 @@ FReply FFMODAudioComponentDetails::OnPlaySoundClicked()
             {
                 for (auto param : AudioComponent->ParameterCache)
                 {
-                    Instance->setParameterByName(TCHAR_TO_UTF8(*param.Key.ToString()), param.Value);
+                    FMOD_STUDIO_PARAMETER_ID ParameterID;
+                    if (Event->FindParameterID(param.Key, ParameterID))
+                    {
+                        Instance->setParameterByID(ParameterID, param.Value);
+                    }
+                    else
+                    {
+                        Instance->setParameterByName(TCHAR_TO_UTF8(*param.Key.ToString()), param.Value);
+                    }
                 }
                 Instance->start();
             }
@@ -15,13 +15,11 @@ void FFMODAudioComponentVisualizer::DrawVisualization(const UActorComponent *Com
         const UFMODAudioComponent *AudioComp = Cast<const UFMODAudioComponent>(Component);
         if (IsValid(AudioComp) && AudioComp->Event.IsValid())
         {
-            FMOD::Studio::EventDescription *EventDesc =
-                IFMODStudioModule::Get().GetEventDescription(AudioComp->Event.Get(), EFMODSystemContext::Auditioning);
-            if (EventDesc != nullptr)
+            const FFMODEventDescriptionInfo *EventInfo =
+                IFMODStudioModule::Get().GetEventDescriptionInfo(AudioComp->Event.Get(), EFMODSystemContext::Auditioning);
+            if (EventInfo != nullptr)
             {
-                bool bIs3D = false;
-                EventDesc->is3D(&bIs3D);
-                if (bIs3D)
+                if (EventInfo->bIs3D)
                 {
                     const FColor AudioOuterRadiusColor(255, 153, 0);
                     const FColor AudioInnerRadiusColor(216, 130, 0);
@@ -37,8 +35,8 @@ void FFMODAudioComponentVisualizer::DrawVisualization(const UActorComponent *Com
                     }
                     else
                     {
-                        EventDesc->getMinimumDistance(&MinDistance);
-                        EventDesc->getMaximumDistance(&MaxDistance);
+                        MinDistance = EventInfo->MinimumDistance;
+                        MaxDistance = EventInfo->MaximumDistance;
                     }
                     MinDistance = FMODUtils::DistanceToUEScale(MinDistance);
                     MaxDistance = FMODUtils::DistanceToUEScale(MaxDistance);
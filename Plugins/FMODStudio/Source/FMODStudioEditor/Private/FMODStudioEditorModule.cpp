@@ -171,8 +171,7 @@ class FFMODStudioEditorModule : public IFMODStudioEditorModule
 public:
     /** IModuleInterface implementation */
     FFMODStudioEditorModule()
-        : bSimulating(false)
-        , bIsInPIE(false)
+        : bIsInPIE(false)
         , bRegisteredComponentVisualizers(false)
     {
     }
@@ -194,8 +193,6 @@ public:
     void PausePIE(bool simulating);
     void ResumePIE(bool simulating);
 
-    void ViewportDraw(UCanvas *Canvas, APlayerController *);
-
     bool Tick(float DeltaTime);
 
     /** Add extensions to menu */
@@ -242,10 +239,6 @@ public:
     FDelegateHandle FMODControlTrackEditorCreateTrackEditorHandle;
     FDelegateHandle FMODParamTrackEditorCreateTrackEditorHandle;
 
-    /** Hook for drawing viewport */
-    FDebugDrawDelegate ViewportDrawingDelegate;
-    FDelegateHandle ViewportDrawingDelegateHandle;
-
     TSharedPtr<IComponentAssetBroker> AssetBroker;
 
     /** The extender to pass to the level editor to extend its window menu */
@@ -259,7 +252,6 @@ public:
     /** Notification popup that settings are bad */
     TWeakPtr<SNotificationItem> BadSettingsNotification;
 
-    bool bSimulating;
     bool bIsInPIE;
     bool bRegisteredComponentVisualizers;
 };
@@ -335,9 +327,6 @@ void FFMODStudioEditorModule::StartupModule()
     PausePIEDelegateHandle = FEditorDelegates::PausePIE.AddRaw(this, &FFMODStudioEditorModule::PausePIE);
     ResumePIEDelegateHandle = FEditorDelegates::ResumePIE.AddRaw(this, &FFMODStudioEditorModule::ResumePIE);
 
-    ViewportDrawingDelegate = FDebugDrawDelegate::CreateRaw(this, &FFMODStudioEditorModule::ViewportDraw);
-    ViewportDrawingDelegateHandle = UDebugDrawService::Register(TEXT("Editor"), ViewportDrawingDelegate);
-
     OnTick = FTickerDelegate::CreateRaw(this, &FFMODStudioEditorModule::Tick);
     TickDelegateHandle = FTicker::GetCoreTicker().AddTicker(OnTick);
 
@@ -999,24 +988,12 @@ bool FFMODStudioEditorModule::Tick(float DeltaTime)
         bRegisteredComponentVisualizers = true;
     }
 
-    // Update listener position for Editor sound system
-    FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Editor);
-    if (StudioSystem)
+    // Update listener position for Editor sound system, and for the runtime system while simulating
+    if (GCurrentLevelEditingViewportClient)
     {
-        if (GCurrentLevelEditingViewportClient)
-        {
-            const FVector &ViewLocation = GCurrentLevelEditingViewportClient->GetViewLocation();
-            FMatrix CameraToWorld = FRotationMatrix::Make(GCurrentLevelEditingViewportClient->GetViewRotation());
-            FVector Up = CameraToWorld.GetUnitAxis(EAxis::Z);
-            FVector Forward = CameraToWorld.GetUnitAxis(EAxis::X);
-
-            FMOD_3D_ATTRIBUTES Attributes = { { 0 } };
-            Attributes.position = FMODUtils::ConvertWorldVector(ViewLocation);
-            Attributes.forward = FMODUtils::ConvertUnitVector(Forward);
-            Attributes.up = FMODUtils::ConvertUnitVector(Up);
-
-            verifyfmod(StudioSystem->setListenerAttributes(0, &Attributes));
-        }
+        FTransform ViewTransform(GCurrentLevelEditingViewportClient->GetViewRotation(), GCurrentLevelEditingViewportClient->GetViewLocation());
+        ViewTransform.NormalizeRotation();
+        IFMODStudioModule::Get().UpdateViewportListener(GCurrentLevelEditingViewportClient->GetWorld(), ViewTransform);
     }
 
     return true;
@@ -1025,7 +1002,6 @@ bool FFMODStudioEditorModule::Tick(float DeltaTime)
 void FFMODStudioEditorModule::BeginPIE(bool simulating)
 {
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioEditorModule BeginPIE: %d"), simulating);
-    bSimulating = simulating;
     bIsInPIE = true;
     IFMODStudioModule::Get().SetInPIE(true, simulating);
 }
@@ -1033,7 +1009,6 @@ void FFMODStudioEditorModule::BeginPIE(bool simulating)
 void FFMODStudioEditorModule::EndPIE(bool simulating)
 {
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioEditorModule EndPIE: %d"), simulating);
-    bSimulating = false;
     bIsInPIE = false;
     IFMODStudioModule::Get().SetInPIE(false, simulating);
 }
@@ -1055,35 +1030,6 @@ void FFMODStudioEditorModule::PostLoadCallback()
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioEditorModule PostLoadCallback"));
 }
 
-void FFMODStudioEditorModule::ViewportDraw(UCanvas *Canvas, APlayerController *)
-{
-    // Only want to update based on viewport in simulate mode.
-    // In PIE/game, we update from the player controller instead.
-    if (!bSimulating)
-    {
-        return;
-    }
-
-    const FSceneView *View = Canvas->SceneView;
-
-    if (View->Drawer == GCurrentLevelEditingViewportClient)
-    {
-        UWorld *World = GCurrentLevelEditingViewportClient->GetWorld();
-        const FVector &ViewLocation = GCurrentLevelEditingViewportClient->GetViewLocation();
-
-        FMatrix CameraToWorld = View->ViewMatrices.GetViewMatrix().InverseFast();
-        FVector ProjUp = CameraToWorld.TransformVector(FVector(0, 1000, 0));
-        FVector ProjRight = CameraToWorld.TransformVector(FVector(1000, 0, 0));
-
-        FTransform ListenerTransform(FRotationMatrix::MakeFromZY(ProjUp, ProjRight));
-        ListenerTransform.SetTranslation(ViewLocation);
-        ListenerTransform.NormalizeRotation();
-
-        IFMODStudioModule::Get().SetListenerPosition(0, World, ListenerTransform, 0.0f);
-        IFMODStudioModule::Get().FinishSetListenerPosition(1);
-    }
-}
-
 void FFMODStudioEditorModule::ShutdownModule()
 {
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioEditorModule shutdown"));
@@ -1098,11 +1044,6 @@ void FFMODStudioEditorModule::ShutdownModule()
         FEditorDelegates::PausePIE.Remove(PausePIEDelegateHandle);
         FEditorDelegates::ResumePIE.Remove(ResumePIEDelegateHandle);
 
-        if (ViewportDrawingDelegate.IsBound())
-        {
-            UDebugDrawService::Unregister(ViewportDrawingDelegateHandle);
-        }
-
         FComponentAssetBrokerage::UnregisterBroker(AssetBroker);
 
         if (MainMenuExtender.IsValid())
@@ -14,14 +14,29 @@
 #include <LandscapeMaterialInstanceConstant.h>
 #include <Materials/MaterialInstanceConstant.h>
 #include <Components/InstancedStaticMeshComponent.h>
+#include <Components/StaticMeshComponent.h>
+#include <Components/SplineMeshComponent.h>
+#include <HAL/PlatformTime.h>
+#include <EditorModeManager.h>
+#include <EditorModes.h>
+#include "../sfLandscapeEdModeHack.h"
+
+// Time in seconds to spend generating brush model lock meshes per frame. At least one mesh is generated per frame.
+#define MODEL_MESH_BUILD_BUDGET 0.005
+// Number of landscape components to check lock materials on per frame while landscape mode is active
+#define LANDSCAPE_CHECK_CHUNK_SIZE 64
 
 TMap<ABrush*, UsfLockComponent::MeshData> UsfLockComponent::m_modelMeshes;
+TArray<TWeakObjectPtr<UsfLockComponent>> UsfLockComponent::m_pendingModelMeshes;
+FDelegateHandle UsfLockComponent::m_modelMeshTickerHandle;
 
 UsfLockComponent::UsfLockComponent()
 {
     m_copied = false;
     m_initialized = false;
     m_materialPtr = nullptr;
+    m_landscapeCheckIndex = 0;
+    m_landscapeToolPtr = nullptr;
     ClearFlags(RF_Transactional);// Prevent component from being recorded in transactions
     SetFlags(RF_Transient);// Prevent component from being saved
 }
@@ -29,6 +44,7 @@ UsfLockComponent::UsfLockComponent()
 UsfLockComponent::~UsfLockComponent()
 {
     FTicker::GetCoreTicker().RemoveTicker(m_tickerHandle);
+    FTicker::GetCoreTicker().RemoveTicker(m_landscapeTickerHandle);
 }
 
 void UsfLockComponent::InitializeComponent()
@@ -65,7 +81,19 @@ void UsfLockComponent::DuplicateParentMesh(UMaterialInterface* materialPtr)
     }
     FString name = GetName();
     name.Append("Mesh");
-    UMeshComponent* copyPtr = DuplicateObject(parentPtr, this, *name);
+    UMeshComponent* copyPtr;
+    UStaticMeshComponent* staticMeshPtr = Cast<UStaticMeshComponent>(parentPtr);
+    if (staticMeshPtr != nullptr && !staticMeshPtr->IsA<UInstancedStaticMeshComponent>() &&
+        !staticMeshPtr->IsA<USplineMeshComponent>())
+    {
+        // Instead of duplicating the whole component, create a bare component that renders the same mesh asset.
+        copyPtr = CreateStaticMeshOverlay(staticMeshPtr, *name);
+    }
+    else
+    {
+        // Instanced, spline and skinned meshes need their per-component render data, so we duplicate them.
+        copyPtr = DuplicateObject(parentPtr, this, *name);
+    }
     if (copyPtr->IsPendingKill())
     {
         return;
@@ -75,6 +103,19 @@ void UsfLockComponent::DuplicateParentMesh(UMaterialInterface* materialPtr)
     copyPtr->SetRelativeScale3D(FVector::OneVector);
 }
 
+UStaticMeshComponent* UsfLockComponent::CreateStaticMeshOverlay(UStaticMeshComponent* parentPtr, FName name)
+{
+    UStaticMeshComponent* componentPtr = NewObject<UStaticMeshComponent>(this, name);
+    componentPtr->SetStaticMesh(parentPtr->GetStaticMesh());
+    componentPtr->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    componentPtr->SetCanEverAffectNavigation(false);
+    componentPtr->SetCastShadow(false);
+    componentPtr->bReverseCulling = parentPtr->bReverseCulling;
+    componentPtr->ForcedLodModel = parentPtr->ForcedLodModel;
+    componentPtr->MinLOD = parentPtr->MinLOD;
+    return componentPtr;
+}
+
 void UsfLockComponent::CreateOrFindModelMesh(UMaterialInterface* materialPtr)
 {
     m_initialized = true;
@@ -82,6 +123,53 @@ void UsfLockComponent::CreateOrFindModelMesh(UMaterialInterface* materialPtr)
     {
         m_materialPtr = materialPtr;
     }
+    ABrush* brushPtr = Cast<ABrush>(GetOwner());
+    if (brushPtr == nullptr || brushPtr->Brush == nullptr)
+    {
+        return;
+    }
+    if (m_modelMeshes.Contains(brushPtr))
+    {
+        AttachModelMesh();
+        return;
+    }
+    // Generating a mesh from a brush is slow, so queue the component and generate meshes over multiple frames.
+    m_pendingModelMeshes.AddUnique(this);
+    if (!m_modelMeshTickerHandle.IsValid())
+    {
+        m_modelMeshTickerHandle = FTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateStatic(&UsfLockComponent::BuildPendingModelMeshes));
+    }
+}
+
+bool UsfLockComponent::BuildPendingModelMeshes()
+{
+    double endTime = FPlatformTime::Seconds() + MODEL_MESH_BUILD_BUDGET;
+    int index = 0;
+    while (index < m_pendingModelMeshes.Num())
+    {
+        TWeakObjectPtr<UsfLockComponent> lockPtr = m_pendingModelMeshes[index];
+        index++;
+        if (lockPtr.IsValid() && lockPtr->IsRegistered())
+        {
+            lockPtr->AttachModelMesh();
+            if (FPlatformTime::Seconds() >= endTime)
+            {
+                break;
+            }
+        }
+    }
+    m_pendingModelMeshes.RemoveAt(0, index);
+    if (m_pendingModelMeshes.Num() == 0)
+    {
+        m_modelMeshTickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
+
+void UsfLockComponent::AttachModelMesh()
+{
     ABrush* brushPtr = Cast<ABrush>(GetOwner());
     if (brushPtr == nullptr || brushPtr->Brush == nullptr)
     {
@@ -134,42 +222,126 @@ void UsfLockComponent::SetLandscapeMaterial(UMaterialInterface* materialPtr)
     SceneFusion::RedrawActiveViewport();
     if (materialPtr == nullptr)
     {
-        FTicker::GetCoreTicker().RemoveTicker(m_tickerHandle);
-        m_tickerHandle.Reset();
+        StopLandscapeMaterialUpdates();
         return;
     }
-    if (m_tickerHandle.IsValid())
+    if (m_editorModeChangedHandle.IsValid())
     {
         return;
     }
     // We set the editor-only material that is intended to show the landscape brush indicator to the lock shader.
-    // Because Unreal uses this material too, we need to check it every frame and set it back to the lock shader if it
-    // has changed.
-    m_tickerHandle = FTicker::GetCoreTicker().AddTicker(
+    // Only landscape mode changes this material, so we only need to check it while landscape mode is active.
+    TWeakObjectPtr<UsfLockComponent> weakThis = this;
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 24
+    m_editorModeChangedHandle = GLevelEditorModeTools().OnEditorModeIDChanged().AddLambda(
+        [weakThis](const FEditorModeID& modeId, bool isEntering)
+    {
+        if (weakThis.IsValid() && modeId == FBuiltinEditorModes::EM_Landscape)
+        {
+            weakThis->OnLandscapeModeChanged(isEntering);
+        }
+    });
+#else
+    m_editorModeChangedHandle = GLevelEditorModeTools().OnEditorModeChanged().AddLambda(
+        [weakThis](FEdMode* modePtr, bool isEntering)
+    {
+        if (weakThis.IsValid() && modePtr != nullptr && modePtr->GetID() == FBuiltinEditorModes::EM_Landscape)
+        {
+            weakThis->OnLandscapeModeChanged(isEntering);
+        }
+    });
+#endif
+    if (GLevelEditorModeTools().IsModeActive(FBuiltinEditorModes::EM_Landscape))
+    {
+        OnLandscapeModeChanged(true);
+    }
+}
+
+void UsfLockComponent::StopLandscapeMaterialUpdates()
+{
+    FTicker::GetCoreTicker().RemoveTicker(m_landscapeTickerHandle);
+    m_landscapeTickerHandle.Reset();
+    if (m_editorModeChangedHandle.IsValid())
+    {
+#if ENGINE_MAJOR_VERSION >= 4 && ENGINE_MINOR_VERSION >= 24
+        GLevelEditorModeTools().OnEditorModeIDChanged().Remove(m_editorModeChangedHandle);
+#else
+        GLevelEditorModeTools().OnEditorModeChanged().Remove(m_editorModeChangedHandle);
+#endif
+        m_editorModeChangedHandle.Reset();
+    }
+}
+
+void UsfLockComponent::OnLandscapeModeChanged(bool isEntering)
+{
+    if (!isEntering)
+    {
+        FTicker::GetCoreTicker().RemoveTicker(m_landscapeTickerHandle);
+        m_landscapeTickerHandle.Reset();
+        m_landscapeToolPtr = nullptr;
+        // Landscape mode clears the tool materials when it exits, so set them all back to the lock material.
+        UpdateLandscapeMaterials();
+        SceneFusion::RedrawActiveViewport();
+        return;
+    }
+    if (m_landscapeTickerHandle.IsValid())
+    {
+        return;
+    }
+    m_landscapeCheckIndex = 0;
+    m_landscapeToolPtr = nullptr;
+    m_landscapeTickerHandle = FTicker::GetCoreTicker().AddTicker(
         FTickerDelegate::CreateLambda([this](float deltaTime)
     {
-        return UpdateLandscapeMaterials();
+        return TickLandscapeMaterials();
     }));
 }
 
-bool UsfLockComponent::UpdateLandscapeMaterials()
+bool UsfLockComponent::TickLandscapeMaterials()
+{
+    FEdMode* modePtr = GLevelEditorModeTools().GetActiveMode(FBuiltinEditorModes::EM_Landscape);
+    if (modePtr == nullptr)
+    {
+        OnLandscapeModeChanged(false);
+        return false;
+    }
+    // Changing the landscape tool sets tool materials on many components at once, so check all components when the
+    // tool changes. Otherwise only the components under the brush change, so we check a chunk of components per frame.
+    sfLandscapeEdModeHack* hackPtr = static_cast<sfLandscapeEdModeHack*>(modePtr);
+    if (hackPtr->CurrentTool != m_landscapeToolPtr)
+    {
+        m_landscapeToolPtr = hackPtr->CurrentTool;
+        m_landscapeCheckIndex = 0;
+        UpdateLandscapeMaterials();
+    }
+    else
+    {
+        m_landscapeCheckIndex = UpdateLandscapeMaterials(m_landscapeCheckIndex, LANDSCAPE_CHECK_CHUNK_SIZE);
+    }
+    return true;
+}
+
+int UsfLockComponent::UpdateLandscapeMaterials(int startIndex, int count)
 {
     ALandscapeProxy* landscapePtr = Cast<ALandscapeProxy>(GetOwner());
     if (landscapePtr == nullptr)
     {
-        return false;
+        return 0;
     }
-    for (ULandscapeComponent* componentPtr : landscapePtr->LandscapeComponents)
+    int numComponents = landscapePtr->LandscapeComponents.Num();
+    int endIndex = count < 0 ? numComponents : FMath::Min(startIndex + count, numComponents);
+    for (int i = startIndex; i < endIndex; i++)
     {
-        if (componentPtr->EditToolRenderData.ToolMaterial != m_materialPtr ||
-            componentPtr->EditToolRenderData.GizmoMaterial != m_materialPtr)
+        ULandscapeComponent* componentPtr = landscapePtr->LandscapeComponents[i];
+        if (componentPtr != nullptr && (componentPtr->EditToolRenderData.ToolMaterial != m_materialPtr ||
+            componentPtr->EditToolRenderData.GizmoMaterial != m_materialPtr))
         {
             componentPtr->EditToolRenderData.ToolMaterial = m_materialPtr;
             componentPtr->EditToolRenderData.GizmoMaterial = m_materialPtr;
             componentPtr->UpdateEditToolRenderData();
         }
     }
-    return true;
+    return endIndex >= numComponents ? 0 : endIndex;
 }
 
 void UsfLockComponent::InitializeMeshComponent(UMeshComponent* componentPtr)
@@ -250,8 +422,8 @@ void UsfLockComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
             componentPtr->EditToolRenderData.GizmoMaterial = nullptr;
             componentPtr->UpdateEditToolRenderData();
         }
-        // Remove the tick function that keeps the lock shader on landscape components
-        FTicker::GetCoreTicker().RemoveTicker(m_tickerHandle);
+        // Stop keeping the lock shader on landscape components
+        StopLandscapeMaterialUpdates();
     }
 
     Super::OnComponentDestroyed(bDestroyingHierarchy);
@@ -314,19 +486,33 @@ void UsfLockComponent::OnUPropertyChange(UObject* uobjPtr, FPropertyChangedEvent
     }
     if (ev.MemberProperty->GetName().Contains("mesh"))
     {
-        // Destroy child mesh and create a new copy of the parent mesh
+        // Destroy child mesh and create a new lock mesh for the parent mesh
+        UStaticMeshComponent* parentStaticMeshPtr = Cast<UStaticMeshComponent>(uobjPtr);
         for (int i = GetNumChildrenComponents() - 1; i >= 0; i--)
         {
             USceneComponent* childPtr = GetChildComponent(i);
-            if (childPtr != nullptr && childPtr->GetClass() == uobjPtr->GetClass())
+            if (childPtr == nullptr || !childPtr->IsA<UMeshComponent>())
             {
-                if (ev.MemberProperty->Identical_InContainer(childPtr, uobjPtr))
-                {
-                    // The mesh is the same as the lock mesh. Do nothing.
-                    return;
-                }
-                childPtr->DestroyComponent();
+                continue;
+            }
+            bool isSameMesh;
+            if (childPtr->GetClass() == uobjPtr->GetClass())
+            {
+                isSameMesh = ev.MemberProperty->Identical_InContainer(childPtr, uobjPtr);
             }
+            else
+            {
+                // Static mesh lock overlays are plain static mesh components that share the parent's mesh asset.
+                UStaticMeshComponent* childStaticMeshPtr = Cast<UStaticMeshComponent>(childPtr);
+                isSameMesh = parentStaticMeshPtr != nullptr && childStaticMeshPtr != nullptr &&
+                    parentStaticMeshPtr->GetStaticMesh() == childStaticMeshPtr->GetStaticMesh();
+            }
+            if (isSameMesh)
+            {
+                // The mesh is the same as the lock mesh. Do nothing.
+                return;
+            }
+            childPtr->DestroyComponent();
         }
         DuplicateParentMesh(m_materialPtr);
     }
@@ -408,4 +594,10 @@ void UsfLockComponent::DestroyModelMeshes()
         meshPtr->ClearFlags(RF_Standalone); // Allow Unreal to garbage collect the mesh
     }
     m_modelMeshes.Empty();
-}
\ No newline at end of file
+    m_pendingModelMeshes.Empty();
+    FTicker::GetCoreTicker().RemoveTicker(m_modelMeshTickerHandle);
+    m_modelMeshTickerHandle.Reset();
+}
+
+#undef LANDSCAPE_CHECK_CHUNK_SIZE
+#undef MODEL_MESH_BUILD_BUDGET
\ No newline at end of file
@@ -37,12 +37,15 @@ const sfName sfProp::Offsetmap = "#offsetmap";
 const sfName sfProp::Weightmap = "#weightmap";
 const sfName sfProp::SyncBlueprint = "#syncBlueprint";
 const sfName sfProp::SyncLandscape = "#syncLandscape";
+const sfName sfProp::ModelFormat = "#modelFormat";
 const sfName sfProp::Type = "#type";
 const sfName sfProp::Instances = "#instances";
 const sfName sfProp::Component = "#component";
 const sfName sfProp::Checksum = "#checksum";
 const sfName sfProp::LockLocation = "#lockLocation";
 const sfName sfProp::Layers = "#layers";
+const sfName sfProp::Manifest = "#manifest";
+const sfName sfProp::Chunks = "#chunks";
 
 const sfName sfType::Actor = "Actor";
 const sfName sfType::Avatar = "Avatar";
@@ -44,6 +44,11 @@
 
 #define LOG_CHANNEL "sfActorTranslator"
 
+// Show a progress bar when uploading at least this many actors at once.
+#define UPLOAD_PROGRESS_THRESHOLD 500
+// Number of actors to process between progress bar updates.
+#define UPLOAD_PROGRESS_INTERVAL 100
+
 sfActorTranslator::sfActorTranslator()
 {
     RegisterPropertyChangeHandlers();
@@ -396,9 +401,24 @@ void sfActorTranslator::UploadActors(TArray<AActor*>& actors)
     ULevel* levelPtr = nullptr;
     uint32_t limit = m_sessionPtr->GetObjectLimit(sfType::Actor);
     int numActors = 0;
+
+    int total = actors.Num();
+    int processed = 0;
+    bool showProgress = total >= UPLOAD_PROGRESS_THRESHOLD;
+    if (showProgress)
+    {
+        GWarn->BeginSlowTask(NSLOCTEXT("SceneFusion", "SceneFusion_UploadActors", "Uploading actors"), true);
+    }
     for (auto iter = actors.CreateIterator(); iter; ++iter)
     {
         AActor* actorPtr = *iter;
+        processed++;
+        if (showProgress && processed % UPLOAD_PROGRESS_INTERVAL == 0)
+        {
+            GWarn->StatusUpdate(processed, total, FText::Format(
+                NSLOCTEXT("SceneFusion", "SceneFusion_UploadActorsProgress", "Uploading actors ({0}/{1})"),
+                FText::AsNumber(processed), FText::AsNumber(total)));
+        }
         sfObject::SPtr objPtr = sfObjectMap::GetSFObject(actorPtr);
         if (objPtr != nullptr && objPtr->IsDeletePending())
         {
@@ -474,6 +494,10 @@ void sfActorTranslator::UploadActors(TArray<AActor*>& actors)
         }
     }
     Upload(objects, numActors, limit, parentPtr, levelPtr);
+    if (showProgress)
+    {
+        GWarn->EndSlowTask();
+    }
 }
 
 void sfActorTranslator::Upload(
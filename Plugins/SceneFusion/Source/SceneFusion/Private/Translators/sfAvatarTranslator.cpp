@@ -2,6 +2,7 @@
 #include "../../Public/sfPropertyUtil.h"
 #include "../../Public/SceneFusion.h"
 #include "../../Public/Consts.h"
+#include "../../Public/sfConfig.h"
 #include "../Actors/sfBodyActor.h"
 #include "../Components/sfFlashlightComponent.h"
 
@@ -35,6 +36,17 @@
 
 #define INTERPOLATING_FRAME_NUM 35
 
+// Sent locations are snapped to a grid of this size.
+#define LOCATION_PRECISION 0.1f
+// Sent rotation quaternion components are snapped to a grid of this size.
+#define ROTATION_PRECISION (1.0f / 16384.0f)
+// Remote avatars are rendered this many send intervals in the past so they can be interpolated.
+#define INTERPOLATION_DELAY_INTERVALS 1.5f
+// Maximum time in seconds to extrapolate an avatar past its last received transform.
+#define MAX_EXTRAPOLATION_TIME 0.25
+// Maximum number of transforms to buffer per avatar.
+#define MAX_TRANSFORM_SNAPSHOTS 16
+
 sfAvatarTranslator::sfAvatarTranslator() :
     m_leftId{ -1 },
     m_rightId{ -1 },
@@ -47,7 +59,9 @@ sfAvatarTranslator::sfAvatarTranslator() :
     m_flashlightOn{ false },
     m_followingCameraPtr{ nullptr },
     m_interpolatingFrame{ -1 },
-    m_showAvatar { true }
+    m_showAvatar { true },
+    m_sendTimer{ 0.0f },
+    m_settlePending{ false }
 {
     LoadMaterialAndMeshes();
     RegisterPropertyChangeHandlers();
@@ -172,6 +186,7 @@ void sfAvatarTranslator::DestroyAvatars()
         pair.Value->ClearFlags(EObjectFlags::RF_Standalone);// Allow unreal to destroy the material instance
     }
     m_userIdToMaterial.Empty();
+    m_avatarMotions.Empty();
 }
 
 void sfAvatarTranslator::RegisterPropertyChangeHandlers()
@@ -235,28 +250,14 @@ void sfAvatarTranslator::RegisterPropertyChangeHandlers()
 
     m_propertyChangeHandlers[sfProp::Location] = [this](sfProperty::SPtr propertyPtr)
     {
-        AsfAvatarActor* actorPtr = m_sfObjToActor.FindRef(propertyPtr->GetContainerObject()->Id());
-        if (IsActorValid(actorPtr))
-        {
-            actorPtr->SetActorLocation(sfPropertyUtil::ToVector(propertyPtr));
-            if (m_followingCameraPtr == actorPtr)
-            {
-                StartFollowing();
-            }
-        }
+        FVector location = sfPropertyUtil::ToVector(propertyPtr);
+        OnReceiveTransform(propertyPtr->GetContainerObject(), &location, nullptr);
     };
 
     m_propertyChangeHandlers[sfProp::Rotation] = [this](sfProperty::SPtr propertyPtr)
     {
-        AsfAvatarActor* actorPtr = m_sfObjToActor.FindRef(propertyPtr->GetContainerObject()->Id());
-        if (IsActorValid(actorPtr))
-        {
-            actorPtr->SetRotation(sfPropertyUtil::ToQuat(propertyPtr));
-            if (m_followingCameraPtr == actorPtr)
-            {
-                StartFollowing();
-            }
-        }
+        FQuat rotation = sfPropertyUtil::ToQuat(propertyPtr);
+        OnReceiveTransform(propertyPtr->GetContainerObject(), nullptr, &rotation);
     };
 
     m_propertyChangeHandlers[sfProp::Scale] = [this](sfProperty::SPtr propertyPtr)
@@ -330,6 +331,14 @@ void sfAvatarTranslator::OnCreate(sfObject::SPtr objPtr, int childIndex)
             }
 
             m_sfObjToActor.Add(currentObjectPtr->Id(), actorPtr);
+
+            AvatarMotion motion;
+            motion.TargetLocation = actorPtr->GetActorLocation();
+            motion.TargetRotation = actorPtr->GetActorQuat();
+            motion.Dirty = false;
+            motion.Snapshots.Add({ FPlatformTime::Seconds(), motion.TargetLocation, motion.TargetRotation });
+            m_avatarMotions.Add(currentObjectPtr->Id(), motion);
+
             if (meshId == HEAD || meshId == CAMERA)
             {
                 m_userIdToCamera.Add(userId, actorPtr);
@@ -350,6 +359,7 @@ void sfAvatarTranslator::OnDelete(sfObject::SPtr objPtr)
             GEditor->GetEditorWorldContext().World()->EditorDestroyActor(actorPtr, false);
         }
         m_sfObjToActor.Remove(currentObjectPtr->Id());
+        m_avatarMotions.Remove(currentObjectPtr->Id());
         return true;
     });
 }
@@ -440,8 +450,9 @@ uint32_t sfAvatarTranslator::GetOwnerId(sfObject::SPtr objPtr)
 
 void sfAvatarTranslator::Tick(float deltaTime)
 {
+    UpdateAvatarMotion();
     HideUserAvatar();
-    SendChange();
+    SendChange(deltaTime);
     MoveViewportTowardsFollowedCamera();
 }
 
@@ -470,7 +481,7 @@ void sfAvatarTranslator::HideUserAvatar()
     }
 }
 
-void sfAvatarTranslator::SendChange()
+void sfAvatarTranslator::SendChange(float deltaTime)
 {
     //Handle XR mode change
     sfDictionaryProperty::SPtr cameraPropertiesPtr = m_cameraObjPtr->Property()->AsDict();
@@ -494,16 +505,47 @@ void sfAvatarTranslator::SendChange()
         }
     }
 
-    //Send camera location and rotation to server
-    FVector location;
-    FQuat rotation;
-    if (GetCameraLocationAndRotation(location, rotation))
+    //Send camera and controller transforms to server, limited to the configured send rate
+    m_sendTimer += deltaTime;
+    if (m_sendTimer >= 1.0f / FMath::Max(sfConfig::Get().AvatarSendRate, 1.0f))
     {
-        SendTransform(cameraPropertiesPtr, location, rotation);
-    }
+        bool sent = false;
+        FVector location;
+        FQuat rotation;
+        bool hasCamera = GetCameraLocationAndRotation(location, rotation);
+        if (hasCamera)
+        {
+            sent = SendTransform(cameraPropertiesPtr, location, rotation);
+        }
+
+        //Send controllerActorPtr location and rotation to server
+        if (SendControllerTransformToServer())
+        {
+            sent = true;
+        }
 
-    //Send controllerActorPtr location and rotation to server
-    SendControllerTransformToServer();
+        if (sent)
+        {
+            m_settlePending = true;
+        }
+        else if (m_settlePending)
+        {
+            // Movement dropped below the thresholds. Send the resting pose so remote avatars don't stop short of it.
+            m_settlePending = false;
+            if (hasCamera)
+            {
+                sent = SendTransform(cameraPropertiesPtr, location, rotation, true);
+            }
+            if (SendControllerTransformToServer(true))
+            {
+                sent = true;
+            }
+        }
+        if (sent)
+        {
+            m_sendTimer = 0.0f;
+        }
+    }
 
     if (m_isInXRMode)
     {
@@ -555,8 +597,9 @@ void sfAvatarTranslator::GetXRDeviceLocationAndRotation(int deviceId, FVector& l
     rotation = trackingToWorldTransform.TransformRotation(rotation);
 }
 
-void sfAvatarTranslator::SendControllerTransformToServer()
+bool sfAvatarTranslator::SendControllerTransformToServer(bool force)
 {
+    bool sent = false;
     if (m_isInXRMode)
     {
         bool createControllers = false;
@@ -575,7 +618,7 @@ void sfAvatarTranslator::SendControllerTransformToServer()
             }
             else
             {
-                return;
+                return false;
             }
         }
 
@@ -602,10 +645,13 @@ void sfAvatarTranslator::SendControllerTransformToServer()
         else
         {
             leftPropertiesPtr = m_leftObjPtr->Property()->AsDict();
-            SendTransform(leftPropertiesPtr, leftLocation, leftRotation);
+            sent = SendTransform(leftPropertiesPtr, leftLocation, leftRotation, force);
 
             rightPropertiesPtr = m_rightObjPtr->Property()->AsDict();
-            SendTransform(rightPropertiesPtr, rightLocation, rightRotation);
+            if (SendTransform(rightPropertiesPtr, rightLocation, rightRotation, force))
+            {
+                sent = true;
+            }
         }
 
         if (createControllers)
@@ -614,24 +660,152 @@ void sfAvatarTranslator::SendControllerTransformToServer()
             m_sessionPtr->Create(m_leftObjPtr, m_cameraObjPtr, 0);
             m_rightObjPtr = sfObject::Create(sfType::Avatar, rightPropertiesPtr);
             m_sessionPtr->Create(m_rightObjPtr, m_cameraObjPtr, 1);
+            sent = true;
         }
     }
+    return sent;
 }
 
-void sfAvatarTranslator::SendTransform(
+bool sfAvatarTranslator::SendTransform(
     sfDictionaryProperty::SPtr propertiesPtr,
     const FVector& location,
-    const FQuat& rotation)
+    const FQuat& rotation,
+    bool force)
 {
+    bool sent = false;
+    FVector sentLocation = sfPropertyUtil::ToVector(propertiesPtr->Get(sfProp::Location));
+    FVector quantizedLocation(
+        FMath::GridSnap(location.X, LOCATION_PRECISION),
+        FMath::GridSnap(location.Y, LOCATION_PRECISION),
+        FMath::GridSnap(location.Z, LOCATION_PRECISION));
+    if (force ? !sentLocation.Equals(quantizedLocation, LOCATION_PRECISION * 0.5f) :
+        FVector::Dist(sentLocation, location) > sfConfig::Get().AvatarPositionThreshold)
+    {
+        propertiesPtr->Set(sfProp::Location, sfPropertyUtil::FromVector(quantizedLocation));
+        sent = true;
+    }
 
-    if (sfPropertyUtil::ToVector(propertiesPtr->Get(sfProp::Location)) != location)
+    FQuat sentRotation = sfPropertyUtil::ToQuat(propertiesPtr->Get(sfProp::Rotation));
+    FQuat quantizedRotation(
+        FMath::GridSnap(rotation.X, ROTATION_PRECISION),
+        FMath::GridSnap(rotation.Y, ROTATION_PRECISION),
+        FMath::GridSnap(rotation.Z, ROTATION_PRECISION),
+        FMath::GridSnap(rotation.W, ROTATION_PRECISION));
+    quantizedRotation.Normalize();
+    // q and -q are the same rotation, so compare the absolute dot product instead of the components.
+    if (force ? FMath::Abs(sentRotation | quantizedRotation) < 1.0f - ROTATION_PRECISION :
+        FMath::RadiansToDegrees(sentRotation.AngularDistance(rotation)) > sfConfig::Get().AvatarAngleThreshold)
+    {
+        propertiesPtr->Set(sfProp::Rotation, sfPropertyUtil::FromQuat(quantizedRotation));
+        sent = true;
+    }
+    return sent;
+}
+
+void sfAvatarTranslator::OnReceiveTransform(
+    sfObject::SPtr objPtr,
+    const FVector* locationPtr,
+    const FQuat* rotationPtr)
+{
+    AvatarMotion* motionPtr = m_avatarMotions.Find(objPtr->Id());
+    if (motionPtr == nullptr)
+    {
+        return;
+    }
+    // Location and rotation arrive as separate property changes. They are combined into one snapshot on the next
+    // tick.
+    if (locationPtr != nullptr)
     {
-        propertiesPtr->Set(sfProp::Location, sfPropertyUtil::FromVector(location));
+        motionPtr->TargetLocation = *locationPtr;
     }
+    if (rotationPtr != nullptr)
+    {
+        motionPtr->TargetRotation = *rotationPtr;
+    }
+    motionPtr->Dirty = true;
+}
 
-    if (sfPropertyUtil::ToQuat(propertiesPtr->Get(sfProp::Rotation)) != rotation)
+void sfAvatarTranslator::UpdateAvatarMotion()
+{
+    double now = FPlatformTime::Seconds();
+    double sendInterval = 1.0 / FMath::Max(sfConfig::Get().AvatarSendRate, 1.0f);
+    double renderTime = now - sendInterval * INTERPOLATION_DELAY_INTERVALS;
+    for (auto iter = m_avatarMotions.CreateIterator(); iter; ++iter)
     {
-        propertiesPtr->Set(sfProp::Rotation, sfPropertyUtil::FromQuat(rotation));
+        AsfAvatarActor* actorPtr = m_sfObjToActor.FindRef(iter.Key());
+        if (!IsActorValid(actorPtr))
+        {
+            continue;
+        }
+        AvatarMotion& motion = iter.Value();
+        TArray<TransformSnapshot>& snapshots = motion.Snapshots;
+        if (motion.Dirty)
+        {
+            motion.Dirty = false;
+            TransformSnapshot idleSnapshot = snapshots.Last();
+            if (now - idleSnapshot.Time > sendInterval * 2.0)
+            {
+                // The avatar was idle. Hold the old transform until one send interval ago so it starts moving
+                // smoothly instead of jumping.
+                idleSnapshot.Time = now - sendInterval;
+                snapshots.Add(idleSnapshot);
+            }
+            snapshots.Add({ now, motion.TargetLocation, motion.TargetRotation });
+            if (snapshots.Num() > MAX_TRANSFORM_SNAPSHOTS)
+            {
+                snapshots.RemoveAt(0, snapshots.Num() - MAX_TRANSFORM_SNAPSHOTS);
+            }
+            if (m_followingCameraPtr == actorPtr)
+            {
+                StartFollowing();
+            }
+        }
+
+        // Remove snapshots we no longer need, keeping two so we can extrapolate.
+        while (snapshots.Num() > 2 && snapshots[1].Time <= renderTime)
+        {
+            snapshots.RemoveAt(0);
+        }
+
+        FVector location;
+        FQuat rotation;
+        const TransformSnapshot& last = snapshots.Last();
+        if (snapshots.Num() == 1 || renderTime <= snapshots[0].Time)
+        {
+            location = snapshots[0].Location;
+            rotation = snapshots[0].Rotation;
+        }
+        else if (renderTime <= last.Time)
+        {
+            // Interpolate between the two snapshots around the render time.
+            const TransformSnapshot& from = snapshots[0];
+            const TransformSnapshot& to = snapshots[1];
+            float alpha = (float)((renderTime - from.Time) / (to.Time - from.Time));
+            location = FMath::Lerp(from.Location, to.Location, alpha);
+            rotation = FQuat::Slerp(from.Rotation, to.Rotation, alpha);
+        }
+        else
+        {
+            // Updates are late. Extrapolate using the velocity between the last two snapshots, then ease back to
+            // the last received transform if no update arrives.
+            const TransformSnapshot& previous = snapshots[snapshots.Num() - 2];
+            double elapsed = renderTime - last.Time;
+            double extrapolation = elapsed <= MAX_EXTRAPOLATION_TIME ?
+                elapsed : FMath::Max(0.0, MAX_EXTRAPOLATION_TIME * 2.0 - elapsed);
+            float scale = (float)(extrapolation / (last.Time - previous.Time));
+            location = last.Location + (last.Location - previous.Location) * scale;
+            FVector axis;
+            float angle;
+            (last.Rotation * previous.Rotation.Inverse()).ToAxisAndAngle(axis, angle);
+            rotation = FQuat(axis, FMath::UnwindRadians(angle) * scale) * last.Rotation;
+        }
+
+        if (!actorPtr->GetActorLocation().Equals(location) || !actorPtr->GetActorQuat().Equals(rotation))
+        {
+            actorPtr->SetActorLocation(location);
+            actorPtr->SetRotation(rotation);
+            SceneFusion::RedrawActiveViewport();
+        }
     }
 }
 
@@ -763,4 +937,9 @@ void sfAvatarTranslator::RecreateAllAvatars()
 #undef OCULUS_DEVICE_TYPE
 #undef STEAMVR_DEVICE_TYPE
 #undef RIGHT_HAND_INDEX
-#undef INTERPOLATING_FRAME_NUM
\ No newline at end of file
+#undef INTERPOLATING_FRAME_NUM
+#undef LOCATION_PRECISION
+#undef ROTATION_PRECISION
+#undef INTERPOLATION_DELAY_INTERVALS
+#undef MAX_EXTRAPOLATION_TIME
+#undef MAX_TRANSFORM_SNAPSHOTS
\ No newline at end of file
@@ -155,11 +155,41 @@ private:
      */
     typedef std::function<void(sfProperty::SPtr propertyPtr)> PropertyChangeHandler;
 
+    /**
+     * Transform of a remote avatar at the time it was received.
+     */
+    struct TransformSnapshot
+    {
+    public:
+        double Time;
+        FVector Location;
+        FQuat Rotation;
+    };
+
+    /**
+     * Buffered transforms for a remote avatar. The avatar is rendered slightly in the past so it can be interpolated
+     * between received transforms, and is extrapolated for a short time when updates are late.
+     */
+    struct AvatarMotion
+    {
+    public:
+        TArray<TransformSnapshot> Snapshots;
+        FVector TargetLocation;
+        FQuat TargetRotation;
+        bool Dirty;
+    };
+
     KS::ksEvent<sfUser::SPtr&>::SPtr m_userJoinEventPtr;
     KS::ksEvent<sfUser::SPtr&>::SPtr m_userLeaveEventPtr;
     KS::ksEvent<sfUser::SPtr&>::SPtr m_colorChangeEventPtr;
 
     std::unordered_map<sfName, PropertyChangeHandler> m_propertyChangeHandlers;
+    // Keys are avatar sfObject ids.
+    TMap<uint32_t, AvatarMotion> m_avatarMotions;
+    float m_sendTimer;
+    // True when a transform was sent and the final resting pose, which may be below the send thresholds, has not been
+    // sent yet.
+    bool m_settlePending;
 
     int m_leftId;
     int m_rightId;
@@ -265,23 +295,50 @@ private:
     void HideUserAvatar();
 
     /**
-     * Sends camera and controllers info change.
+     * Sends camera and controllers info change. Transforms are sent at most sfConfig::AvatarSendRate times per second.
+     *
+     * @param   float deltaTime in seconds since last tick.
      */
-    void SendChange();
+    void SendChange(float deltaTime);
 
     /**
      * Sends XR controllers' transform to server.
+     *
+     * @param   bool force - if true, send any change larger than the quantization precision, ignoring the thresholds.
+     * @return  bool true if a transform was sent or the controllers were created.
      */
-    void SendControllerTransformToServer();
+    bool SendControllerTransformToServer(bool force = false);
 
     /**
-     * Sets location and rotation properties on the given dictionary property.
+     * Sets location and rotation properties on the given dictionary property if they moved more than the configured
+     * position and angle thresholds. Values are quantized before they are sent so small jitter does not produce new
+     * values.
      *
      * @param   sfDictionaryProperty::SPtr propertiesPtr
      * @param   const FVector& location
      * @param   const FQuat& rotation
+     * @param   bool force - if true, send any change larger than the quantization precision, ignoring the thresholds.
+     * @return  bool true if the location or rotation was sent.
+     */
+    bool SendTransform(
+        sfDictionaryProperty::SPtr propertiesPtr,
+        const FVector& location,
+        const FQuat& rotation,
+        bool force = false);
+
+    /**
+     * Adds a received transform to an avatar's motion buffer.
+     *
+     * @param   sfObject::SPtr objPtr for the avatar.
+     * @param   const FVector* locationPtr - new location, or nullptr if the location did not change.
+     * @param   const FQuat* rotationPtr - new rotation, or nullptr if the rotation did not change.
+     */
+    void OnReceiveTransform(sfObject::SPtr objPtr, const FVector* locationPtr, const FQuat* rotationPtr);
+
+    /**
+     * Records the transforms received this frame and moves avatars along their interpolated paths.
      */
-    void SendTransform(sfDictionaryProperty::SPtr propertiesPtr, const FVector& location, const FQuat& rotation);
+    void UpdateAvatarMotion();
 
     /**
      * Toggles flashlight on controllerActorPtr.
@@ -2,7 +2,15 @@
 #include "../../Public/sfConfig.h"
 #include "../../Public/Consts.h"
 #include "../../Public/SceneFusion.h"
+#include "../../Public/Translators/sfModelTranslator.h"
 
+#define LOG_CHANNEL "sfConfigTranslator"
+
+// Model format versions. Sessions started by clients that predate this setting don't have it and use the legacy
+// format, where each model is a single byte array. Increment this when the model format changes.
+#define MODEL_FORMAT_LEGACY 0
+#define MODEL_FORMAT_CHUNKED 1
+#define MODEL_FORMAT_VERSION MODEL_FORMAT_CHUNKED
 
 void sfConfigTranslator::Initialize()
 {
@@ -12,7 +20,9 @@ void sfConfigTranslator::Initialize()
         sfObject::SPtr objPtr = sfObject::Create(sfType::Config, propsPtr);
         propsPtr->Set(sfProp::SyncBlueprint, sfValueProperty::Create(sfConfig::Get().SyncBlueprint));
         propsPtr->Set(sfProp::SyncLandscape, sfValueProperty::Create(sfConfig::Get().SyncLandscape));
+        propsPtr->Set(sfProp::ModelFormat, sfValueProperty::Create(MODEL_FORMAT_VERSION));
         SceneFusion::Service->Session()->Create(objPtr);
+        SetModelFormat(MODEL_FORMAT_VERSION);
     }
 }
 
@@ -21,6 +31,18 @@ void sfConfigTranslator::OnCreate(sfObject::SPtr objPtr, int childIndex)
     bool changed = false;
     sfDictionaryProperty::SPtr propsPtr = objPtr->Property()->AsDict();
 
+    sfProperty::SPtr propPtr;
+    int modelFormat = propsPtr->TryGet(sfProp::ModelFormat, propPtr) ?
+        (int)propPtr->AsValue()->GetValue() : MODEL_FORMAT_LEGACY;
+    if (modelFormat > MODEL_FORMAT_VERSION)
+    {
+        KS::Log::Error("Disconnecting because this session was started by a newer version of Scene Fusion that syncs "
+            "models in a format this version cannot read. Update Scene Fusion to join this session.", LOG_CHANNEL);
+        SceneFusion::Service->LeaveSession();
+        return;
+    }
+    SetModelFormat(modelFormat);
+
     bool syncBlueprint = propsPtr->Get(sfProp::SyncBlueprint)->AsValue()->GetValue();
     if (syncBlueprint != sfConfig::Get().SyncBlueprint)
     {
@@ -39,4 +61,14 @@ void sfConfigTranslator::OnCreate(sfObject::SPtr objPtr, int childIndex)
     {
         sfConfig::Get().Save();
     }
+}
+
+void sfConfigTranslator::SetModelFormat(int modelFormat)
+{
+    TSharedPtr<sfModelTranslator> modelTranslatorPtr = SceneFusion::Get().GetTranslator<sfModelTranslator>(
+        sfType::Model);
+    if (modelTranslatorPtr.IsValid())
+    {
+        modelTranslatorPtr->SetUseChunks(modelFormat >= MODEL_FORMAT_CHUNKED);
+    }
 }
\ No newline at end of file
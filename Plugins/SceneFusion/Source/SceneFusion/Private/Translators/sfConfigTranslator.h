@@ -40,4 +40,13 @@ protected:
      * @param   int childIndex of new object. -1 if object is a root.
      */
     virtual void OnCreate(sfObject::SPtr objPtr, int childIndex) override;
+
+private:
+    /**
+     * Sets the format the model translator syncs models in. Every client in a session writes models in the format of
+     * the session creator, so clients of different versions can read each other's models.
+     *
+     * @param   int modelFormat version to write models in.
+     */
+    void SetModelFormat(int modelFormat);
 };
\ No newline at end of file
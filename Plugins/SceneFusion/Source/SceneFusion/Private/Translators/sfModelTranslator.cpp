@@ -12,20 +12,25 @@
 #include "../../Public/sfActorUtil.h"
 #include "../UI/sfDetailsPanelManager.h"
 #include <sfValueProperty.h>
+#include <sfListProperty.h>
 #include <Engine/Brush.h>
 #include <Engine/BrushBuilder.h>
 #include <GameFramework/Volume.h>
 #include <Editor.h>
 #include <EdMode.h>
 #include <Components/BrushComponent.h>
+#include <Misc/Crc.h>
 
 // In seconds
 #define BSP_REBUILD_DELAY .2f;
 #define SYNC_DELAY 0.1f;
+// Size in bytes of the chunks model sections are split into
+#define MODEL_CHUNK_SIZE 16384
 
 using namespace KS;
 
-sfModelTranslator::sfModelTranslator()
+sfModelTranslator::sfModelTranslator() :
+    m_useChunks{ false }
 {
     sfPropertyManager::Get().AddPropertyToForceSyncList("Brush", "BrushBuilder");
     sfPropertyManager::Get().AddPropertyToForceSyncList("Brush", "PolyFlags");
@@ -108,10 +113,17 @@ void sfModelTranslator::Initialize()
     });
 }
 
+void sfModelTranslator::SetUseChunks(bool useChunks)
+{
+    m_useChunks = useChunks;
+}
+
 void sfModelTranslator::CleanUp()
 {
+    m_useChunks = false;
     m_staleModels.clear();
     m_rebuiltModels.clear();
+    m_receivedModels.clear();
     SceneFusion::Get().OnTick.Remove(m_tickHandle);
     ULevel::LevelDirtiedEvent.Remove(m_onLevelDirtiedHandle);
     m_actorTranslatorPtr->OnLockStateChange.Remove(m_onLockHandle);
@@ -126,6 +138,7 @@ void sfModelTranslator::CleanUp()
 void sfModelTranslator::Tick(float deltaTime)
 {
     RebuildBSPIfNeeded(deltaTime);
+    ApplyReceivedModels();
     if (!m_modelSyncEnabled)
     {
         if (GLevelEditorModeTools().GetActiveMode("EM_Geometry") != nullptr)
@@ -192,35 +205,223 @@ void sfModelTranslator::Sync(sfObject::SPtr objPtr, UModel* modelPtr)
 {
     if (objPtr->IsLocked())
     {
-        ApplyServerData(modelPtr, objPtr->Property());
+        ApplyServerData(modelPtr, objPtr);
+    }
+    else if (!m_useChunks)
+    {
+        WriteLegacy(objPtr, modelPtr);
     }
     else
+    {
+        if (objPtr->Property() == nullptr || objPtr->Property()->Type() != sfProperty::DICTIONARY)
+        {
+            objPtr->SetProperty(sfDictionaryProperty::Create());
+        }
+        WriteChunks(objPtr->Property()->AsDict(), modelPtr);
+    }
+}
+
+bool sfModelTranslator::WriteChunks(sfDictionaryProperty::SPtr dictPtr, UModel* modelPtr)
+{
+    std::vector<std::vector<uint32_t>> oldHashes;
+    if (!ReadManifest(dictPtr, oldHashes))
+    {
+        oldHashes.clear();
+    }
+    sfProperty::SPtr propPtr;
+    sfListProperty::SPtr sectionsPtr;
+    if (dictPtr->TryGet(sfProp::Chunks, propPtr) && propPtr->Type() == sfProperty::LIST)
+    {
+        sectionsPtr = propPtr->AsList();
+    }
+    else
+    {
+        sectionsPtr = sfListProperty::Create();
+        dictPtr->Set(sfProp::Chunks, sectionsPtr);
+    }
+    while (sectionsPtr->Size() < ModelSection::NumSections)
+    {
+        sectionsPtr->Add(sfListProperty::Create());
+    }
+
+    // The manifest stores the number of sections, followed by the chunk count and chunk hashes for each section.
+    std::vector<uint32_t> manifest;
+    manifest.push_back(ModelSection::NumSections);
+    bool changed = oldHashes.size() != ModelSection::NumSections;
+    for (int section = 0; section < ModelSection::NumSections; section++)
     {
         sfBufferArchive writer;
-        Serialize(writer, modelPtr);
-        sfValueProperty::SPtr propPtr = sfValueProperty::Create(
-            ksMultiType{ ksMultiType::BYTE_ARRAY, writer.GetData(), (size_t)writer.Num(), writer.Num() });
-        if (!propPtr->Equals(objPtr->Property()))
+        Serialize(writer, modelPtr, (ModelSection)section);
+        int numChunks = (writer.Num() + MODEL_CHUNK_SIZE - 1) / MODEL_CHUNK_SIZE;
+        manifest.push_back(numChunks);
+
+        sfListProperty::SPtr chunksPtr = sectionsPtr->Get(section)->AsList();
+        for (int i = 0; i < numChunks; i++)
         {
-            objPtr->SetProperty(propPtr);
-            for (uint32_t pathId : writer.MissingPathIds())
+            int offset = i * MODEL_CHUNK_SIZE;
+            int size = FMath::Min(MODEL_CHUNK_SIZE, writer.Num() - offset);
+            uint32_t hash = FCrc::MemCrc32(writer.GetData() + offset, size);
+            manifest.push_back(hash);
+            if (i < chunksPtr->Size() && section < (int)oldHashes.size() && i < (int)oldHashes[section].size() &&
+                oldHashes[section][i] == hash)
+            {
+                continue;
+            }
+            sfValueProperty::SPtr chunkPtr = sfValueProperty::Create(
+                ksMultiType{ ksMultiType::BYTE_ARRAY, writer.GetData() + offset, (size_t)size, size });
+            if (i < chunksPtr->Size())
             {
-                sfLoader::Get().AddStandInReference(pathId, propPtr);
+                chunksPtr->Set(i, chunkPtr);
             }
+            else
+            {
+                chunksPtr->Add(chunkPtr);
+            }
+            changed = true;
+        }
+        if (chunksPtr->Size() > numChunks)
+        {
+            chunksPtr->RemoveRange(numChunks, chunksPtr->Size() - numChunks);
+            changed = true;
+        }
+        // References to missing assets may span chunks, so register stand-in references on the section list.
+        for (uint32_t pathId : writer.MissingPathIds())
+        {
+            sfLoader::Get().AddStandInReference(pathId, chunksPtr);
+        }
+    }
+    if (changed)
+    {
+        dictPtr->Set(sfProp::Manifest, sfValueProperty::Create(ksMultiType(manifest)));
+    }
+    return changed;
+}
+
+bool sfModelTranslator::ReadManifest(
+    sfDictionaryProperty::SPtr dictPtr,
+    std::vector<std::vector<uint32_t>>& outHashes)
+{
+    sfProperty::SPtr propPtr;
+    if (!dictPtr->TryGet(sfProp::Manifest, propPtr) || propPtr->Type() != sfProperty::VALUE)
+    {
+        return false;
+    }
+    std::vector<uint32_t> manifest;
+    propPtr->AsValue()->GetValue().GetUIntArray(manifest);
+    if (manifest.size() == 0 || manifest[0] >= manifest.size())
+    {
+        return false;
+    }
+    outHashes.resize(manifest[0]);
+    size_t index = 1;
+    for (std::vector<uint32_t>& hashes : outHashes)
+    {
+        if (index >= manifest.size() || index + 1 + manifest[index] > manifest.size())
+        {
+            return false;
+        }
+        hashes.assign(manifest.begin() + index + 1, manifest.begin() + index + 1 + manifest[index]);
+        index += manifest[index] + 1;
+    }
+    return true;
+}
+
+void sfModelTranslator::WriteLegacy(sfObject::SPtr objPtr, UModel* modelPtr)
+{
+    sfBufferArchive writer;
+    SerializeLegacy(writer, modelPtr);
+    sfValueProperty::SPtr propPtr = sfValueProperty::Create(
+        ksMultiType{ ksMultiType::BYTE_ARRAY, writer.GetData(), (size_t)writer.Num(), writer.Num() });
+    if (!propPtr->Equals(objPtr->Property()))
+    {
+        objPtr->SetProperty(propPtr);
+        for (uint32_t pathId : writer.MissingPathIds())
+        {
+            sfLoader::Get().AddStandInReference(pathId, propPtr);
         }
     }
 }
 
-void sfModelTranslator::ApplyServerData(UModel* modelPtr, sfProperty::SPtr propPtr)
+bool sfModelTranslator::ApplyServerData(UModel* modelPtr, sfObject::SPtr objPtr)
+{
+    sfProperty::SPtr propPtr = objPtr->Property();
+    if (propPtr == nullptr)
+    {
+        return false;
+    }
+    if (propPtr->Type() == sfProperty::VALUE)
+    {
+        // Model synced by a client that doesn't support chunks
+        ApplyLegacyServerData(modelPtr, propPtr);
+        return true;
+    }
+    if (propPtr->Type() != sfProperty::DICTIONARY)
+    {
+        return false;
+    }
+    sfDictionaryProperty::SPtr dictPtr = propPtr->AsDict();
+    std::vector<std::vector<uint32_t>> hashes;
+    if (!ReadManifest(dictPtr, hashes) || hashes.size() != ModelSection::NumSections ||
+        !dictPtr->TryGet(sfProp::Chunks, propPtr) || propPtr->Type() != sfProperty::LIST)
+    {
+        return false;
+    }
+    sfListProperty::SPtr sectionsPtr = propPtr->AsList();
+    if (sectionsPtr->Size() < ModelSection::NumSections)
+    {
+        return false;
+    }
+
+    // Reassemble the sections. Chunks may arrive in any order, so we only deserialize once every chunk matches the
+    // hash in the manifest.
+    TArray<TArray<uint8>> sections;
+    sections.SetNum(ModelSection::NumSections);
+    for (int section = 0; section < ModelSection::NumSections; section++)
+    {
+        sfListProperty::SPtr chunksPtr = sectionsPtr->Get(section)->AsList();
+        if (chunksPtr->Size() != (int)hashes[section].size())
+        {
+            return false;
+        }
+        for (int i = 0; i < chunksPtr->Size(); i++)
+        {
+            const std::vector<uint8_t>& data = chunksPtr->Get(i)->AsValue()->GetValue().GetData();
+            if (FCrc::MemCrc32(data.data(), data.size()) != hashes[section][i])
+            {
+                return false;
+            }
+            sections[section].Append(data.data(), (int)data.size());
+        }
+    }
+
+    for (int section = 0; section < ModelSection::NumSections; section++)
+    {
+        sfBufferReader reader{ (void*)sections[section].GetData(), sections[section].Num() };
+        Serialize(reader, modelPtr, (ModelSection)section);
+        for (uint32_t pathId : reader.MissingPathIds())
+        {
+            sfLoader::Get().AddStandInReference(pathId, sectionsPtr->Get(section));
+        }
+    }
+
+    OnModelDataApplied(modelPtr);
+    return true;
+}
+
+void sfModelTranslator::ApplyLegacyServerData(UModel* modelPtr, sfProperty::SPtr propPtr)
 {
     const ksMultiType& multiType = propPtr->AsValue()->GetValue();
     sfBufferReader reader{ (void*)multiType.GetData().data(), (int)multiType.GetData().size() };
-    Serialize(reader, modelPtr);
+    SerializeLegacy(reader, modelPtr);
     for (uint32_t pathId : reader.MissingPathIds())
     {
         sfLoader::Get().AddStandInReference(pathId, propPtr);
     }
+    OnModelDataApplied(modelPtr);
+}
 
+void sfModelTranslator::OnModelDataApplied(UModel* modelPtr)
+{
     AVolume* volumePtr = Cast<AVolume>(modelPtr->GetOuter());
     if (volumePtr != nullptr && volumePtr->GetBrushComponent() != nullptr)
     {
@@ -235,6 +436,20 @@ void sfModelTranslator::ApplyServerData(UModel* modelPtr, sfProperty::SPtr propP
     }
 }
 
+void sfModelTranslator::ApplyReceivedModels()
+{
+    // Models that are missing chunks are dropped from the set and checked again when their next chunk arrives.
+    for (sfObject::SPtr objPtr : m_receivedModels)
+    {
+        UModel* modelPtr = sfObjectMap::Get<UModel>(objPtr);
+        if (modelPtr != nullptr && ApplyServerData(modelPtr, objPtr))
+        {
+            m_rebuiltModels.emplace(objPtr);
+        }
+    }
+    m_receivedModels.clear();
+}
+
 bool sfModelTranslator::Create(UObject* uobjPtr, sfObject::SPtr& outObjPtr)
 {
     if (!uobjPtr->IsA<UModel>())
@@ -252,15 +467,14 @@ bool sfModelTranslator::Create(UObject* uobjPtr, sfObject::SPtr& outObjPtr)
 sfObject::SPtr sfModelTranslator::CreateObject(UModel* modelPtr)
 {
     sfObject::SPtr objPtr = sfObjectMap::GetOrCreateSFObject(modelPtr, sfType::Model);
-    sfBufferArchive writer;
-    Serialize(writer, modelPtr);
-    sfValueProperty::SPtr propPtr = sfValueProperty::Create(
-        ksMultiType{ ksMultiType::BYTE_ARRAY, writer.GetData(), (size_t)writer.Num(), writer.Num() });
-    objPtr->SetProperty(propPtr);
-    for (uint32_t pathId : writer.MissingPathIds())
+    if (!m_useChunks)
     {
-        sfLoader::Get().AddStandInReference(pathId, propPtr);
+        WriteLegacy(objPtr, modelPtr);
+        return objPtr;
     }
+    sfDictionaryProperty::SPtr dictPtr = sfDictionaryProperty::Create();
+    WriteChunks(dictPtr, modelPtr);
+    objPtr->SetProperty(dictPtr);
     return objPtr;
 }
 
@@ -272,8 +486,10 @@ void sfModelTranslator::OnCreate(sfObject::SPtr objPtr, int childIndex)
         return;
     }
     sfObjectMap::Add(objPtr, brushPtr->Brush);
-    ApplyServerData(brushPtr->Brush, objPtr->Property());
-    m_rebuiltModels.emplace(objPtr);
+    if (ApplyServerData(brushPtr->Brush, objPtr))
+    {
+        m_rebuiltModels.emplace(objPtr);
+    }
 
     // Set references to this model
     std::vector<sfReferenceProperty::SPtr> references = SceneFusion::Service->Session()->GetReferences(objPtr);
@@ -282,12 +498,19 @@ void sfModelTranslator::OnCreate(sfObject::SPtr objPtr, int childIndex)
 
 void sfModelTranslator::OnPropertyChange(sfProperty::SPtr propPtr)
 {
-    UModel* modelPtr = sfObjectMap::Get<UModel>(propPtr->GetContainerObject());
-    if (modelPtr != nullptr)
-    {
-        ApplyServerData(modelPtr, propPtr);
-        m_rebuiltModels.emplace(propPtr->GetContainerObject());
-    }
+    // Chunks and the manifest can arrive over several updates, so wait until the next tick to check if the model is
+    // complete.
+    m_receivedModels.emplace(propPtr->GetContainerObject());
+}
+
+void sfModelTranslator::OnListAdd(sfListProperty::SPtr listPtr, int index, int count)
+{
+    m_receivedModels.emplace(listPtr->GetContainerObject());
+}
+
+void sfModelTranslator::OnListRemove(sfListProperty::SPtr listPtr, int index, int count)
+{
+    m_receivedModels.emplace(listPtr->GetContainerObject());
 }
 
 void sfModelTranslator::OnUObjectModified(sfObject::SPtr objPtr, UObject* uobjPtr)
@@ -406,38 +629,98 @@ void sfModelTranslator::MarkBSPStale(ULevel* levelPtr)
     m_bspRebuildDelay = BSP_REBUILD_DELAY;
 }
 
-void sfModelTranslator::Serialize(FArchive& archive, UModel* modelPtr)
+void sfModelTranslator::Serialize(FArchive& archive, UModel* modelPtr, ModelSection section)
 {
+    switch (section)
+    {
+        case ModelSection::Header:
+        {
+            archive << modelPtr->Bounds;
+            archive << modelPtr->NumSharedSides;
+            archive << modelPtr->RootOutside;
+            archive << modelPtr->Linked;
+            archive << modelPtr->NumUniqueVertices;
+            break;
+        }
+        case ModelSection::Surfs:
+        {
+            archive << modelPtr->Surfs;
+            break;
+        }
+        case ModelSection::Polys:
+        {
+            archive << modelPtr->Polys->Element;
+            break;
+        }
+        case ModelSection::Vertices:
+        {
+            int num = modelPtr->VertexBuffer.Vertices.Num();
+            archive << num;
+            modelPtr->VertexBuffer.Vertices.SetNum(num);
+            for (FModelVertex& vertex : modelPtr->VertexBuffer.Vertices)
+            {
+                Serialize(archive, vertex);
+            }
+            break;
+        }
+        case ModelSection::LightmassSettings:
+        {
+            int num = modelPtr->LightmassSettings.Num();
+            archive << num;
+            modelPtr->LightmassSettings.SetNum(num);
+            for (FLightmassPrimitiveSettings& lightmassSettings : modelPtr->LightmassSettings)
+            {
+                Serialize(archive, lightmassSettings);
+            }
+            break;
+        }
+        case ModelSection::Vectors:
+        {
+            modelPtr->Vectors.BulkSerialize(archive);
+            break;
+        }
+        case ModelSection::Points:
+        {
+            modelPtr->Points.BulkSerialize(archive);
+            break;
+        }
+        case ModelSection::Nodes:
+        {
+            modelPtr->Nodes.BulkSerialize(archive);
+            break;
+        }
+        case ModelSection::Verts:
+        {
+            modelPtr->Verts.BulkSerialize(archive);
+            break;
+        }
+        case ModelSection::LeafHulls:
+        {
+            modelPtr->LeafHulls.BulkSerialize(archive);
+            break;
+        }
+        case ModelSection::Leaves:
+        {
+            modelPtr->Leaves.BulkSerialize(archive);
+            break;
+        }
+    }
+}
+
+void sfModelTranslator::SerializeLegacy(FArchive& archive, UModel* modelPtr)
+{
+    // The legacy format interleaves the header fields with the surfs and polys.
     archive << modelPtr->Bounds;
-    archive << modelPtr->Surfs;
+    Serialize(archive, modelPtr, ModelSection::Surfs);
     archive << modelPtr->NumSharedSides;
-    archive << modelPtr->Polys->Element;
+    Serialize(archive, modelPtr, ModelSection::Polys);
     archive << modelPtr->RootOutside;
     archive << modelPtr->Linked;
     archive << modelPtr->NumUniqueVertices;
-
-    int num = modelPtr->VertexBuffer.Vertices.Num();
-    archive << num;
-    modelPtr->VertexBuffer.Vertices.SetNum(num);
-    for (FModelVertex& vertex : modelPtr->VertexBuffer.Vertices)
+    for (int section = ModelSection::Vertices; section < ModelSection::NumSections; section++)
     {
-        Serialize(archive, vertex);
+        Serialize(archive, modelPtr, (ModelSection)section);
     }
-
-    num = modelPtr->LightmassSettings.Num();
-    archive << num;
-    modelPtr->LightmassSettings.SetNum(num);
-    for (FLightmassPrimitiveSettings& lightmassSettings : modelPtr->LightmassSettings)
-    {
-        Serialize(archive, lightmassSettings);
-    }
-
-    modelPtr->Vectors.BulkSerialize(archive);
-    modelPtr->Points.BulkSerialize(archive);
-    modelPtr->Nodes.BulkSerialize(archive);
-    modelPtr->Verts.BulkSerialize(archive);
-    modelPtr->LeafHulls.BulkSerialize(archive);
-    modelPtr->Leaves.BulkSerialize(archive);
 }
 
 void sfModelTranslator::Serialize(FArchive& archive, FModelVertex& vertex)
@@ -485,5 +768,6 @@ void sfModelTranslator::Serialize(FArchive& archive, FLightmassPrimitiveSettings
     archive << lightmassSettings.DiffuseBoost;
 }
 
+#undef MODEL_CHUNK_SIZE
 #undef SYNC_DELAY
 #undef BSP_REBUILD_DELAY
\ No newline at end of file
@@ -26,9 +26,12 @@
 
 using namespace KS::SceneFusion2;
 
+class UStaticMeshComponent;
+
 /**
  * Lock component for indicating an actor cannot be edited. This is added to each mesh component of the actor, and
- * adds a copy of the mesh as a child with a lock shader. It also deletes itself and unlocks the actor when copied.
+ * adds a mesh component that renders the parent's mesh with a lock shader as a child. It also deletes itself and
+ * unlocks the actor when copied.
  */
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class UsfLockComponent : public USceneComponent
@@ -71,7 +74,8 @@ public:
     virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
 
     /**
-     * Duplicates the parent mesh component and adds the duplicate as a child.
+     * Adds a child mesh component that renders the parent's mesh with the lock material. Static mesh parents get a
+     * lightweight static mesh component that shares the parent's mesh asset. Other mesh components are duplicated.
      *
      * @param   UMaterialInterface* materialPtr to use on the duplicate mesh. If nullptr, will use the current
      *          material.
@@ -80,6 +84,7 @@ public:
 
     /**
      * If attached to a brush, creates or finds the mesh for the brush's model and adds it as a child mesh component.
+     * If the mesh has not been generated yet, the component is queued and the mesh is generated over the next frames.
      *
      * @param   UMaterialInterface* materialPtr to use on the mesh. If nullptr, will use the current material.
      */
@@ -87,7 +92,9 @@ public:
 
     /**
      * Sets the landscape lock material on all landscape components attached to the landscape this component is
-     * attached to.
+     * attached to. Landscape mode can replace the material, so while landscape mode is active the components are
+     * checked over multiple frames, and all components are checked when the landscape tool changes or landscape mode
+     * exits.
      *
      * @param   UMaterialInterface* materialPtr
      */
@@ -154,10 +161,38 @@ private:
     bool m_copied;
     bool m_initialized;
     FDelegateHandle m_tickerHandle;
+    FDelegateHandle m_landscapeTickerHandle;
+    FDelegateHandle m_editorModeChangedHandle;
     UMaterialInterface* m_materialPtr;
+    int m_landscapeCheckIndex;
+    void* m_landscapeToolPtr;
 
     // Maps brushes to lock meshes generated from their models
     static TMap<ABrush*, MeshData> m_modelMeshes;
+    // Lock components waiting for meshes to be generated from their brush models
+    static TArray<TWeakObjectPtr<UsfLockComponent>> m_pendingModelMeshes;
+    static FDelegateHandle m_modelMeshTickerHandle;
+
+    /**
+     * Generates queued brush model meshes until the frame budget is used up.
+     *
+     * @return  bool true if there are still meshes to generate.
+     */
+    static bool BuildPendingModelMeshes();
+
+    /**
+     * Creates or finds the mesh for the brush's model and adds it as a child mesh component.
+     */
+    void AttachModelMesh();
+
+    /**
+     * Creates a static mesh component that renders the parent static mesh without collision, shadows, or navigation.
+     *
+     * @param   UStaticMeshComponent* parentPtr to render.
+     * @param   FName name of the component.
+     * @return  UStaticMeshComponent* lock mesh component.
+     */
+    UStaticMeshComponent* CreateStaticMeshOverlay(UStaticMeshComponent* parentPtr, FName name);
     
     /**
      * Initializes a mesh component and attaches it to this component.
@@ -187,10 +222,33 @@ private:
     UStaticMesh* CreateMeshFromBrush(UObject* outerPtr, FName name, ABrush* brushPtr);
 
     /**
-     * Updates the material on all landscape components that have a different material from the lock material.
+     * Updates the material on landscape components that have a different material from the lock material.
      *
-     * @return  bool true. This function is registered as a ticker and it returns true to keep it registered. Returns
-     *      false if not attached to a landscape.
+     * @param   int startIndex of the first landscape component to check.
+     * @param   int count - number of landscape components to check. If negative, checks all components from the start
+     *          index.
+     * @return  int index of the landscape component after the last one checked, or 0 if all components to the end
+     *          were checked.
+     */
+    int UpdateLandscapeMaterials(int startIndex = 0, int count = -1);
+
+    /**
+     * Called when landscape mode is entered or exited. Starts checking landscape materials every frame when entering,
+     * and stops and checks all landscape materials when exiting.
+     *
+     * @param   bool isEntering - true if landscape mode was entered.
+     */
+    void OnLandscapeModeChanged(bool isEntering);
+
+    /**
+     * Checks a chunk of landscape component materials, or all of them if the landscape tool changed.
+     *
+     * @return  bool true to keep ticking while landscape mode is active.
+     */
+    bool TickLandscapeMaterials();
+
+    /**
+     * Stops listening for landscape mode events and stops checking landscape materials.
      */
-    bool UpdateLandscapeMaterials();
+    void StopLandscapeMaterialUpdates();
 };
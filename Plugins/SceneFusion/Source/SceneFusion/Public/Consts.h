@@ -63,12 +63,15 @@ public:
     static const sfName EditorLayerSettings;
     static const sfName SyncBlueprint;
     static const sfName SyncLandscape;
+    static const sfName ModelFormat;
     static const sfName Type;
     static const sfName Instances;
     static const sfName Component;
     static const sfName Checksum;
     static const sfName LockLocation;
     static const sfName Layers;
+    static const sfName Manifest;
+    static const sfName Chunks;
 };
 
 /**
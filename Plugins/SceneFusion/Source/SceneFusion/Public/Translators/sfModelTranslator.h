@@ -43,6 +43,15 @@ public:
      */
     void MarkBSPStale(ULevel* levelPtr);
 
+    /**
+     * Sets whether models are synced in chunks. Clients that predate chunked syncing can only read models synced as a
+     * single byte array, so this is only enabled in sessions started by a client that supports chunks. Models in
+     * either format can always be read.
+     *
+     * @param   bool useChunks
+     */
+    void SetUseChunks(bool useChunks);
+
 protected:
     /**
      * Initialization. Called after connecting to a session.
@@ -78,6 +87,24 @@ protected:
      */
     virtual void OnPropertyChange(sfProperty::SPtr propPtr) override;
 
+    /**
+     * Called when one or more elements are added to a list property. Called when model chunks are added.
+     *
+     * @param   sfListProperty::SPtr listPtr the elements were added to.
+     * @param   int index elements were inserted at.
+     * @param   int count - number of elements added.
+     */
+    virtual void OnListAdd(sfListProperty::SPtr listPtr, int index, int count) override;
+
+    /**
+     * Called when one or more elements are removed from a list property. Called when model chunks are removed.
+     *
+     * @param   sfListProperty::SPtr listPtr the elements were removed from.
+     * @param   int index elements were removed from.
+     * @param   int count - number of elements removed.
+     */
+    virtual void OnListRemove(sfListProperty::SPtr listPtr, int index, int count) override;
+
     /**
      * Called when an object is modified. Checks for model changes.
      *
@@ -86,13 +113,35 @@ protected:
     virtual void OnUObjectModified(sfObject::SPtr objPtr, UObject* uobjptr) override;
 
 private:
+    /**
+     * Model data is serialized in sections. Each section is split into fixed-size chunks that are synced
+     * independently so only the chunks that changed are sent.
+     */
+    enum ModelSection
+    {
+        Header,
+        Surfs,
+        Polys,
+        Vertices,
+        LightmassSettings,
+        Vectors,
+        Points,
+        Nodes,
+        Verts,
+        LeafHulls,
+        Leaves,
+        NumSections
+    };
+
     TSharedPtr<sfActorTranslator> m_actorTranslatorPtr;
     std::unordered_set<sfObject::SPtr> m_staleModels;
     std::unordered_set<sfObject::SPtr> m_rebuiltModels;
+    std::unordered_set<sfObject::SPtr> m_receivedModels;
     float m_checkChangeTimer;
     float m_bspRebuildDelay;
     bool m_modelSyncEnabled;
     bool m_showedDisabledMessage;
+    bool m_useChunks;
     FDelegateHandle m_onDeselectHandle;
     FDelegateHandle m_onLevelDirtiedHandle;
     FDelegateHandle m_onLockHandle;
@@ -122,11 +171,61 @@ private:
     void Sync(sfObject::SPtr objPtr, UModel* modelPtr);
 
     /**
-     * Applies server data to a model.
+     * Applies server data to a model. Does nothing if not all chunks for the model's current manifest have arrived.
+     *
+     * @param   UModel* modelPtr to apply data to.
+     * @param   sfObject::SPtr objPtr for the model.
+     * @return  bool true if the data was applied.
+     */
+    bool ApplyServerData(UModel* modelPtr, sfObject::SPtr objPtr);
+
+    /**
+     * Applies server data in the legacy single byte array format to a model.
+     *
      * @param   UModel* modelPtr to apply data to.
-     * @param   sfProperty::SPtr propPtr to get data from.
+     * @param   sfProperty::SPtr propPtr containing the model data.
      */
-    void ApplyServerData(UModel* modelPtr, sfProperty::SPtr propPtr);
+    void ApplyLegacyServerData(UModel* modelPtr, sfProperty::SPtr propPtr);
+
+    /**
+     * Serializes a model into a single byte array property in the legacy format and sets it on the object if it
+     * changed.
+     *
+     * @param   sfObject::SPtr objPtr to set the property on.
+     * @param   UModel* modelPtr to serialize.
+     */
+    void WriteLegacy(sfObject::SPtr objPtr, UModel* modelPtr);
+
+    /**
+     * Refreshes volume geometry and marks BSP stale after server data is applied to a model.
+     *
+     * @param   UModel* modelPtr that data was applied to.
+     */
+    void OnModelDataApplied(UModel* modelPtr);
+
+    /**
+     * Applies server data to models that received chunk changes since the last tick.
+     */
+    void ApplyReceivedModels();
+
+    /**
+     * Serializes a model into chunks and writes the chunks whose hashes differ from the manifest to a dictionary
+     * property, then updates the manifest.
+     *
+     * @param   sfDictionaryProperty::SPtr dictPtr to write chunks to.
+     * @param   UModel* modelPtr to serialize.
+     * @return  bool true if any chunks changed.
+     */
+    bool WriteChunks(sfDictionaryProperty::SPtr dictPtr, UModel* modelPtr);
+
+    /**
+     * Reads the chunk hashes for each model section from a model property's manifest.
+     *
+     * @param   sfDictionaryProperty::SPtr dictPtr to read manifest from.
+     * @param   std::vector<std::vector<uint32_t>>& outHashes - chunk hashes for each section.
+     * @return  bool false if the manifest is missing or invalid.
+     */
+    bool ReadManifest(sfDictionaryProperty::SPtr dictPtr, std::vector<std::vector<uint32_t>>& outHashes);
 
     /**
      * Called when an actor is deselected. If the actor is a brush and its model is stale, syncs the model.
@@ -158,12 +257,21 @@ private:
     void RebuildBSPIfNeeded(float deltaTime);
 
     /**
-     * Serializes or deserializes a model.
+     * Serializes or deserializes a section of a model.
      * 
      * @param   FArchive& archive to serialize to or deserialize from.
      * @param   UModel* modelPtr to serialize or deserialize.
+     * @param   ModelSection section to serialize or deserialize.
+     */
+    void Serialize(FArchive& archive, UModel* modelPtr, ModelSection section);
+
+    /**
+     * Serializes or deserializes a model in the legacy single byte array format.
+     *
+     * @param   FArchive& archive to serialize to or deserialize from.
+     * @param   UModel* modelPtr to serialize or deserialize.
      */
-    void Serialize(FArchive& archive, UModel* modelPtr);
+    void SerializeLegacy(FArchive& archive, UModel* modelPtr);
 
     /**
      * Serializes or deserializes a model vertex.
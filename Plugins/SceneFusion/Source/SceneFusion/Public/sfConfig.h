@@ -46,7 +46,10 @@ private:
         IdleTime(0.5),
         MaxCreateTimeMS(40),
         ShowGettingStartedScreen(true),
-        LastSFVersion("")
+        LastSFVersion(""),
+        AvatarSendRate(10.0f),
+        AvatarPositionThreshold(1.0f),
+        AvatarAngleThreshold(0.5f)
     {}
 
 public:
@@ -78,6 +81,12 @@ public:
     int MaxCreateTimeMS;
     bool ShowGettingStartedScreen;
     FString LastSFVersion;
+    // Maximum number of avatar transform updates to send per second.
+    float AvatarSendRate;
+    // Minimum distance the camera must move before its location is sent.
+    float AvatarPositionThreshold;
+    // Minimum angle in degrees the camera must rotate before its rotation is sent.
+    float AvatarAngleThreshold;
 
     /**
      * Relative Path to the Scene Fusion configuration file.
@@ -113,6 +122,9 @@ public:
         configs.Add("MaxCreateTimeMS=" + FString::FromInt(MaxCreateTimeMS));
         configs.Add("ShowGettingStartedScreen=" + FString(ShowGettingStartedScreen ? "true" : "false"));
         configs.Add("LastSFVersion=" + LastSFVersion);
+        configs.Add("AvatarSendRate=" + FString::SanitizeFloat(AvatarSendRate));
+        configs.Add("AvatarPositionThreshold=" + FString::SanitizeFloat(AvatarPositionThreshold));
+        configs.Add("AvatarAngleThreshold=" + FString::SanitizeFloat(AvatarAngleThreshold));
         FFileHelper::SaveStringArrayToFile(configs, *Path());
     }
 
@@ -216,6 +228,21 @@ public:
                         LastSFVersion = value;
                         continue;
                     }
+                    if (key.Equals("AvatarSendRate"))
+                    {
+                        AvatarSendRate = FCString::Atof(*value);
+                        continue;
+                    }
+                    if (key.Equals("AvatarPositionThreshold"))
+                    {
+                        AvatarPositionThreshold = FCString::Atof(*value);
+                        continue;
+                    }
+                    if (key.Equals("AvatarAngleThreshold"))
+                    {
+                        AvatarAngleThreshold = FCString::Atof(*value);
+                        continue;
+                    }
                 }
             }
         }